@@ -0,0 +1,377 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds3231_bench.c
+ * @brief     driver ds3231 bench source file
+ * @version   2.0.0
+ * @author    Shifeng Li
+ * @date      2021-03-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2021/03/15  <td>2.0      <td>Shifeng Li  <td>format the code
+ * <tr><td>2020/11/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds3231_bench.h"
+#include "driver_ds3231_simulator.h"
+#include <time.h>
+
+/**
+ * @brief bench counter structure definition
+ */
+typedef struct ds3231_bench_counter_s
+{
+    uint64_t transaction;        /**< iic transaction number */
+    uint64_t byte;               /**< bytes on the wire including the address bytes */
+    uint64_t bit;                /**< bit clocks on the wire including start, restart and stop */
+} ds3231_bench_counter_t;
+
+static ds3231_handle_t gs_handle;                /**< ds3231 handle */
+static ds3231_bench_counter_t gs_counter;        /**< bus counter */
+
+/**
+ * @brief benched written time
+ */
+static ds3231_time_t gs_time =
+{
+    2024, 1, 1, 1, 12, 30, 0, DS3231_FORMAT_24H, DS3231_AM
+};
+
+/**
+ * @brief benched api names
+ */
+static const char *const gs_name[] =
+{
+    "ds3231_get_time",
+    "ds3231_set_time",
+    "ds3231_get_alarm1",
+    "ds3231_set_alarm1",
+    "ds3231_get_alarm2",
+    "ds3231_set_alarm2",
+    "ds3231_alarm_clear",
+    "ds3231_get_alarm_interrupt",
+    "ds3231_set_alarm_interrupt",
+    "ds3231_get_oscillator",
+    "ds3231_set_oscillator",
+    "ds3231_get_status",
+    "ds3231_get_pin",
+    "ds3231_set_pin",
+    "ds3231_get_square_wave",
+    "ds3231_set_square_wave",
+    "ds3231_get_square_wave_frequency",
+    "ds3231_set_square_wave_frequency",
+    "ds3231_get_32khz_output",
+    "ds3231_set_32khz_output",
+    "ds3231_get_aging_offset",
+    "ds3231_set_aging_offset",
+    "ds3231_get_temperature",
+    "ds3231_get_temperature_no_conversion",
+    "ds3231_read_snapshot"
+};
+
+/**
+ * @brief      counting iic bus read
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       a read is start, address, register, restart, address, data and stop
+ */
+static uint8_t a_ds3231_bench_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    gs_counter.transaction++;
+    gs_counter.byte += 3 + (uint64_t)len;
+    gs_counter.bit += (3 + (uint64_t)len) * 9 + 3;
+    
+    return ds3231_simulator_iic_read(addr, reg, buf, len);
+}
+
+/**
+ * @brief     counting iic bus write
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      a write is start, address, register, data and stop
+ */
+static uint8_t a_ds3231_bench_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    gs_counter.transaction++;
+    gs_counter.byte += 2 + (uint64_t)len;
+    gs_counter.bit += (2 + (uint64_t)len) * 9 + 2;
+    
+    return ds3231_simulator_iic_write(addr, reg, buf, len);
+}
+
+/**
+ * @brief     call one benched api
+ * @param[in] index api index
+ * @return    status code
+ *            - 0 success
+ *            - 1 call failed
+ * @note      none
+ */
+static uint8_t a_ds3231_bench_call(uint8_t index)
+{
+    ds3231_time_t t;
+    ds3231_alarm1_mode_t mode1;
+    ds3231_alarm2_mode_t mode2;
+    ds3231_bool_t enable;
+    ds3231_pin_t pin;
+    ds3231_square_wave_frequency_t frequency;
+    ds3231_snapshot_t snapshot;
+    uint8_t status;
+    int8_t offset;
+    int16_t raw;
+    float s;
+    
+    switch (index)
+    {
+        case 0 :
+        {
+            return ds3231_get_time(&gs_handle, &t);
+        }
+        case 1 :
+        {
+            return ds3231_set_time(&gs_handle, &gs_time);
+        }
+        case 2 :
+        {
+            return ds3231_get_alarm1(&gs_handle, &t, &mode1);
+        }
+        case 3 :
+        {
+            return ds3231_set_alarm1(&gs_handle, &gs_time, DS3231_ALARM1_MODE_HOUR_MINUTE_SECOND_MATCH);
+        }
+        case 4 :
+        {
+            return ds3231_get_alarm2(&gs_handle, &t, &mode2);
+        }
+        case 5 :
+        {
+            return ds3231_set_alarm2(&gs_handle, &gs_time, DS3231_ALARM2_MODE_HOUR_MINUTE_MATCH);
+        }
+        case 6 :
+        {
+            return ds3231_alarm_clear(&gs_handle, DS3231_ALARM_1);
+        }
+        case 7 :
+        {
+            return ds3231_get_alarm_interrupt(&gs_handle, DS3231_ALARM_1, &enable);
+        }
+        case 8 :
+        {
+            return ds3231_set_alarm_interrupt(&gs_handle, DS3231_ALARM_1, DS3231_BOOL_FALSE);
+        }
+        case 9 :
+        {
+            return ds3231_get_oscillator(&gs_handle, &enable);
+        }
+        case 10 :
+        {
+            return ds3231_set_oscillator(&gs_handle, DS3231_BOOL_TRUE);
+        }
+        case 11 :
+        {
+            return ds3231_get_status(&gs_handle, &status);
+        }
+        case 12 :
+        {
+            return ds3231_get_pin(&gs_handle, &pin);
+        }
+        case 13 :
+        {
+            return ds3231_set_pin(&gs_handle, DS3231_PIN_INTERRUPT);
+        }
+        case 14 :
+        {
+            return ds3231_get_square_wave(&gs_handle, &enable);
+        }
+        case 15 :
+        {
+            return ds3231_set_square_wave(&gs_handle, DS3231_BOOL_FALSE);
+        }
+        case 16 :
+        {
+            return ds3231_get_square_wave_frequency(&gs_handle, &frequency);
+        }
+        case 17 :
+        {
+            return ds3231_set_square_wave_frequency(&gs_handle, DS3231_SQUARE_WAVE_FREQUENCY_1HZ);
+        }
+        case 18 :
+        {
+            return ds3231_get_32khz_output(&gs_handle, &enable);
+        }
+        case 19 :
+        {
+            return ds3231_set_32khz_output(&gs_handle, DS3231_BOOL_FALSE);
+        }
+        case 20 :
+        {
+            return ds3231_get_aging_offset(&gs_handle, &offset);
+        }
+        case 21 :
+        {
+            return ds3231_set_aging_offset(&gs_handle, 0);
+        }
+        case 22 :
+        {
+            return ds3231_get_temperature(&gs_handle, &raw, &s);
+        }
+        case 23 :
+        {
+            return ds3231_get_temperature_no_conversion(&gs_handle, &raw, &s);
+        }
+        case 24 :
+        {
+            return ds3231_read_snapshot(&gs_handle, &snapshot);
+        }
+        default :
+        {
+            return 1;
+        }
+    }
+}
+
+/**
+ * @brief     bench run all the apis
+ * @param[in] times run times of each api
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the driver runs on the simulated device behind counting iic hooks,
+ *            each api prints one json line with ns/op, bus transactions, bytes and
+ *            the estimated bus time at 100khz and 400khz
+ */
+uint8_t ds3231_bench_run(uint32_t times)
+{
+    uint8_t res;
+    uint8_t i;
+    uint8_t cache;
+    uint32_t j;
+    clock_t start;
+    clock_t stop;
+    double ns;
+    double bit;
+    
+    /* check the times */
+    if (times == 0)
+    {
+        ds3231_interface_debug_print("ds3231: times is invalid.\n");
+        
+        return 1;
+    }
+    
+    /* link functions */
+    DRIVER_DS3231_LINK_INIT(&gs_handle, ds3231_handle_t);
+    DRIVER_DS3231_LINK_IIC_INIT(&gs_handle, ds3231_simulator_iic_init);
+    DRIVER_DS3231_LINK_IIC_DEINIT(&gs_handle, ds3231_simulator_iic_deinit);
+    DRIVER_DS3231_LINK_IIC_READ(&gs_handle, a_ds3231_bench_iic_read);
+    DRIVER_DS3231_LINK_IIC_WRITE(&gs_handle, a_ds3231_bench_iic_write);
+    DRIVER_DS3231_LINK_DELAY_MS(&gs_handle, ds3231_simulator_delay_ms);
+    DRIVER_DS3231_LINK_DEBUG_PRINT(&gs_handle, ds3231_interface_debug_print);
+    DRIVER_DS3231_LINK_RECEIVE_CALLBACK(&gs_handle, ds3231_interface_receive_callback);
+    DRIVER_DS3231_LINK_LOCK(&gs_handle, ds3231_interface_lock);
+    DRIVER_DS3231_LINK_UNLOCK(&gs_handle, ds3231_interface_unlock);
+    
+    /* start from a power on device */
+    (void)ds3231_simulator_reset();
+    
+    /* init ds3231 */
+    res = ds3231_init(&gs_handle);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* run every api without and with the register cache */
+    for (cache = 0; cache < 2; cache++)
+    {
+        res = ds3231_set_register_cache(&gs_handle, (ds3231_bool_t)cache);
+        if (res != 0)
+        {
+            ds3231_interface_debug_print("ds3231: set register cache failed.\n");
+            (void)ds3231_deinit(&gs_handle);
+            
+            return 1;
+        }
+        for (i = 0; i < sizeof(gs_name) / sizeof(gs_name[0]); i++)
+        {
+            /* warm up the cache */
+            res = a_ds3231_bench_call(i);
+            if (res != 0)
+            {
+                ds3231_interface_debug_print("ds3231: %s failed.\n", gs_name[i]);
+                (void)ds3231_deinit(&gs_handle);
+                
+                return 1;
+            }
+            
+            /* run the api */
+            gs_counter.transaction = 0;
+            gs_counter.byte = 0;
+            gs_counter.bit = 0;
+            start = clock();
+            for (j = 0; j < times; j++)
+            {
+                res = a_ds3231_bench_call(i);
+                if (res != 0)
+                {
+                    ds3231_interface_debug_print("ds3231: %s failed.\n", gs_name[i]);
+                    (void)ds3231_deinit(&gs_handle);
+                    
+                    return 1;
+                }
+            }
+            stop = clock();
+            
+            /* one json line per api */
+            ns = (double)(stop - start) * 1000000000.0 / (double)CLOCKS_PER_SEC / (double)times;
+            bit = (double)gs_counter.bit / (double)times;
+            ds3231_interface_debug_print("{\"api\":\"%s\",\"cache\":%s,\"ops\":%u,\"ns_per_op\":%.1f,"
+                                         "\"transactions_per_op\":%.2f,\"bytes_per_op\":%.2f,"
+                                         "\"bus_us_per_op_100khz\":%.1f,\"bus_us_per_op_400khz\":%.1f}\n",
+                                         gs_name[i], (cache != 0) ? "true" : "false", times, ns,
+                                         (double)gs_counter.transaction / (double)times,
+                                         (double)gs_counter.byte / (double)times,
+                                         bit * 1000000.0 / 100000.0, bit * 1000000.0 / 400000.0);
+        }
+    }
+    
+    /* deinit ds3231 */
+    (void)ds3231_deinit(&gs_handle);
+    
+    return 0;
+}
@@ -0,0 +1,79 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds3231_bench.h
+ * @brief     driver ds3231 bench header file
+ * @version   2.0.0
+ * @author    Shifeng Li
+ * @date      2021-03-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2021/03/15  <td>2.0      <td>Shifeng Li  <td>format the code
+ * <tr><td>2020/11/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+  
+#ifndef DRIVER_DS3231_BENCH_H
+#define DRIVER_DS3231_BENCH_H
+
+#include "driver_ds3231_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @defgroup ds3231_bench_driver ds3231 bench driver function
+ * @brief    ds3231 bench driver modules
+ * @ingroup  ds3231_driver
+ * @{
+ */
+
+/**
+ * @brief ds3231 bench default definition
+ */
+#define DS3231_BENCH_DEFAULT_TIMES        1000        /**< 1000 times */
+
+/**
+ * @brief     bench run all the apis
+ * @param[in] times run times of each api
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the driver runs on the simulated device behind counting iic hooks,
+ *            each api prints one json line with ns/op, bus transactions, bytes and
+ *            the estimated bus time at 100khz and 400khz
+ */
+uint8_t ds3231_bench_run(uint32_t times);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -64,6 +64,29 @@ extern "C"{
  */
 uint8_t ds3231_alarm_irq_handler(void);
 
+/**
+ * @brief     alarm irq handler that queues the events
+ * @param[in] timestamp timestamp stored in the events
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the alarm flags are cleared and no callback is run,
+ *            use ds3231_alarm_get_events to read the events
+ */
+uint8_t ds3231_alarm_irq_event_handler(uint64_t timestamp);
+
+/**
+ * @brief      alarm example get the queued events
+ * @param[out] *events pointer to an event buffer
+ * @param[in]  len event buffer length
+ * @param[out] *count pointer to a read event count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get events failed
+ * @note       none
+ */
+uint8_t ds3231_alarm_get_events(ds3231_event_t *events, uint32_t len, uint32_t *count);
+
 /**
  * @brief     alarm example init
  * @param[in] *alarm_receive_callback pointer to a alarm receive callback function callback
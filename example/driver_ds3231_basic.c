@@ -41,13 +41,14 @@ static ds3231_handle_t gs_handle;        /**< ds3231 handle */
 static int8_t gs_time_zone = 0;          /**< local zone */
 
 /**
- * @brief  basic example init
- * @return status code
- *         - 0 success
- *         - 1 init failed
- * @note   none
+ * @brief     basic example init the device
+ * @param[in] aging bool value, DS3231_BOOL_TRUE writes the default aging offset
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      none
  */
-uint8_t ds3231_basic_init(void)
+static uint8_t a_ds3231_basic_init(ds3231_bool_t aging)
 {
     uint8_t res;
     int8_t reg;
@@ -58,9 +59,12 @@ uint8_t ds3231_basic_init(void)
     DRIVER_DS3231_LINK_IIC_DEINIT(&gs_handle, ds3231_interface_iic_deinit);
     DRIVER_DS3231_LINK_IIC_READ(&gs_handle, ds3231_interface_iic_read);
     DRIVER_DS3231_LINK_IIC_WRITE(&gs_handle, ds3231_interface_iic_write);
+    DRIVER_DS3231_LINK_IIC_TRANSFER(&gs_handle, ds3231_interface_iic_transfer);
     DRIVER_DS3231_LINK_DELAY_MS(&gs_handle, ds3231_interface_delay_ms);
     DRIVER_DS3231_LINK_DEBUG_PRINT(&gs_handle, ds3231_interface_debug_print);
     DRIVER_DS3231_LINK_RECEIVE_CALLBACK(&gs_handle, ds3231_interface_receive_callback);
+    DRIVER_DS3231_LINK_LOCK(&gs_handle, ds3231_interface_lock);
+    DRIVER_DS3231_LINK_UNLOCK(&gs_handle, ds3231_interface_unlock);
 
     /* init ds3231 */
     res = ds3231_init(&gs_handle);
@@ -131,6 +135,12 @@ uint8_t ds3231_basic_init(void)
         return 1;
     }
     
+    /* keep the aging offset stored in the chip */
+    if (aging == DS3231_BOOL_FALSE)
+    {
+        return 0;
+    }
+    
     /* convert to register */
     res = ds3231_aging_offset_convert_to_register(&gs_handle, DS3231_BASIC_DEFAULT_AGING_OFFSET, (int8_t *)&reg);
     if (res != 0)
@@ -154,6 +164,30 @@ uint8_t ds3231_basic_init(void)
     return 0;
 }
 
+/**
+ * @brief  basic example init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   the aging offset is set to DS3231_BASIC_DEFAULT_AGING_OFFSET
+ */
+uint8_t ds3231_basic_init(void)
+{
+    return a_ds3231_basic_init(DS3231_BOOL_TRUE);
+}
+
+/**
+ * @brief  basic example init and keep the aging offset
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   use it when the offset was calibrated, e.g. by the calibration example
+ */
+uint8_t ds3231_basic_init_keep_aging(void)
+{
+    return a_ds3231_basic_init(DS3231_BOOL_FALSE);
+}
+
 /**
  * @brief  basic example deinit
  * @return status code
@@ -205,27 +239,12 @@ uint8_t ds3231_basic_set_time(ds3231_time_t *t)
 uint8_t ds3231_basic_set_timestamp(time_t timestamp)
 {
     ds3231_time_t t;
-    struct tm *timeptr;
     
     /* convert times */
-    timestamp += (time_t)(gs_time_zone * 3600);
-    timeptr = localtime(&timestamp);
-    t.am_pm = DS3231_AM;
-    t.date = (uint8_t)timeptr->tm_mday;
-    t.format = DS3231_FORMAT_24H;
-    t.hour = (uint8_t)timeptr->tm_hour;
-    t.minute = (uint8_t)timeptr->tm_min;
-    t.month = (uint8_t)timeptr->tm_mon + 1;
-    t.second = (uint8_t)timeptr->tm_sec;
-    if (timeptr->tm_wday == 0)
+    if (ds3231_unix_to_time(&gs_handle, (int64_t)timestamp, (int32_t)gs_time_zone * 3600, &t) != 0)
     {
-        t.week  = 7;
-    }
-    else
-    {
-        t.week = (uint8_t)timeptr->tm_wday;
+        return 1;
     }
-    t.year = (uint16_t)(timeptr->tm_year + 1900);
     
     /* set time */
     if (ds3231_set_time(&gs_handle, &t) != 0)
@@ -284,30 +303,20 @@ uint8_t ds3231_basic_get_time(ds3231_time_t *t)
 uint8_t ds3231_basic_get_timestamp(time_t *timestamp)
 {
     ds3231_time_t t;
-    struct tm timeptr;
+    int64_t ts;
     
     /* get time */
     if (ds3231_get_time(&gs_handle, &t) != 0)
     {
         return 1;
     }
-    timeptr.tm_year = t.year - 1900;
-    timeptr.tm_mon = t.month - 1;
-    timeptr.tm_wday = t.week; 
-    timeptr.tm_mday = t.date;
-    if (t.format == DS3231_FORMAT_24H)
-    {
-        timeptr.tm_hour = t.hour;
-    }
-    else
-    {
-        timeptr.tm_hour = t.hour % 12 + t.am_pm * 12;
-    }
-    timeptr.tm_min = t.minute;
-    timeptr.tm_sec = t.second;
     
     /* make time */
-    *timestamp = mktime(&timeptr) - gs_time_zone * 3600;
+    if (ds3231_time_to_unix(&gs_handle, &t, (int32_t)gs_time_zone * 3600, &ts) != 0)
+    {
+        return 1;
+    }
+    *timestamp = (time_t)ts;
     
     return 0;
 }
@@ -380,3 +389,45 @@ uint8_t ds3231_basic_get_ascii_time(char *buf, uint8_t len)
     
     return 0;
 }
+
+/**
+ * @brief      basic example read the time, status and temperature registers at once
+ * @param[out] *snapshot pointer to a snapshot structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       one iic transaction, the temperature is the last conversion result
+ */
+uint8_t ds3231_basic_read_snapshot(ds3231_snapshot_t *snapshot)
+{
+    /* read snapshot */
+    if (ds3231_read_snapshot(&gs_handle, snapshot) != 0)
+    {
+        return 1;
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+/**
+ * @brief     basic example set the square wave frequency
+ * @param[in] frequency square wave frequency
+ * @return    status code
+ *            - 0 success
+ *            - 1 set square wave frequency failed
+ * @note      the square wave pin is selected by ds3231_basic_init
+ */
+uint8_t ds3231_basic_set_square_wave_frequency(ds3231_square_wave_frequency_t frequency)
+{
+    /* set square wave frequency */
+    if (ds3231_set_square_wave_frequency(&gs_handle, frequency) != 0)
+    {
+        return 1;
+    }
+    else
+    {
+        return 0;
+    }
+}
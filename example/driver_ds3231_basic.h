@@ -62,10 +62,19 @@ extern "C"{
  * @return status code
  *         - 0 success
  *         - 1 init failed
- * @note   none
+ * @note   the aging offset is set to DS3231_BASIC_DEFAULT_AGING_OFFSET
  */
 uint8_t ds3231_basic_init(void);
 
+/**
+ * @brief  basic example init and keep the aging offset
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   use it when the offset was calibrated, e.g. by the calibration example
+ */
+uint8_t ds3231_basic_init_keep_aging(void);
+
 /**
  * @brief  basic example deinit
  * @return status code
@@ -155,6 +164,26 @@ uint8_t ds3231_basic_get_temperature(int16_t *raw, float *s);
  */
 uint8_t ds3231_basic_get_ascii_time(char *buf, uint8_t len);
 
+/**
+ * @brief      basic example read the time, status and temperature registers at once
+ * @param[out] *snapshot pointer to a snapshot structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       one iic transaction, the temperature is the last conversion result
+ */
+uint8_t ds3231_basic_read_snapshot(ds3231_snapshot_t *snapshot);
+
+/**
+ * @brief     basic example set the square wave frequency
+ * @param[in] frequency square wave frequency
+ * @return    status code
+ *            - 0 success
+ *            - 1 set square wave frequency failed
+ * @note      the square wave pin is selected by ds3231_basic_init
+ */
+uint8_t ds3231_basic_set_square_wave_frequency(ds3231_square_wave_frequency_t frequency);
+
 /**
  * @}
  */
@@ -0,0 +1,703 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds3231_calibration.c
+ * @brief     driver ds3231 calibration source file
+ * @version   2.0.0
+ * @author    Shifeng Li
+ * @date      2021-03-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2021/03/15  <td>2.0      <td>Shifeng Li  <td>format the code
+ * <tr><td>2020/11/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds3231_calibration.h"
+#include <math.h>
+#include <string.h>
+
+/**
+ * @brief calibration example edge window definition
+ */
+#define DS3231_CALIBRATION_PERIOD_US          1000000        /**< nominal square wave period */
+#define DS3231_CALIBRATION_EDGE_MIN_US        500000         /**< shorter intervals are glitches */
+
+/**
+ * @brief calibration example memory barrier definition
+ */
+#if defined(__GNUC__)
+#define DS3231_CALIBRATION_BARRIER()        __sync_synchronize()
+#else
+#define DS3231_CALIBRATION_BARRIER()
+#endif
+
+static ds3231_handle_t gs_handle;                   /**< ds3231 handle */
+static volatile uint8_t gs_restart = 1;             /**< restart request */
+static uint64_t gs_first_us = 0;                    /**< reference timestamp of the first edge */
+static uint64_t gs_last_us = 0;                     /**< reference timestamp of the last edge */
+static uint32_t gs_second = 0;                      /**< rtc seconds since the first edge */
+static uint32_t gs_count = 0;                       /**< fitted edges */
+static double gs_mean_x = 0.0;                      /**< mean rtc second */
+static double gs_mean_y = 0.0;                      /**< mean reference time in us */
+static double gs_cxy = 0.0;                         /**< co-moment of the rtc seconds and the reference time */
+static double gs_mxx = 0.0;                         /**< second moment of the rtc seconds */
+static double gs_myy = 0.0;                         /**< second moment of the reference time */
+static volatile uint32_t gs_sequence = 0;           /**< result sequence, odd while updating */
+static volatile float gs_ppm = 0.0f;                /**< measured drift */
+static volatile float gs_sigma = 0.0f;              /**< drift standard error */
+static volatile uint32_t gs_edges = 0;              /**< edges of the published drift */
+static volatile uint64_t gs_anchor_us = 0;          /**< published reference timestamp of the first edge */
+static volatile uint32_t gs_edge_second = 0;        /**< published rtc seconds of the last edge */
+static volatile uint64_t gs_edge_us = 0;            /**< published reference timestamp of the last edge */
+static ds3231_calibration_sample_t gs_history[DS3231_CALIBRATION_HISTORY_SIZE];        /**< temperature history */
+static uint32_t gs_history_head = 0;                /**< samples written to the history */
+static uint64_t gs_sample_anchor_us = 0;            /**< first edge of the previous sample */
+static uint32_t gs_sample_second = 0;               /**< rtc seconds of the previous sample */
+static uint64_t gs_sample_us = 0;                   /**< reference timestamp of the previous sample */
+static float gs_coefficient[3] = {0.0f};            /**< drift curve over the temperature */
+static uint8_t gs_model = 0;                        /**< drift curve fitted flag */
+
+/**
+ * @brief     publish the measured drift and the last edge
+ * @param[in] ppm measured drift
+ * @param[in] sigma drift standard error
+ * @param[in] edges fitted edges
+ * @note      only called from the edge handler, readers retry while the sequence is odd or changed
+ */
+static void a_ds3231_calibration_publish(float ppm, float sigma, uint32_t edges)
+{
+    gs_sequence = gs_sequence + 1;
+    DS3231_CALIBRATION_BARRIER();
+    gs_ppm = ppm;
+    gs_sigma = sigma;
+    gs_edges = edges;
+    gs_anchor_us = gs_first_us;
+    gs_edge_second = gs_second;
+    gs_edge_us = gs_last_us;
+    DS3231_CALIBRATION_BARRIER();
+    gs_sequence = gs_sequence + 1;
+}
+
+/**
+ * @brief      load a consistent copy of the last edge
+ * @param[out] *anchor_us pointer to a first edge timestamp buffer
+ * @param[out] *second pointer to an rtc seconds buffer
+ * @param[out] *edge_us pointer to an edge timestamp buffer
+ * @return     fitted edges
+ * @note       none
+ */
+static uint32_t a_ds3231_calibration_load_edge(uint64_t *anchor_us, uint32_t *second, uint64_t *edge_us)
+{
+    uint32_t sequence;
+    uint32_t edges;
+    
+    do
+    {
+        sequence = gs_sequence;
+        DS3231_CALIBRATION_BARRIER();
+        *anchor_us = gs_anchor_us;
+        *second = gs_edge_second;
+        *edge_us = gs_edge_us;
+        edges = gs_edges;
+        DS3231_CALIBRATION_BARRIER();
+    } while (((sequence & 1) != 0) || (sequence != gs_sequence));
+    
+    return edges;
+}
+
+/**
+ * @brief      solve the drift curve with least squares
+ * @param[out] *coefficient pointer to a coefficient buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 not enough samples
+ * @note       the curve is quadratic in the distance to 25C, a narrow temperature range
+ *             falls back to a line and then to the mean drift
+ */
+static uint8_t a_ds3231_calibration_solve(float *coefficient)
+{
+    double m[3][4];
+    double x;
+    double f;
+    double p;
+    uint32_t n;
+    uint32_t i;
+    uint8_t order;
+    uint8_t r;
+    uint8_t c;
+    uint8_t k;
+    
+    /* try the quadratic first */
+    for (order = 3; order > 0; order--)
+    {
+        /* build the normal equations */
+        memset(m, 0, sizeof(double) * 12);
+        n = (gs_history_head < DS3231_CALIBRATION_HISTORY_SIZE) ? gs_history_head : DS3231_CALIBRATION_HISTORY_SIZE;
+        p = 0.0;
+        for (i = 0; i < n; i++)
+        {
+            if (gs_history[i].valid == 0)
+            {
+                continue;
+            }
+            x = (double)gs_history[i].temperature - 25.0;
+            for (r = 0; r < order; r++)
+            {
+                for (c = 0; c < order; c++)
+                {
+                    m[r][c] += pow(x, r + c);
+                }
+                m[r][order] += pow(x, r) * gs_history[i].ppm;
+            }
+            p += 1.0;
+        }
+        if (p < (double)(order + 1))
+        {
+            continue;
+        }
+        
+        /* gaussian elimination, a tiny pivot means the samples do not span the curve */
+        for (k = 0; k < order; k++)
+        {
+            if (fabs(m[k][k]) < 1e-6 * p)
+            {
+                break;
+            }
+            for (r = k + 1; r < order; r++)
+            {
+                f = m[r][k] / m[k][k];
+                for (c = k; c <= order; c++)
+                {
+                    m[r][c] -= f * m[k][c];
+                }
+            }
+        }
+        if (k != order)
+        {
+            continue;
+        }
+        
+        /* back substitution */
+        for (k = order; k > 0; k--)
+        {
+            f = m[k - 1][order];
+            for (c = k; c < order; c++)
+            {
+                f -= m[k - 1][c] * m[c][order];
+            }
+            m[k - 1][order] = f / m[k - 1][k - 1];
+        }
+        for (k = 0; k < 3; k++)
+        {
+            coefficient[k] = (k < order) ? (float)m[k][order] : 0.0f;
+        }
+        
+        return 0;
+    }
+    
+    return 1;
+}
+
+/**
+ * @brief     add one edge to the least squares fit
+ * @param[in] x rtc seconds since the first edge
+ * @param[in] y reference time since the first edge in us
+ * @note      the running means and moments keep the fit exact over long windows without large sums
+ */
+static void a_ds3231_calibration_fit(double x, double y)
+{
+    double dx;
+    double dy;
+    
+    gs_count++;
+    dx = x - gs_mean_x;
+    dy = y - gs_mean_y;
+    gs_mean_x += dx / gs_count;
+    gs_mean_y += dy / gs_count;
+    gs_cxy += dx * (y - gs_mean_y);
+    gs_mxx += dx * (x - gs_mean_x);
+    gs_myy += dy * (y - gs_mean_y);
+}
+
+/**
+ * @brief  calibration example init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   the pin outputs a 1Hz square wave after init, connect it to an interrupt capable gpio,
+ *         the aging offset stored in the chip is kept
+ */
+uint8_t ds3231_calibration_init(void)
+{
+    uint8_t res;
+    
+    /* link functions */
+    DRIVER_DS3231_LINK_INIT(&gs_handle, ds3231_handle_t);
+    DRIVER_DS3231_LINK_IIC_INIT(&gs_handle, ds3231_interface_iic_init);
+    DRIVER_DS3231_LINK_IIC_DEINIT(&gs_handle, ds3231_interface_iic_deinit);
+    DRIVER_DS3231_LINK_IIC_READ(&gs_handle, ds3231_interface_iic_read);
+    DRIVER_DS3231_LINK_IIC_WRITE(&gs_handle, ds3231_interface_iic_write);
+    DRIVER_DS3231_LINK_IIC_TRANSFER(&gs_handle, ds3231_interface_iic_transfer);
+    DRIVER_DS3231_LINK_DELAY_MS(&gs_handle, ds3231_interface_delay_ms);
+    DRIVER_DS3231_LINK_DEBUG_PRINT(&gs_handle, ds3231_interface_debug_print);
+    DRIVER_DS3231_LINK_RECEIVE_CALLBACK(&gs_handle, ds3231_interface_receive_callback);
+    DRIVER_DS3231_LINK_LOCK(&gs_handle, ds3231_interface_lock);
+    DRIVER_DS3231_LINK_UNLOCK(&gs_handle, ds3231_interface_unlock);
+    
+    /* init ds3231 */
+    res = ds3231_init(&gs_handle);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* set oscillator */
+    res = ds3231_set_oscillator(&gs_handle, DS3231_BOOL_TRUE);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: set oscillator failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* disable alarm1 */
+    res = ds3231_set_alarm_interrupt(&gs_handle, DS3231_ALARM_1, DS3231_BOOL_FALSE);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: set alarm1 interrupt failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* disable alarm2 */
+    res = ds3231_set_alarm_interrupt(&gs_handle, DS3231_ALARM_2, DS3231_BOOL_FALSE);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: set alarm2 interrupt failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* set 1Hz */
+    res = ds3231_set_square_wave_frequency(&gs_handle, DS3231_SQUARE_WAVE_FREQUENCY_1HZ);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: set square wave frequency failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* set square wave */
+    res = ds3231_set_pin(&gs_handle, DS3231_PIN_SQUARE_WAVE);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: set pin failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* clear the history */
+    gs_history_head = 0;
+    gs_model = 0;
+    
+    /* wait for the first edge */
+    gs_restart = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief  calibration example deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t ds3231_calibration_deinit(void)
+{
+    /* drop the fit */
+    gs_restart = 1;
+    
+    if (ds3231_deinit(&gs_handle) != 0)
+    {
+        return 1;
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+/**
+ * @brief  calibration example start a new measurement
+ * @return status code
+ *         - 0 success
+ * @note   the fit is cleared on the next edge
+ */
+uint8_t ds3231_calibration_start(void)
+{
+    gs_restart = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief     calibration example square wave edge handler
+ * @param[in] reference_us reference timestamp of the falling edge in microseconds
+ * @return    status code
+ *            - 0 success
+ * @note      call it from the gpio interrupt on every falling edge,
+ *            the reference should be taken at the edge, e.g. the kernel line event timestamp or a pps disciplined counter
+ */
+uint8_t ds3231_calibration_edge(uint64_t reference_us)
+{
+    uint64_t delta;
+    double slope;
+    double residual;
+    float ppm;
+    float sigma;
+    
+    /* the first edge after a restart anchors the fit */
+    if ((gs_restart != 0) || (reference_us <= gs_last_us))
+    {
+        gs_restart = 0;
+        gs_first_us = reference_us;
+        gs_last_us = reference_us;
+        gs_second = 0;
+        gs_count = 0;
+        gs_mean_x = 0.0;
+        gs_mean_y = 0.0;
+        gs_cxy = 0.0;
+        gs_mxx = 0.0;
+        gs_myy = 0.0;
+        a_ds3231_calibration_fit(0.0, 0.0);
+        a_ds3231_calibration_publish(0.0f, 0.0f, 1);
+        
+        return 0;
+    }
+    
+    /* ignore glitches */
+    delta = reference_us - gs_last_us;
+    if (delta < DS3231_CALIBRATION_EDGE_MIN_US)
+    {
+        return 0;
+    }
+    
+    /* a lost edge still advances the rtc by whole seconds */
+    gs_second += (uint32_t)((delta + DS3231_CALIBRATION_PERIOD_US / 2) / DS3231_CALIBRATION_PERIOD_US);
+    gs_last_us = reference_us;
+    a_ds3231_calibration_fit((double)gs_second, (double)(reference_us - gs_first_us));
+    if (gs_count < 3)
+    {
+        a_ds3231_calibration_publish(0.0f, 0.0f, gs_count);
+        
+        return 0;
+    }
+    
+    /* the slope is the rtc second measured in reference microseconds */
+    slope = gs_cxy / gs_mxx;
+    residual = gs_myy - gs_cxy * slope;
+    if (residual < 0.0)
+    {
+        residual = 0.0;
+    }
+    ppm = (float)((DS3231_CALIBRATION_PERIOD_US - slope) / slope * 1000000.0);
+    sigma = (float)(sqrt(residual / (gs_count - 2) / gs_mxx) / slope * 1000000.0);
+    a_ds3231_calibration_publish(ppm, sigma, gs_count);
+    
+    return 0;
+}
+
+/**
+ * @brief      calibration example get the measured drift
+ * @param[out] *ppm pointer to a drift buffer, positive means the rtc runs fast
+ * @param[out] *sigma pointer to a drift standard error buffer
+ * @param[out] *edges pointer to a fitted edges buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 not enough edges
+ * @note       it can be called from any thread
+ */
+uint8_t ds3231_calibration_get_drift(float *ppm, float *sigma, uint32_t *edges)
+{
+    uint32_t sequence;
+    
+    /* load a consistent copy */
+    do
+    {
+        sequence = gs_sequence;
+        DS3231_CALIBRATION_BARRIER();
+        *ppm = gs_ppm;
+        *sigma = gs_sigma;
+        *edges = gs_edges;
+        DS3231_CALIBRATION_BARRIER();
+    } while (((sequence & 1) != 0) || (sequence != gs_sequence));
+    
+    /* a restart drops the old result */
+    if ((gs_restart != 0) || (*edges < 3))
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      calibration example correct the aging offset with the measured drift
+ * @param[out] *offset pointer to a written aging offset register buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 apply failed or not enough edges
+ * @note       a temperature conversion is started so the offset is used at once,
+ *             the measurement is started again after it
+ */
+uint8_t ds3231_calibration_apply(int8_t *offset)
+{
+    uint8_t res;
+    int8_t reg;
+    int32_t value;
+    float ppm;
+    float sigma;
+    uint32_t edges;
+    
+    /* get the drift */
+    if (ds3231_calibration_get_drift(&ppm, &sigma, &edges) != 0)
+    {
+        ds3231_interface_debug_print("ds3231: not enough edges.\n");
+        
+        return 1;
+    }
+    
+    /* get the current offset */
+    res = ds3231_get_aging_offset(&gs_handle, (int8_t *)&reg);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: get aging offset failed.\n");
+        
+        return 1;
+    }
+    
+    /* a positive step slows the oscillator, so a fast rtc needs a larger offset */
+    value = (int32_t)reg + (int32_t)lroundf(ppm / DS3231_CALIBRATION_PPM_PER_LSB);
+    if (value > 127)
+    {
+        value = 127;
+    }
+    if (value < -128)
+    {
+        value = -128;
+    }
+    
+    /* write the offset */
+    res = ds3231_calibration_restore((int8_t)value);
+    if (res != 0)
+    {
+        return 1;
+    }
+    *offset = (int8_t)value;
+    
+    /* measure the corrected rtc */
+    gs_restart = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief     calibration example restore a saved aging offset
+ * @param[in] offset aging offset register
+ * @return    status code
+ *            - 0 success
+ *            - 1 restore failed
+ * @note      the register survives on the backup battery, call it after the battery was lost or after
+ *            ds3231_basic_init, ds3231_alarm_init or ds3231_output_init wrote the default offset
+ */
+uint8_t ds3231_calibration_restore(int8_t offset)
+{
+    uint8_t res;
+    
+    /* set aging offset */
+    res = ds3231_set_aging_offset(&gs_handle, offset);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: set aging offset failed.\n");
+        
+        return 1;
+    }
+    
+    /* the offset is only used from the next conversion */
+    res = ds3231_start_temperature_conversion(&gs_handle);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: start temperature conversion failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     calibration example sample the temperature and the drift since the last sample
+ * @param[in] timestamp_us reference timestamp in microseconds
+ * @return    status code
+ *            - 0 success
+ *            - 1 sample failed
+ * @note      the temperature register is read without a conversion, the chip updates it every 64s,
+ *            the first sample and the first one after a restart carry no drift
+ */
+uint8_t ds3231_calibration_sample(uint64_t timestamp_us)
+{
+    uint8_t res;
+    int16_t raw;
+    float temperature;
+    uint64_t anchor_us;
+    uint64_t edge_us;
+    uint32_t second;
+    uint32_t edges;
+    ds3231_calibration_sample_t *sample;
+    
+    /* read the last conversion */
+    res = ds3231_get_temperature_no_conversion(&gs_handle, (int16_t *)&raw, (float *)&temperature);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: get temperature failed.\n");
+        
+        return 1;
+    }
+    
+    /* write the next slot */
+    sample = &gs_history[gs_history_head % DS3231_CALIBRATION_HISTORY_SIZE];
+    sample->timestamp_us = timestamp_us;
+    sample->temperature = temperature;
+    sample->ppm = 0.0f;
+    sample->valid = 0;
+    
+    /* the drift between the edges seen by two samples of the same fit */
+    edges = a_ds3231_calibration_load_edge(&anchor_us, &second, &edge_us);
+    if ((gs_restart == 0) && (edges != 0) && (anchor_us == gs_sample_anchor_us) &&
+        (edge_us > gs_sample_us) && (second > gs_sample_second))
+    {
+        sample->ppm = (float)(((double)(second - gs_sample_second) * DS3231_CALIBRATION_PERIOD_US -
+                               (double)(edge_us - gs_sample_us)) / (double)(edge_us - gs_sample_us) * 1000000.0);
+        sample->valid = 1;
+    }
+    gs_sample_anchor_us = anchor_us;
+    gs_sample_second = second;
+    gs_sample_us = edge_us;
+    gs_history_head++;
+    
+    return 0;
+}
+
+/**
+ * @brief      calibration example get the temperature history
+ * @param[out] *samples pointer to a sample buffer
+ * @param[in]  len sample buffer length
+ * @param[out] *count pointer to a read sample count buffer
+ * @return     status code
+ *             - 0 success
+ * @note       the newest samples are returned from the oldest to the newest
+ */
+uint8_t ds3231_calibration_get_history(ds3231_calibration_sample_t *samples, uint32_t len, uint32_t *count)
+{
+    uint32_t n;
+    uint32_t i;
+    
+    /* newest samples that fit into the buffer */
+    n = (gs_history_head < DS3231_CALIBRATION_HISTORY_SIZE) ? gs_history_head : DS3231_CALIBRATION_HISTORY_SIZE;
+    if (n > len)
+    {
+        n = len;
+    }
+    for (i = 0; i < n; i++)
+    {
+        samples[i] = gs_history[(gs_history_head - n + i) % DS3231_CALIBRATION_HISTORY_SIZE];
+    }
+    *count = n;
+    
+    return 0;
+}
+
+/**
+ * @brief      calibration example fit the drift over the temperature
+ * @param[out] *coefficient pointer to a 3 coefficients buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 not enough samples
+ * @note       ppm = c0 + c1 * (t - 25) + c2 * (t - 25)^2
+ */
+uint8_t ds3231_calibration_fit_temperature(float coefficient[3])
+{
+    /* solve the curve */
+    if (a_ds3231_calibration_solve(gs_coefficient) != 0)
+    {
+        ds3231_interface_debug_print("ds3231: not enough samples.\n");
+        
+        return 1;
+    }
+    gs_model = 1;
+    coefficient[0] = gs_coefficient[0];
+    coefficient[1] = gs_coefficient[1];
+    coefficient[2] = gs_coefficient[2];
+    
+    return 0;
+}
+
+/**
+ * @brief      calibration example predict the time error of an rtc read
+ * @param[in]  temperature mean temperature since the last synchronization
+ * @param[in]  elapsed_s rtc seconds since the last synchronization
+ * @param[out] *correction_us pointer to a correction buffer, add it to the rtc time
+ * @return     status code
+ *             - 0 success
+ *             - 1 the curve is not fitted
+ * @note       a fast rtc gains ppm microseconds every second, so the correction is negative
+ */
+uint8_t ds3231_calibration_predict(float temperature, uint32_t elapsed_s, int32_t *correction_us)
+{
+    float x;
+    float ppm;
+    
+    if (gs_model == 0)
+    {
+        return 1;
+    }
+    
+    /* evaluate the curve */
+    x = temperature - 25.0f;
+    ppm = gs_coefficient[0] + gs_coefficient[1] * x + gs_coefficient[2] * x * x;
+    *correction_us = (int32_t)lroundf(-ppm * (float)elapsed_s);
+    
+    return 0;
+}
+
@@ -0,0 +1,194 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds3231_calibration.h
+ * @brief     driver ds3231 calibration header file
+ * @version   2.0.0
+ * @author    Shifeng Li
+ * @date      2021-03-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2021/03/15  <td>2.0      <td>Shifeng Li  <td>format the code
+ * <tr><td>2020/11/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+  
+#ifndef DRIVER_DS3231_CALIBRATION_H
+#define DRIVER_DS3231_CALIBRATION_H
+
+#include "driver_ds3231_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup ds3231_example_driver
+ * @{
+ */
+
+/**
+ * @brief ds3231 calibration example default definition
+ */
+#define DS3231_CALIBRATION_DEFAULT_WINDOW          600          /**< fit the drift over 600 edges */
+#define DS3231_CALIBRATION_PPM_PER_LSB             0.12f        /**< drift corrected by one aging offset step */
+#define DS3231_CALIBRATION_HISTORY_SIZE            64           /**< temperature samples kept */
+#define DS3231_CALIBRATION_SAMPLE_INTERVAL_S       64           /**< the chip converts the temperature every 64s */
+
+/**
+ * @brief ds3231 calibration sample structure definition
+ */
+typedef struct ds3231_calibration_sample_s
+{
+    uint64_t timestamp_us;        /**< reference timestamp */
+    float temperature;            /**< temperature register */
+    float ppm;                    /**< drift since the previous sample */
+    uint8_t valid;                /**< 1 when the drift is measured */
+} ds3231_calibration_sample_t;
+
+/**
+ * @brief  calibration example init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   the pin outputs a 1Hz square wave after init, connect it to an interrupt capable gpio,
+ *         the aging offset stored in the chip is kept
+ */
+uint8_t ds3231_calibration_init(void);
+
+/**
+ * @brief  calibration example deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t ds3231_calibration_deinit(void);
+
+/**
+ * @brief  calibration example start a new measurement
+ * @return status code
+ *         - 0 success
+ * @note   the fit is cleared on the next edge
+ */
+uint8_t ds3231_calibration_start(void);
+
+/**
+ * @brief     calibration example square wave edge handler
+ * @param[in] reference_us reference timestamp of the falling edge in microseconds
+ * @return    status code
+ *            - 0 success
+ * @note      call it from the gpio interrupt on every falling edge,
+ *            the reference should be taken at the edge, e.g. the kernel line event timestamp or a pps disciplined counter
+ */
+uint8_t ds3231_calibration_edge(uint64_t reference_us);
+
+/**
+ * @brief      calibration example get the measured drift
+ * @param[out] *ppm pointer to a drift buffer, positive means the rtc runs fast
+ * @param[out] *sigma pointer to a drift standard error buffer
+ * @param[out] *edges pointer to a fitted edges buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 not enough edges
+ * @note       it can be called from any thread
+ */
+uint8_t ds3231_calibration_get_drift(float *ppm, float *sigma, uint32_t *edges);
+
+/**
+ * @brief      calibration example correct the aging offset with the measured drift
+ * @param[out] *offset pointer to a written aging offset register buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 apply failed or not enough edges
+ * @note       a temperature conversion is started so the offset is used at once,
+ *             the measurement is started again after it
+ */
+uint8_t ds3231_calibration_apply(int8_t *offset);
+
+/**
+ * @brief     calibration example restore a saved aging offset
+ * @param[in] offset aging offset register
+ * @return    status code
+ *            - 0 success
+ *            - 1 restore failed
+ * @note      the register survives on the backup battery, call it after the battery was lost or after
+ *            ds3231_basic_init, ds3231_alarm_init or ds3231_output_init wrote the default offset
+ */
+uint8_t ds3231_calibration_restore(int8_t offset);
+
+/**
+ * @brief     calibration example sample the temperature and the drift since the last sample
+ * @param[in] timestamp_us reference timestamp in microseconds
+ * @return    status code
+ *            - 0 success
+ *            - 1 sample failed
+ * @note      the temperature register is read without a conversion, the chip updates it every 64s,
+ *            the first sample and the first one after a restart carry no drift
+ */
+uint8_t ds3231_calibration_sample(uint64_t timestamp_us);
+
+/**
+ * @brief      calibration example get the temperature history
+ * @param[out] *samples pointer to a sample buffer
+ * @param[in]  len sample buffer length
+ * @param[out] *count pointer to a read sample count buffer
+ * @return     status code
+ *             - 0 success
+ * @note       the newest samples are returned from the oldest to the newest
+ */
+uint8_t ds3231_calibration_get_history(ds3231_calibration_sample_t *samples, uint32_t len, uint32_t *count);
+
+/**
+ * @brief      calibration example fit the drift over the temperature
+ * @param[out] *coefficient pointer to a 3 coefficients buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 not enough samples
+ * @note       ppm = c0 + c1 * (t - 25) + c2 * (t - 25)^2
+ */
+uint8_t ds3231_calibration_fit_temperature(float coefficient[3]);
+
+/**
+ * @brief      calibration example predict the time error of an rtc read
+ * @param[in]  temperature mean temperature since the last synchronization
+ * @param[in]  elapsed_s rtc seconds since the last synchronization
+ * @param[out] *correction_us pointer to a correction buffer, add it to the rtc time
+ * @return     status code
+ *             - 0 success
+ *             - 1 the curve is not fitted
+ * @note       a fast rtc gains ppm microseconds every second, so the correction is negative
+ */
+uint8_t ds3231_calibration_predict(float temperature, uint32_t elapsed_s, int32_t *correction_us);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
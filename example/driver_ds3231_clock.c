@@ -0,0 +1,396 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds3231_clock.c
+ * @brief     driver ds3231 clock source file
+ * @version   2.0.0
+ * @author    Shifeng Li
+ * @date      2021-03-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2021/03/15  <td>2.0      <td>Shifeng Li  <td>format the code
+ * <tr><td>2020/11/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds3231_clock.h"
+
+/**
+ * @brief clock example edge window definition
+ */
+#define DS3231_CLOCK_PERIOD_US            1000000        /**< nominal square wave period */
+#define DS3231_CLOCK_EDGE_MIN_US          500000         /**< shorter intervals are glitches */
+#define DS3231_CLOCK_EDGE_MAX_US          1500000        /**< longer intervals mean a lost edge */
+
+/**
+ * @brief clock example memory barrier definition
+ */
+#if defined(__GNUC__)
+#define DS3231_CLOCK_BARRIER()        __sync_synchronize()
+#else
+#define DS3231_CLOCK_BARRIER()
+#endif
+
+static ds3231_handle_t gs_handle;                   /**< ds3231 handle */
+static int8_t gs_time_zone = 0;                     /**< local zone */
+static volatile uint8_t gs_resync = 0;              /**< resync request */
+static uint32_t gs_edges = 0;                       /**< edges since the last rtc read */
+static volatile uint32_t gs_sequence = 0;           /**< state sequence, odd while updating */
+static volatile int64_t gs_timestamp = 0;           /**< unix timestamp of the last edge */
+static volatile uint64_t gs_edge_us = 0;            /**< monotonic timestamp of the last edge */
+static volatile uint32_t gs_period_us = 0;          /**< measured square wave period */
+static volatile uint8_t gs_synced = 0;              /**< synchronized flag */
+
+/**
+ * @brief     publish the edge state
+ * @param[in] timestamp unix timestamp of the edge
+ * @param[in] edge_us monotonic timestamp of the edge
+ * @param[in] period_us measured square wave period
+ * @param[in] synced synchronized flag
+ * @note      only called from the edge handler, readers retry while the sequence is odd or changed
+ */
+static void a_ds3231_clock_publish(int64_t timestamp, uint64_t edge_us, uint32_t period_us, uint8_t synced)
+{
+    gs_sequence = gs_sequence + 1;
+    DS3231_CLOCK_BARRIER();
+    gs_timestamp = timestamp;
+    gs_edge_us = edge_us;
+    gs_period_us = period_us;
+    gs_synced = synced;
+    DS3231_CLOCK_BARRIER();
+    gs_sequence = gs_sequence + 1;
+}
+
+/**
+ * @brief      load a consistent copy of the edge state
+ * @param[out] *timestamp pointer to a unix timestamp buffer
+ * @param[out] *edge_us pointer to an edge timestamp buffer
+ * @param[out] *period_us pointer to a period buffer
+ * @param[out] *synced pointer to a synchronized flag buffer
+ * @note       none
+ */
+static void a_ds3231_clock_load(int64_t *timestamp, uint64_t *edge_us, uint32_t *period_us, uint8_t *synced)
+{
+    uint32_t sequence;
+    
+    do
+    {
+        sequence = gs_sequence;
+        DS3231_CLOCK_BARRIER();
+        *timestamp = gs_timestamp;
+        *edge_us = gs_edge_us;
+        *period_us = gs_period_us;
+        *synced = gs_synced;
+        DS3231_CLOCK_BARRIER();
+    } while (((sequence & 1) != 0) || (sequence != gs_sequence));
+}
+
+/**
+ * @brief  clock example init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   the pin outputs a 1Hz square wave after init, connect it to an interrupt capable gpio,
+ *         the aging offset stored in the chip is kept
+ */
+uint8_t ds3231_clock_init(void)
+{
+    uint8_t res;
+    
+    /* link functions */
+    DRIVER_DS3231_LINK_INIT(&gs_handle, ds3231_handle_t);
+    DRIVER_DS3231_LINK_IIC_INIT(&gs_handle, ds3231_interface_iic_init);
+    DRIVER_DS3231_LINK_IIC_DEINIT(&gs_handle, ds3231_interface_iic_deinit);
+    DRIVER_DS3231_LINK_IIC_READ(&gs_handle, ds3231_interface_iic_read);
+    DRIVER_DS3231_LINK_IIC_WRITE(&gs_handle, ds3231_interface_iic_write);
+    DRIVER_DS3231_LINK_IIC_TRANSFER(&gs_handle, ds3231_interface_iic_transfer);
+    DRIVER_DS3231_LINK_DELAY_MS(&gs_handle, ds3231_interface_delay_ms);
+    DRIVER_DS3231_LINK_DEBUG_PRINT(&gs_handle, ds3231_interface_debug_print);
+    DRIVER_DS3231_LINK_RECEIVE_CALLBACK(&gs_handle, ds3231_interface_receive_callback);
+    DRIVER_DS3231_LINK_LOCK(&gs_handle, ds3231_interface_lock);
+    DRIVER_DS3231_LINK_UNLOCK(&gs_handle, ds3231_interface_unlock);
+    
+    /* init ds3231 */
+    res = ds3231_init(&gs_handle);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* set oscillator */
+    res = ds3231_set_oscillator(&gs_handle, DS3231_BOOL_TRUE);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: set oscillator failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* disable alarm1 */
+    res = ds3231_set_alarm_interrupt(&gs_handle, DS3231_ALARM_1, DS3231_BOOL_FALSE);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: set alarm1 interrupt failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* disable alarm2 */
+    res = ds3231_set_alarm_interrupt(&gs_handle, DS3231_ALARM_2, DS3231_BOOL_FALSE);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: set alarm2 interrupt failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* set 1Hz */
+    res = ds3231_set_square_wave_frequency(&gs_handle, DS3231_SQUARE_WAVE_FREQUENCY_1HZ);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: set square wave frequency failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* set square wave */
+    res = ds3231_set_pin(&gs_handle, DS3231_PIN_SQUARE_WAVE);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: set pin failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* not synchronized until the first edge */
+    gs_edges = 0;
+    gs_resync = 0;
+    a_ds3231_clock_publish(0, 0, 0, 0);
+    
+    return 0;
+}
+
+/**
+ * @brief  clock example deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t ds3231_clock_deinit(void)
+{
+    /* drop the state */
+    a_ds3231_clock_publish(0, 0, 0, 0);
+    
+    if (ds3231_deinit(&gs_handle) != 0)
+    {
+        return 1;
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+/**
+ * @brief     clock example square wave edge handler
+ * @param[in] timestamp_us monotonic timestamp of the falling edge in microseconds
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      call it from the gpio interrupt on every falling edge,
+ *            the rtc is only read on the first edge, after a lost edge and every resync period
+ */
+uint8_t ds3231_clock_edge(uint64_t timestamp_us)
+{
+    int64_t timestamp;
+    uint64_t edge_us;
+    uint64_t delta;
+    uint32_t period_us;
+    uint8_t synced;
+    ds3231_time_t t;
+    
+    /* only the edge handler writes the state, so no retry is needed */
+    timestamp = gs_timestamp;
+    edge_us = gs_edge_us;
+    period_us = gs_period_us;
+    synced = gs_synced;
+    delta = timestamp_us - edge_us;
+    
+    /* check the interval since the last edge */
+    if (synced == 0)
+    {
+        period_us = DS3231_CLOCK_PERIOD_US;
+    }
+    else if ((timestamp_us > edge_us) && (delta <= DS3231_CLOCK_EDGE_MAX_US))
+    {
+        /* ignore glitches */
+        if (delta < DS3231_CLOCK_EDGE_MIN_US)
+        {
+            return 0;
+        }
+        
+        /* smooth the period */
+        period_us = (uint32_t)(((uint64_t)period_us * 7 + delta) / 8);
+        
+        /* advance one second without any iic traffic */
+        if ((gs_resync == 0) && (gs_edges < DS3231_CLOCK_DEFAULT_RESYNC_EDGES))
+        {
+            gs_edges++;
+            a_ds3231_clock_publish(timestamp + 1, timestamp_us, period_us, 1);
+            
+            return 0;
+        }
+    }
+    else
+    {
+        /* an edge is lost, keep the measured period */
+    }
+    
+    /* the seconds register has just been updated by this edge */
+    gs_resync = 0;
+    if (ds3231_get_time(&gs_handle, &t) != 0)
+    {
+        a_ds3231_clock_publish(0, 0, 0, 0);
+        
+        return 1;
+    }
+    if (ds3231_time_to_unix(&gs_handle, &t, (int32_t)gs_time_zone * 3600, &timestamp) != 0)
+    {
+        a_ds3231_clock_publish(0, 0, 0, 0);
+        
+        return 1;
+    }
+    gs_edges = 0;
+    a_ds3231_clock_publish(timestamp, timestamp_us, period_us, 1);
+    
+    return 0;
+}
+
+/**
+ * @brief      clock example get the interpolated time
+ * @param[in]  now_us current monotonic timestamp in microseconds
+ * @param[out] *timestamp pointer to a unix timestamp buffer
+ * @param[out] *us pointer to a microsecond buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 clock is not synchronized or the square wave is lost
+ * @note       now_us must come from the same clock as the edge timestamps,
+ *             no iic transaction is issued and it can be called from any thread
+ */
+uint8_t ds3231_clock_get_time(uint64_t now_us, int64_t *timestamp, uint32_t *us)
+{
+    int64_t second;
+    uint64_t edge_us;
+    uint64_t elapsed;
+    uint64_t fraction;
+    uint32_t period_us;
+    uint8_t synced;
+    
+    /* load the state */
+    a_ds3231_clock_load(&second, &edge_us, &period_us, &synced);
+    if ((synced == 0) || (period_us == 0))
+    {
+        return 1;
+    }
+    
+    /* a query older than the edge reports the edge, a lost edge is reported as the edge handler does */
+    elapsed = (now_us > edge_us) ? (now_us - edge_us) : 0;
+    if (elapsed > DS3231_CLOCK_EDGE_MAX_US)
+    {
+        return 1;
+    }
+    
+    /* never run past the next edge */
+    fraction = (elapsed * 1000000) / period_us;
+    if (fraction > 999999)
+    {
+        fraction = 999999;
+    }
+    *timestamp = second;
+    *us = (uint32_t)fraction;
+    
+    return 0;
+}
+
+/**
+ * @brief      clock example get the measured square wave period
+ * @param[out] *period_us pointer to a period buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 clock is not synchronized
+ * @note       none
+ */
+uint8_t ds3231_clock_get_period(uint32_t *period_us)
+{
+    int64_t second;
+    uint64_t edge_us;
+    uint8_t synced;
+    
+    /* load the state */
+    a_ds3231_clock_load(&second, &edge_us, period_us, &synced);
+    if (synced == 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     clock example set the local time zone
+ * @param[in] zone local time zone
+ * @return    status code
+ *            - 0 success
+ * @note      the clock is synchronized again on the next edge
+ */
+uint8_t ds3231_clock_set_time_zone(int8_t zone)
+{
+    gs_time_zone = zone;
+    gs_resync = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief      clock example get the local time zone
+ * @param[out] *zone pointer to a local time zone buffer
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+uint8_t ds3231_clock_get_time_zone(int8_t *zone)
+{
+    *zone = gs_time_zone;
+    
+    return 0;
+}
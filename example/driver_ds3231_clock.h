@@ -0,0 +1,136 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds3231_clock.h
+ * @brief     driver ds3231 clock header file
+ * @version   2.0.0
+ * @author    Shifeng Li
+ * @date      2021-03-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2021/03/15  <td>2.0      <td>Shifeng Li  <td>format the code
+ * <tr><td>2020/11/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+  
+#ifndef DRIVER_DS3231_CLOCK_H
+#define DRIVER_DS3231_CLOCK_H
+
+#include "driver_ds3231_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup ds3231_example_driver
+ * @{
+ */
+
+/**
+ * @brief ds3231 clock example default definition
+ */
+#define DS3231_CLOCK_DEFAULT_RESYNC_EDGES        3600        /**< read the rtc again every 3600 edges */
+
+/**
+ * @brief  clock example init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   the pin outputs a 1Hz square wave after init, connect it to an interrupt capable gpio,
+ *         the aging offset stored in the chip is kept
+ */
+uint8_t ds3231_clock_init(void);
+
+/**
+ * @brief  clock example deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   none
+ */
+uint8_t ds3231_clock_deinit(void);
+
+/**
+ * @brief     clock example square wave edge handler
+ * @param[in] timestamp_us monotonic timestamp of the falling edge in microseconds
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      call it from the gpio interrupt on every falling edge,
+ *            the rtc is only read on the first edge, after a lost edge and every resync period
+ */
+uint8_t ds3231_clock_edge(uint64_t timestamp_us);
+
+/**
+ * @brief      clock example get the interpolated time
+ * @param[in]  now_us current monotonic timestamp in microseconds
+ * @param[out] *timestamp pointer to a unix timestamp buffer
+ * @param[out] *us pointer to a microsecond buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 clock is not synchronized or the square wave is lost
+ * @note       now_us must come from the same clock as the edge timestamps,
+ *             no iic transaction is issued and it can be called from any thread
+ */
+uint8_t ds3231_clock_get_time(uint64_t now_us, int64_t *timestamp, uint32_t *us);
+
+/**
+ * @brief      clock example get the measured square wave period
+ * @param[out] *period_us pointer to a period buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 clock is not synchronized
+ * @note       none
+ */
+uint8_t ds3231_clock_get_period(uint32_t *period_us);
+
+/**
+ * @brief     clock example set the local time zone
+ * @param[in] zone local time zone
+ * @return    status code
+ *            - 0 success
+ * @note      the clock is synchronized again on the next edge
+ */
+uint8_t ds3231_clock_set_time_zone(int8_t zone);
+
+/**
+ * @brief      clock example get the local time zone
+ * @param[out] *zone pointer to a local time zone buffer
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+uint8_t ds3231_clock_get_time_zone(int8_t *zone);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -58,9 +58,12 @@ uint8_t ds3231_output_init(void)
     DRIVER_DS3231_LINK_IIC_DEINIT(&gs_handle, ds3231_interface_iic_deinit);
     DRIVER_DS3231_LINK_IIC_READ(&gs_handle, ds3231_interface_iic_read);
     DRIVER_DS3231_LINK_IIC_WRITE(&gs_handle, ds3231_interface_iic_write);
+    DRIVER_DS3231_LINK_IIC_TRANSFER(&gs_handle, ds3231_interface_iic_transfer);
     DRIVER_DS3231_LINK_DELAY_MS(&gs_handle, ds3231_interface_delay_ms);
     DRIVER_DS3231_LINK_DEBUG_PRINT(&gs_handle, ds3231_interface_debug_print);
     DRIVER_DS3231_LINK_RECEIVE_CALLBACK(&gs_handle, ds3231_interface_receive_callback);
+    DRIVER_DS3231_LINK_LOCK(&gs_handle, ds3231_interface_lock);
+    DRIVER_DS3231_LINK_UNLOCK(&gs_handle, ds3231_interface_unlock);
 
     /* init ds3231 */
     res = ds3231_init(&gs_handle);
@@ -185,27 +188,12 @@ uint8_t ds3231_output_set_time(ds3231_time_t *t)
 uint8_t ds3231_output_set_timestamp(time_t timestamp)
 {
     ds3231_time_t t;
-    struct tm *timeptr;
     
     /* convert times */
-    timestamp += (time_t)(gs_time_zone * 3600);
-    timeptr = localtime(&timestamp);
-    t.am_pm = DS3231_AM;
-    t.date = (uint8_t)timeptr->tm_mday;
-    t.format = DS3231_FORMAT_24H;
-    t.hour = (uint8_t)timeptr->tm_hour;
-    t.minute = (uint8_t)timeptr->tm_min;
-    t.month = (uint8_t)timeptr->tm_mon + 1;
-    t.second = (uint8_t)timeptr->tm_sec;
-    if (timeptr->tm_wday == 0)
+    if (ds3231_unix_to_time(&gs_handle, (int64_t)timestamp, (int32_t)gs_time_zone * 3600, &t) != 0)
     {
-        t.week  = 7;
-    }
-    else
-    {
-        t.week = (uint8_t)timeptr->tm_wday;
+        return 1;
     }
-    t.year = (uint16_t)(timeptr->tm_year + 1900);
     
     /* set time */
     if (ds3231_set_time(&gs_handle, &t) != 0)
@@ -264,30 +252,20 @@ uint8_t ds3231_output_get_time(ds3231_time_t *t)
 uint8_t ds3231_output_get_timestamp(time_t *timestamp)
 {
     ds3231_time_t t;
-    struct tm timeptr;
+    int64_t ts;
     
     /* get time */
     if (ds3231_get_time(&gs_handle, &t) != 0)
     {
         return 1;
     }
-    timeptr.tm_year = t.year - 1900;
-    timeptr.tm_mon = t.month - 1;
-    timeptr.tm_wday = t.week; 
-    timeptr.tm_mday = t.date;
-    if (t.format == DS3231_FORMAT_24H)
-    {
-        timeptr.tm_hour = t.hour;
-    }
-    else
-    {
-        timeptr.tm_hour = t.hour % 12 + t.am_pm * 12;
-    }
-    timeptr.tm_min = t.minute;
-    timeptr.tm_sec = t.second;
     
     /* make time */
-    *timestamp = mktime(&timeptr) - gs_time_zone * 3600;
+    if (ds3231_time_to_unix(&gs_handle, &t, (int32_t)gs_time_zone * 3600, &ts) != 0)
+    {
+        return 1;
+    }
+    *timestamp = (time_t)ts;
     
     return 0;
 }
@@ -0,0 +1,666 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds3231_scheduler.c
+ * @brief     driver ds3231 scheduler source file
+ * @version   2.0.0
+ * @author    Shifeng Li
+ * @date      2021-03-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2021/03/15  <td>2.0      <td>Shifeng Li  <td>format the code
+ * <tr><td>2020/11/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds3231_scheduler.h"
+
+/**
+ * @brief scheduler example free slot definition
+ */
+#define DS3231_SCHEDULER_NONE        0xFFFFU        /**< slot is not in the heap */
+
+/**
+ * @brief scheduler example timer structure definition
+ */
+typedef struct ds3231_scheduler_timer_s
+{
+    int64_t deadline;                            /**< unix timestamp of the deadline */
+    void (*callback)(uint16_t id, void *arg);    /**< timer callback */
+    void *arg;                                   /**< user argument */
+    uint16_t index;                              /**< position in the heap */
+} ds3231_scheduler_timer_t;
+
+static ds3231_handle_t gs_handle;                                              /**< ds3231 handle */
+static int8_t gs_time_zone = 0;                                                /**< local zone */
+static ds3231_scheduler_timer_t gs_timer[DS3231_SCHEDULER_MAX_TIMERS];         /**< timer slots */
+static uint16_t gs_heap[DS3231_SCHEDULER_MAX_TIMERS];                          /**< min heap of slot ids */
+static uint16_t gs_count = 0;                                                  /**< pending timers */
+static uint16_t gs_free[DS3231_SCHEDULER_MAX_TIMERS];                          /**< free slot stack */
+static uint16_t gs_free_count = 0;                                             /**< free slots */
+static uint8_t gs_armed = 0;                                                   /**< alarm1 armed flag */
+static int64_t gs_armed_deadline = 0;                                          /**< deadline in the alarm1 registers */
+static uint8_t gs_dispatching = 0;                                             /**< dispatch running flag */
+
+/**
+ * @brief     swap two heap entries
+ * @param[in] i first heap position
+ * @param[in] j second heap position
+ * @note      none
+ */
+static void a_ds3231_scheduler_swap(uint16_t i, uint16_t j)
+{
+    uint16_t id;
+    
+    id = gs_heap[i];
+    gs_heap[i] = gs_heap[j];
+    gs_heap[j] = id;
+    gs_timer[gs_heap[i]].index = i;
+    gs_timer[gs_heap[j]].index = j;
+}
+
+/**
+ * @brief     move a heap entry towards the root
+ * @param[in] i heap position
+ * @note      none
+ */
+static void a_ds3231_scheduler_up(uint16_t i)
+{
+    uint16_t parent;
+    
+    while (i > 0)
+    {
+        parent = (uint16_t)((i - 1) / 2);
+        if (gs_timer[gs_heap[parent]].deadline <= gs_timer[gs_heap[i]].deadline)
+        {
+            break;
+        }
+        a_ds3231_scheduler_swap(i, parent);
+        i = parent;
+    }
+}
+
+/**
+ * @brief     move a heap entry towards the leaves
+ * @param[in] i heap position
+ * @note      none
+ */
+static void a_ds3231_scheduler_down(uint16_t i)
+{
+    uint32_t child;
+    uint16_t min;
+    
+    while (1)
+    {
+        min = i;
+        child = (uint32_t)i * 2 + 1;
+        if ((child < gs_count) && (gs_timer[gs_heap[child]].deadline < gs_timer[gs_heap[min]].deadline))
+        {
+            min = (uint16_t)child;
+        }
+        child++;
+        if ((child < gs_count) && (gs_timer[gs_heap[child]].deadline < gs_timer[gs_heap[min]].deadline))
+        {
+            min = (uint16_t)child;
+        }
+        if (min == i)
+        {
+            break;
+        }
+        a_ds3231_scheduler_swap(i, min);
+        i = min;
+    }
+}
+
+/**
+ * @brief     remove a timer from the heap and release its slot
+ * @param[in] id timer id
+ * @note      none
+ */
+static void a_ds3231_scheduler_remove(uint16_t id)
+{
+    uint16_t i;
+    
+    i = gs_timer[id].index;
+    gs_count--;
+    if (i != gs_count)
+    {
+        /* move the last entry into the hole and restore the order */
+        gs_heap[i] = gs_heap[gs_count];
+        gs_timer[gs_heap[i]].index = i;
+        a_ds3231_scheduler_up(i);
+        a_ds3231_scheduler_down(gs_timer[gs_heap[i]].index);
+    }
+    gs_timer[id].index = DS3231_SCHEDULER_NONE;
+    gs_timer[id].callback = NULL;
+    gs_timer[id].arg = NULL;
+    gs_free[gs_free_count] = id;
+    gs_free_count++;
+}
+
+/**
+ * @brief     program alarm1 for the earliest deadline
+ * @param[in] force write the alarm even if it already holds the deadline
+ * @return    status code
+ *            - 0 success
+ *            - 1 arm failed
+ * @note      nothing is written when the alarm already holds the earliest deadline,
+ *            otherwise the date, hour, minute and second are written in one burst
+ */
+static uint8_t a_ds3231_scheduler_arm(uint8_t force)
+{
+    int64_t deadline;
+    ds3231_time_t t;
+    
+    /* no pending timer */
+    if (gs_count == 0)
+    {
+        if (gs_armed != 0)
+        {
+            if (ds3231_set_alarm_interrupt(&gs_handle, DS3231_ALARM_1, DS3231_BOOL_FALSE) != 0)
+            {
+                return 1;
+            }
+            gs_armed = 0;
+        }
+        
+        return 0;
+    }
+    
+    /* the alarm already holds the earliest deadline */
+    deadline = gs_timer[gs_heap[0]].deadline;
+    if ((force == 0) && (gs_armed != 0) && (gs_armed_deadline == deadline))
+    {
+        return 0;
+    }
+    
+    /* write the deadline */
+    if (ds3231_unix_to_time(&gs_handle, deadline, (int32_t)gs_time_zone * 3600, &t) != 0)
+    {
+        return 1;
+    }
+    if (ds3231_set_alarm1(&gs_handle, &t, DS3231_ALARM1_MODE_DATE_HOUR_MINUTE_SECOND_MATCH) != 0)
+    {
+        return 1;
+    }
+    if (gs_armed == 0)
+    {
+        if (ds3231_set_alarm_interrupt(&gs_handle, DS3231_ALARM_1, DS3231_BOOL_TRUE) != 0)
+        {
+            return 1;
+        }
+        gs_armed = 1;
+    }
+    gs_armed_deadline = deadline;
+    
+    return 0;
+}
+
+/**
+ * @brief      read the rtc time
+ * @param[out] *timestamp pointer to a unix timestamp buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+static uint8_t a_ds3231_scheduler_now(int64_t *timestamp)
+{
+    ds3231_time_t t;
+    
+    if (ds3231_get_time(&gs_handle, &t) != 0)
+    {
+        return 1;
+    }
+    if (ds3231_time_to_unix(&gs_handle, &t, (int32_t)gs_time_zone * 3600, timestamp) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  scheduler example init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   the pin is set to the interrupt mode and alarm2 is disabled,
+ *         alarm1 is owned by the scheduler after init, the aging offset stored in the chip is kept,
+ *         add, cancel and dispatch must be called from the same thread
+ */
+uint8_t ds3231_scheduler_init(void)
+{
+    uint8_t res;
+    uint16_t i;
+    
+    /* link functions */
+    DRIVER_DS3231_LINK_INIT(&gs_handle, ds3231_handle_t);
+    DRIVER_DS3231_LINK_IIC_INIT(&gs_handle, ds3231_interface_iic_init);
+    DRIVER_DS3231_LINK_IIC_DEINIT(&gs_handle, ds3231_interface_iic_deinit);
+    DRIVER_DS3231_LINK_IIC_READ(&gs_handle, ds3231_interface_iic_read);
+    DRIVER_DS3231_LINK_IIC_WRITE(&gs_handle, ds3231_interface_iic_write);
+    DRIVER_DS3231_LINK_IIC_TRANSFER(&gs_handle, ds3231_interface_iic_transfer);
+    DRIVER_DS3231_LINK_DELAY_MS(&gs_handle, ds3231_interface_delay_ms);
+    DRIVER_DS3231_LINK_DEBUG_PRINT(&gs_handle, ds3231_interface_debug_print);
+    DRIVER_DS3231_LINK_RECEIVE_CALLBACK(&gs_handle, ds3231_interface_receive_callback);
+    DRIVER_DS3231_LINK_LOCK(&gs_handle, ds3231_interface_lock);
+    DRIVER_DS3231_LINK_UNLOCK(&gs_handle, ds3231_interface_unlock);
+    
+    /* init ds3231 */
+    res = ds3231_init(&gs_handle);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* set oscillator */
+    res = ds3231_set_oscillator(&gs_handle, DS3231_BOOL_TRUE);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: set oscillator failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* set interrupt */
+    res = ds3231_set_pin(&gs_handle, DS3231_PIN_INTERRUPT);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: set pin failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* disable 32khz output */
+    res = ds3231_set_32khz_output(&gs_handle, DS3231_BOOL_FALSE);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: set 32khz output failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* disable alarm1 until the first timer */
+    res = ds3231_set_alarm_interrupt(&gs_handle, DS3231_ALARM_1, DS3231_BOOL_FALSE);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: set alarm1 interrupt failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* disable alarm2 */
+    res = ds3231_set_alarm_interrupt(&gs_handle, DS3231_ALARM_2, DS3231_BOOL_FALSE);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: set alarm2 interrupt failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* clear alarm1 flag */
+    res = ds3231_alarm_clear(&gs_handle, DS3231_ALARM_1);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: alarm clear failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* clear alarm2 flag */
+    res = ds3231_alarm_clear(&gs_handle, DS3231_ALARM_2);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: alarm clear failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* release all slots */
+    for (i = 0; i < DS3231_SCHEDULER_MAX_TIMERS; i++)
+    {
+        gs_timer[i].index = DS3231_SCHEDULER_NONE;
+        gs_timer[i].callback = NULL;
+        gs_timer[i].arg = NULL;
+        gs_free[i] = (uint16_t)(DS3231_SCHEDULER_MAX_TIMERS - 1 - i);
+    }
+    gs_free_count = DS3231_SCHEDULER_MAX_TIMERS;
+    gs_count = 0;
+    gs_armed = 0;
+    gs_dispatching = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief  scheduler example deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   all pending timers are dropped
+ */
+uint8_t ds3231_scheduler_deinit(void)
+{
+    /* drop all timers */
+    gs_count = 0;
+    gs_free_count = 0;
+    if (gs_armed != 0)
+    {
+        (void)ds3231_set_alarm_interrupt(&gs_handle, DS3231_ALARM_1, DS3231_BOOL_FALSE);
+        gs_armed = 0;
+    }
+    
+    if (ds3231_deinit(&gs_handle) != 0)
+    {
+        return 1;
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+/**
+ * @brief  scheduler example irq handler
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   call it from the gpio interrupt, it only clears the alarm flag and
+ *         the timers are run by ds3231_scheduler_dispatch
+ */
+uint8_t ds3231_scheduler_irq_handler(void)
+{
+    if (ds3231_irq_event_handler(&gs_handle, 0) != 0)
+    {
+        return 1;
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+/**
+ * @brief      scheduler example add a timer
+ * @param[in]  timestamp unix timestamp of the deadline
+ * @param[in]  *callback pointer to a timer callback
+ * @param[in]  *arg pointer to a user argument
+ * @param[out] *id pointer to a timer id buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 add failed
+ *             - 2 callback or id is NULL
+ *             - 4 no free timer
+ * @note       the alarm is only written when the timer becomes the earliest one,
+ *             a deadline which is already due is run by the next dispatch
+ */
+uint8_t ds3231_scheduler_add(int64_t timestamp, void (*callback)(uint16_t id, void *arg), void *arg, uint16_t *id)
+{
+    ds3231_time_t t;
+    uint16_t slot;
+    
+    if ((callback == NULL) || (id == NULL))
+    {
+        return 2;
+    }
+    if (gs_free_count == 0)
+    {
+        return 4;
+    }
+    
+    /* the deadline must fit in the rtc calendar */
+    if (ds3231_unix_to_time(&gs_handle, timestamp, (int32_t)gs_time_zone * 3600, &t) != 0)
+    {
+        return 1;
+    }
+    
+    /* push the timer */
+    gs_free_count--;
+    slot = gs_free[gs_free_count];
+    gs_timer[slot].deadline = timestamp;
+    gs_timer[slot].callback = callback;
+    gs_timer[slot].arg = arg;
+    gs_timer[slot].index = gs_count;
+    gs_heap[gs_count] = slot;
+    gs_count++;
+    a_ds3231_scheduler_up(gs_timer[slot].index);
+    *id = slot;
+    
+    /* the dispatch arms the alarm once all callbacks have run */
+    if (gs_dispatching != 0)
+    {
+        return 0;
+    }
+    if (a_ds3231_scheduler_arm(0) != 0)
+    {
+        ds3231_interface_debug_print("ds3231: arm alarm1 failed.\n");
+        a_ds3231_scheduler_remove(slot);
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     scheduler example cancel a timer
+ * @param[in] id timer id
+ * @return    status code
+ *            - 0 success
+ *            - 1 cancel failed
+ *            - 4 timer is not pending
+ * @note      none
+ */
+uint8_t ds3231_scheduler_cancel(uint16_t id)
+{
+    if ((id >= DS3231_SCHEDULER_MAX_TIMERS) || (gs_timer[id].index == DS3231_SCHEDULER_NONE))
+    {
+        return 4;
+    }
+    
+    /* pop the timer */
+    a_ds3231_scheduler_remove(id);
+    
+    /* the dispatch arms the alarm once all callbacks have run */
+    if (gs_dispatching != 0)
+    {
+        return 0;
+    }
+    if (a_ds3231_scheduler_arm(0) != 0)
+    {
+        ds3231_interface_debug_print("ds3231: arm alarm1 failed.\n");
+        
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      scheduler example run all expired timers
+ * @param[out] *fired pointer to a fired timers number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 dispatch failed
+ * @note       call it from the application after the irq or after the host resumes,
+ *             callbacks may add or cancel timers but must not call the dispatch again
+ */
+uint8_t ds3231_scheduler_dispatch(uint16_t *fired)
+{
+    ds3231_event_t events[DS3231_EVENT_QUEUE_SIZE];
+    void (*callback)(uint16_t id, void *arg);
+    void *arg;
+    int64_t now;
+    uint32_t count;
+    uint16_t id;
+    uint16_t num;
+    
+    /* clear the flag when no irq has been served and drop the queued events */
+    if (ds3231_irq_event_handler(&gs_handle, 0) != 0)
+    {
+        return 1;
+    }
+    do
+    {
+        if (ds3231_get_events(&gs_handle, events, DS3231_EVENT_QUEUE_SIZE, &count) != 0)
+        {
+            return 1;
+        }
+    } while (count != 0);
+    
+    /* one rtc read covers every timer due at the same second */
+    if (a_ds3231_scheduler_now(&now) != 0)
+    {
+        return 1;
+    }
+    num = 0;
+    gs_dispatching = 1;
+    while (1)
+    {
+        /* run all expired timers */
+        while ((gs_count != 0) && (gs_timer[gs_heap[0]].deadline <= now))
+        {
+            id = gs_heap[0];
+            callback = gs_timer[id].callback;
+            arg = gs_timer[id].arg;
+            a_ds3231_scheduler_remove(id);
+            callback(id, arg);
+            num++;
+        }
+        
+        /* program the next deadline */
+        if (a_ds3231_scheduler_arm(0) != 0)
+        {
+            gs_dispatching = 0;
+            ds3231_interface_debug_print("ds3231: arm alarm1 failed.\n");
+            
+            return 1;
+        }
+        
+        /* the alarm only matches the exact second, so check the clock again when the deadline is close */
+        if ((gs_count == 0) || (gs_timer[gs_heap[0]].deadline > now + 1))
+        {
+            break;
+        }
+        if (a_ds3231_scheduler_now(&now) != 0)
+        {
+            gs_dispatching = 0;
+            
+            return 1;
+        }
+        if (gs_timer[gs_heap[0]].deadline > now)
+        {
+            break;
+        }
+    }
+    gs_dispatching = 0;
+    if (fired != NULL)
+    {
+        *fired = num;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      scheduler example get the earliest deadline
+ * @param[out] *timestamp pointer to a unix timestamp buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no pending timer
+ * @note       none
+ */
+uint8_t ds3231_scheduler_get_next(int64_t *timestamp)
+{
+    if (gs_count == 0)
+    {
+        return 1;
+    }
+    *timestamp = gs_timer[gs_heap[0]].deadline;
+    
+    return 0;
+}
+
+/**
+ * @brief      scheduler example get the current time
+ * @param[out] *timestamp pointer to a unix timestamp buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get time failed
+ * @note       deadlines use the same time base
+ */
+uint8_t ds3231_scheduler_get_timestamp(int64_t *timestamp)
+{
+    if (a_ds3231_scheduler_now(timestamp) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     scheduler example set the local time zone
+ * @param[in] zone local time zone
+ * @return    status code
+ *            - 0 success
+ * @note      the zone must match the zone of the rtc time
+ */
+uint8_t ds3231_scheduler_set_time_zone(int8_t zone)
+{
+    gs_time_zone = zone;
+    
+    /* the alarm registers hold the local time */
+    if (gs_armed != 0)
+    {
+        (void)a_ds3231_scheduler_arm(1);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      scheduler example get the local time zone
+ * @param[out] *zone pointer to a local time zone buffer
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+uint8_t ds3231_scheduler_get_time_zone(int8_t *zone)
+{
+    *zone = gs_time_zone;
+    
+    return 0;
+}
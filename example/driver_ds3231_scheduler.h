@@ -0,0 +1,173 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds3231_scheduler.h
+ * @brief     driver ds3231 scheduler header file
+ * @version   2.0.0
+ * @author    Shifeng Li
+ * @date      2021-03-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2021/03/15  <td>2.0      <td>Shifeng Li  <td>format the code
+ * <tr><td>2020/11/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+  
+#ifndef DRIVER_DS3231_SCHEDULER_H
+#define DRIVER_DS3231_SCHEDULER_H
+
+#include "driver_ds3231_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup ds3231_example_driver
+ * @{
+ */
+
+/**
+ * @brief ds3231 scheduler example max timers definition
+ */
+#ifndef DS3231_SCHEDULER_MAX_TIMERS
+    #define DS3231_SCHEDULER_MAX_TIMERS        256        /**< 256 timers */
+#endif
+
+/**
+ * @brief  scheduler example init
+ * @return status code
+ *         - 0 success
+ *         - 1 init failed
+ * @note   the pin is set to the interrupt mode and alarm2 is disabled,
+ *         alarm1 is owned by the scheduler after init, the aging offset stored in the chip is kept,
+ *         add, cancel and dispatch must be called from the same thread
+ */
+uint8_t ds3231_scheduler_init(void);
+
+/**
+ * @brief  scheduler example deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   all pending timers are dropped
+ */
+uint8_t ds3231_scheduler_deinit(void);
+
+/**
+ * @brief  scheduler example irq handler
+ * @return status code
+ *         - 0 success
+ *         - 1 run failed
+ * @note   call it from the gpio interrupt, it only clears the alarm flag and
+ *         the timers are run by ds3231_scheduler_dispatch
+ */
+uint8_t ds3231_scheduler_irq_handler(void);
+
+/**
+ * @brief      scheduler example add a timer
+ * @param[in]  timestamp unix timestamp of the deadline
+ * @param[in]  *callback pointer to a timer callback
+ * @param[in]  *arg pointer to a user argument
+ * @param[out] *id pointer to a timer id buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 add failed
+ *             - 2 callback or id is NULL
+ *             - 4 no free timer
+ * @note       the alarm is only written when the timer becomes the earliest one,
+ *             a deadline which is already due is run by the next dispatch
+ */
+uint8_t ds3231_scheduler_add(int64_t timestamp, void (*callback)(uint16_t id, void *arg), void *arg, uint16_t *id);
+
+/**
+ * @brief     scheduler example cancel a timer
+ * @param[in] id timer id
+ * @return    status code
+ *            - 0 success
+ *            - 1 cancel failed
+ *            - 4 timer is not pending
+ * @note      none
+ */
+uint8_t ds3231_scheduler_cancel(uint16_t id);
+
+/**
+ * @brief      scheduler example run all expired timers
+ * @param[out] *fired pointer to a fired timers number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 dispatch failed
+ * @note       call it from the application after the irq or after the host resumes,
+ *             callbacks may add or cancel timers but must not call the dispatch again
+ */
+uint8_t ds3231_scheduler_dispatch(uint16_t *fired);
+
+/**
+ * @brief      scheduler example get the earliest deadline
+ * @param[out] *timestamp pointer to a unix timestamp buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 no pending timer
+ * @note       none
+ */
+uint8_t ds3231_scheduler_get_next(int64_t *timestamp);
+
+/**
+ * @brief      scheduler example get the current time
+ * @param[out] *timestamp pointer to a unix timestamp buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get time failed
+ * @note       deadlines use the same time base
+ */
+uint8_t ds3231_scheduler_get_timestamp(int64_t *timestamp);
+
+/**
+ * @brief     scheduler example set the local time zone
+ * @param[in] zone local time zone
+ * @return    status code
+ *            - 0 success
+ * @note      the zone must match the zone of the rtc time
+ */
+uint8_t ds3231_scheduler_set_time_zone(int8_t zone);
+
+/**
+ * @brief      scheduler example get the local time zone
+ * @param[out] *zone pointer to a local time zone buffer
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+uint8_t ds3231_scheduler_get_time_zone(int8_t *zone);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
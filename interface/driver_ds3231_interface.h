@@ -51,6 +51,17 @@ extern "C"{
  * @{
  */
 
+/**
+ * @brief ds3231 interface context structure definition
+ */
+typedef struct ds3231_interface_ctx_s
+{
+    uint8_t bus;                /**< iic bus number */
+    uint8_t mux_addr;           /**< iic mux write address, 0 means no mux */
+    uint8_t mux_channel;        /**< iic mux channel */
+    int32_t fd;                 /**< iic bus handle, managed by the interface */
+} ds3231_interface_ctx_t;
+
 /**
  * @brief  interface iic bus init
  * @return status code
@@ -95,6 +106,79 @@ uint8_t ds3231_interface_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint1
  */
 uint8_t ds3231_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
 
+/**
+ * @brief     interface iic bus init with a context
+ * @param[in] *ctx pointer to a ds3231 interface context structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic init failed
+ * @note      none
+ */
+uint8_t ds3231_interface_iic_init_ctx(void *ctx);
+
+/**
+ * @brief     interface iic bus deinit with a context
+ * @param[in] *ctx pointer to a ds3231 interface context structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic deinit failed
+ * @note      none
+ */
+uint8_t ds3231_interface_iic_deinit_ctx(void *ctx);
+
+/**
+ * @brief      interface iic bus read with a context
+ * @param[in]  *ctx pointer to a ds3231 interface context structure
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t ds3231_interface_iic_read_ctx(void *ctx, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     interface iic bus write with a context
+ * @param[in] *ctx pointer to a ds3231 interface context structure
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t ds3231_interface_iic_write_ctx(void *ctx, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     interface iic bus transfer
+ * @param[in] addr iic device write address
+ * @param[in] *msg pointer to a message list
+ * @param[in] num message number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      none
+ */
+uint8_t ds3231_interface_iic_transfer(uint8_t addr, ds3231_iic_msg_t *msg, uint8_t num);
+
+/**
+ * @brief     interface iic bus transfer with a context
+ * @param[in] *ctx pointer to a ds3231 interface context structure
+ * @param[in] addr iic device write address
+ * @param[in] *msg pointer to a message list
+ * @param[in] num message number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      none
+ */
+uint8_t ds3231_interface_iic_transfer_ctx(void *ctx, uint8_t addr, ds3231_iic_msg_t *msg, uint8_t num);
+
 /**
  * @brief     interface delay ms
  * @param[in] ms time
@@ -109,6 +193,29 @@ void ds3231_interface_delay_ms(uint32_t ms);
  */
 void ds3231_interface_debug_print(const char *const fmt, ...);
 
+/**
+ * @brief     interface lock
+ * @param[in] *ctx pointer to a lock context
+ * @param[in] type lock type
+ * @note      none
+ */
+void ds3231_interface_lock(void *ctx, ds3231_lock_t type);
+
+/**
+ * @brief     interface unlock
+ * @param[in] *ctx pointer to a lock context
+ * @param[in] type lock type
+ * @note      none
+ */
+void ds3231_interface_unlock(void *ctx, ds3231_lock_t type);
+
+/**
+ * @brief  interface timestamp
+ * @return monotonic timestamp in us
+ * @note   it is only used by the stats build for the latency histograms
+ */
+uint64_t ds3231_interface_timestamp_us(void);
+
 /**
  * @brief     interface receive callback
  * @param[in] type interrupt type
@@ -116,6 +223,14 @@ void ds3231_interface_debug_print(const char *const fmt, ...);
  */
 void ds3231_interface_receive_callback(uint8_t type);
 
+/**
+ * @brief     interface receive callback with a context
+ * @param[in] *ctx pointer to a ds3231 interface context structure
+ * @param[in] type interrupt type
+ * @note      none
+ */
+void ds3231_interface_receive_callback_ctx(void *ctx, uint8_t type);
+
 /**
  * @}
  */
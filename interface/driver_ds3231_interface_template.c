@@ -93,6 +93,97 @@ uint8_t ds3231_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint
     return 0;
 }
 
+/**
+ * @brief     interface iic bus init with a context
+ * @param[in] *ctx pointer to a ds3231 interface context structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic init failed
+ * @note      none
+ */
+uint8_t ds3231_interface_iic_init_ctx(void *ctx)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface iic bus deinit with a context
+ * @param[in] *ctx pointer to a ds3231 interface context structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic deinit failed
+ * @note      none
+ */
+uint8_t ds3231_interface_iic_deinit_ctx(void *ctx)
+{
+    return 0;
+}
+
+/**
+ * @brief      interface iic bus read with a context
+ * @param[in]  *ctx pointer to a ds3231 interface context structure
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t ds3231_interface_iic_read_ctx(void *ctx, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface iic bus write with a context
+ * @param[in] *ctx pointer to a ds3231 interface context structure
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t ds3231_interface_iic_write_ctx(void *ctx, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface iic bus transfer
+ * @param[in] addr iic device write address
+ * @param[in] *msg pointer to a message list
+ * @param[in] num message number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      none
+ */
+uint8_t ds3231_interface_iic_transfer(uint8_t addr, ds3231_iic_msg_t *msg, uint8_t num)
+{
+    return 0;
+}
+
+/**
+ * @brief     interface iic bus transfer with a context
+ * @param[in] *ctx pointer to a ds3231 interface context structure
+ * @param[in] addr iic device write address
+ * @param[in] *msg pointer to a message list
+ * @param[in] num message number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      none
+ */
+uint8_t ds3231_interface_iic_transfer_ctx(void *ctx, uint8_t addr, ds3231_iic_msg_t *msg, uint8_t num)
+{
+    return 0;
+}
+
 /**
  * @brief     interface delay ms
  * @param[in] ms time
@@ -113,6 +204,38 @@ void ds3231_interface_debug_print(const char *const fmt, ...)
     
 }
 
+/**
+ * @brief     interface lock
+ * @param[in] *ctx pointer to a lock context
+ * @param[in] type lock type
+ * @note      none
+ */
+void ds3231_interface_lock(void *ctx, ds3231_lock_t type)
+{
+    
+}
+
+/**
+ * @brief     interface unlock
+ * @param[in] *ctx pointer to a lock context
+ * @param[in] type lock type
+ * @note      none
+ */
+void ds3231_interface_unlock(void *ctx, ds3231_lock_t type)
+{
+    
+}
+
+/**
+ * @brief  interface timestamp
+ * @return monotonic timestamp in us
+ * @note   it is only used by the stats build for the latency histograms
+ */
+uint64_t ds3231_interface_timestamp_us(void)
+{
+    return 0;
+}
+
 /**
  * @brief     interface receive callback
  * @param[in] type interrupt type
@@ -140,3 +263,34 @@ void ds3231_interface_receive_callback(uint8_t type)
         }
     }
 }
+
+/**
+ * @brief     interface receive callback with a context
+ * @param[in] *ctx pointer to a ds3231 interface context structure
+ * @param[in] type interrupt type
+ * @note      none
+ */
+void ds3231_interface_receive_callback_ctx(void *ctx, uint8_t type)
+{
+    ds3231_interface_ctx_t *c = (ds3231_interface_ctx_t *)ctx;
+    
+    switch (type)
+    {
+        case DS3231_STATUS_ALARM_2 :
+        {
+            ds3231_interface_debug_print("ds3231: bus %d irq alarm2.\n", c->bus);
+            
+            break;
+        }
+        case DS3231_STATUS_ALARM_1 :
+        {
+            ds3231_interface_debug_print("ds3231: bus %d irq alarm1.\n", c->bus);
+            
+            break;
+        }
+        default :
+        {
+            break;
+        }
+    }
+}
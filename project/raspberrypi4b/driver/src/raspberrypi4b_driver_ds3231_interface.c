@@ -37,7 +37,10 @@
 
 #include "driver_ds3231_interface.h"
 #include "iic.h"
+#include "gpio.h"
 #include <stdarg.h>
+#include <pthread.h>
+#include <time.h>
 
 /**
  * @brief iic device name definition
@@ -49,16 +52,54 @@
  */
 static int gs_fd;                           /**< iic handle */
 
+/**
+ * @brief default lock definition
+ */
+static pthread_rwlock_t gs_lock = PTHREAD_RWLOCK_INITIALIZER;        /**< lock used when no context is given */
+
+/**
+ * @brief bus lock definition
+ */
+#define IIC_BUS_LOCK_NUM 4        /**< bus locks, buses with the same remainder share one */
+static pthread_mutex_t gs_bus_lock[IIC_BUS_LOCK_NUM] =
+{
+    PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER,
+    PTHREAD_MUTEX_INITIALIZER, PTHREAD_MUTEX_INITIALIZER,
+};                                /**< mux select locks */
+
+/**
+ * @brief     iic bus recovery hook
+ * @param[in] fd iic handle of the failed transfer
+ * @return    status code
+ *            - 0 success
+ *            - 1 recovery failed
+ * @note      only the default bus is wired to the recovery lines
+ */
+static uint8_t a_iic_recovery(int fd)
+{
+    if (fd != gs_fd)
+    {
+        return 1;
+    }
+    
+    return gpio_iic_bus_recovery();
+}
+
 /**
  * @brief  interface iic bus init
  * @return status code
  *         - 0 success
  *         - 1 iic init failed
- * @note   none
+ * @note   transient bus errors are retried by the iic layer and a stuck bus is recovered
  */
 uint8_t ds3231_interface_iic_init(void)
 {
-    return iic_init(IIC_DEVICE_NAME, &gs_fd);
+    if (iic_init(IIC_DEVICE_NAME, &gs_fd) != 0)
+    {
+        return 1;
+    }
+    
+    return iic_set_recovery(a_iic_recovery);
 }
 
 /**
@@ -70,6 +111,8 @@ uint8_t ds3231_interface_iic_init(void)
  */
 uint8_t ds3231_interface_iic_deinit(void)
 {
+    (void)iic_set_recovery(NULL);
+    
     return iic_deinit(gs_fd);
 }
 
@@ -105,6 +148,229 @@ uint8_t ds3231_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint
     return iic_write(gs_fd, addr, reg, buf, len);
 }
 
+/**
+ * @brief     lock the bus of a context
+ * @param[in] *c pointer to a ds3231 interface context structure
+ * @note      only a context behind a mux takes the lock, the mux channel takes effect after the stop
+ *            condition so the select and the access can not be merged into one transfer
+ */
+static void a_iic_bus_lock(ds3231_interface_ctx_t *c)
+{
+    if (c->mux_addr != 0)
+    {
+        (void)pthread_mutex_lock(&gs_bus_lock[c->bus % IIC_BUS_LOCK_NUM]);
+    }
+}
+
+/**
+ * @brief     unlock the bus of a context
+ * @param[in] *c pointer to a ds3231 interface context structure
+ * @note      none
+ */
+static void a_iic_bus_unlock(ds3231_interface_ctx_t *c)
+{
+    if (c->mux_addr != 0)
+    {
+        (void)pthread_mutex_unlock(&gs_bus_lock[c->bus % IIC_BUS_LOCK_NUM]);
+    }
+}
+
+/**
+ * @brief     select the mux channel of a context
+ * @param[in] *c pointer to a ds3231 interface context structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 select failed
+ * @note      the bus lock must be held until the access after the select is done
+ */
+static uint8_t a_iic_select(ds3231_interface_ctx_t *c)
+{
+    uint8_t channel;
+    
+    /* no mux */
+    if (c->mux_addr == 0)
+    {
+        return 0;
+    }
+    
+    /* enable only this channel */
+    channel = (uint8_t)(1 << c->mux_channel);
+    
+    return iic_write_cmd(c->fd, c->mux_addr, &channel, 1);
+}
+
+/**
+ * @brief     interface iic bus init with a context
+ * @param[in] *ctx pointer to a ds3231 interface context structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic init failed
+ * @note      none
+ */
+uint8_t ds3231_interface_iic_init_ctx(void *ctx)
+{
+    ds3231_interface_ctx_t *c = (ds3231_interface_ctx_t *)ctx;
+    char name[32];
+    int fd;
+    
+    /* open the bus of this context */
+    (void)snprintf(name, 32, "/dev/i2c-%d", c->bus);
+    if (iic_init(name, &fd) != 0)
+    {
+        return 1;
+    }
+    c->fd = fd;
+    
+    return 0;
+}
+
+/**
+ * @brief     interface iic bus deinit with a context
+ * @param[in] *ctx pointer to a ds3231 interface context structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic deinit failed
+ * @note      none
+ */
+uint8_t ds3231_interface_iic_deinit_ctx(void *ctx)
+{
+    ds3231_interface_ctx_t *c = (ds3231_interface_ctx_t *)ctx;
+    
+    return iic_deinit(c->fd);
+}
+
+/**
+ * @brief      interface iic bus read with a context
+ * @param[in]  *ctx pointer to a ds3231 interface context structure
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t ds3231_interface_iic_read_ctx(void *ctx, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    ds3231_interface_ctx_t *c = (ds3231_interface_ctx_t *)ctx;
+    uint8_t res;
+    
+    /* keep the channel selected until the access is done */
+    a_iic_bus_lock(c);
+    res = a_iic_select(c);
+    if (res == 0)
+    {
+        res = iic_read(c->fd, addr, reg, buf, len);
+    }
+    a_iic_bus_unlock(c);
+    
+    return res;
+}
+
+/**
+ * @brief     interface iic bus write with a context
+ * @param[in] *ctx pointer to a ds3231 interface context structure
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t ds3231_interface_iic_write_ctx(void *ctx, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    ds3231_interface_ctx_t *c = (ds3231_interface_ctx_t *)ctx;
+    uint8_t res;
+    
+    /* keep the channel selected until the access is done */
+    a_iic_bus_lock(c);
+    res = a_iic_select(c);
+    if (res == 0)
+    {
+        res = iic_write(c->fd, addr, reg, buf, len);
+    }
+    a_iic_bus_unlock(c);
+    
+    return res;
+}
+
+/**
+ * @brief     send a message list in one ioctl
+ * @param[in] fd iic handle
+ * @param[in] addr iic device write address
+ * @param[in] *msg pointer to a message list
+ * @param[in] num message number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      none
+ */
+static uint8_t a_iic_transfer(int fd, uint8_t addr, ds3231_iic_msg_t *msg, uint8_t num)
+{
+    iic_transfer_t transfer[DS3231_TRANSACTION_MAX_MSG];
+    uint8_t i;
+    
+    if (num > DS3231_TRANSACTION_MAX_MSG)
+    {
+        return 1;
+    }
+    for (i = 0; i < num; i++)
+    {
+        transfer[i].reg = msg[i].reg;
+        transfer[i].read = msg[i].read;
+        transfer[i].buf = msg[i].buf;
+        transfer[i].len = msg[i].len;
+    }
+    
+    return iic_transfer(fd, addr, transfer, num);
+}
+
+/**
+ * @brief     interface iic bus transfer
+ * @param[in] addr iic device write address
+ * @param[in] *msg pointer to a message list
+ * @param[in] num message number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      none
+ */
+uint8_t ds3231_interface_iic_transfer(uint8_t addr, ds3231_iic_msg_t *msg, uint8_t num)
+{
+    return a_iic_transfer(gs_fd, addr, msg, num);
+}
+
+/**
+ * @brief     interface iic bus transfer with a context
+ * @param[in] *ctx pointer to a ds3231 interface context structure
+ * @param[in] addr iic device write address
+ * @param[in] *msg pointer to a message list
+ * @param[in] num message number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      none
+ */
+uint8_t ds3231_interface_iic_transfer_ctx(void *ctx, uint8_t addr, ds3231_iic_msg_t *msg, uint8_t num)
+{
+    ds3231_interface_ctx_t *c = (ds3231_interface_ctx_t *)ctx;
+    uint8_t res;
+    
+    /* keep the channel selected until the access is done */
+    a_iic_bus_lock(c);
+    res = a_iic_select(c);
+    if (res == 0)
+    {
+        res = a_iic_transfer(c->fd, addr, msg, num);
+    }
+    a_iic_bus_unlock(c);
+    
+    return res;
+}
+
 /**
  * @brief     interface delay ms
  * @param[in] ms time
@@ -133,6 +399,54 @@ void ds3231_interface_debug_print(const char *const fmt, ...)
     (void)printf((uint8_t *)str);
 }
 
+/**
+ * @brief     interface lock
+ * @param[in] *ctx pointer to a lock context
+ * @param[in] type lock type
+ * @note      none
+ */
+void ds3231_interface_lock(void *ctx, ds3231_lock_t type)
+{
+    pthread_rwlock_t *lock = (ctx != NULL) ? (pthread_rwlock_t *)ctx : &gs_lock;
+    
+    if (type == DS3231_LOCK_READ)
+    {
+        (void)pthread_rwlock_rdlock(lock);
+    }
+    else
+    {
+        (void)pthread_rwlock_wrlock(lock);
+    }
+}
+
+/**
+ * @brief     interface unlock
+ * @param[in] *ctx pointer to a lock context
+ * @param[in] type lock type
+ * @note      none
+ */
+void ds3231_interface_unlock(void *ctx, ds3231_lock_t type)
+{
+    pthread_rwlock_t *lock = (ctx != NULL) ? (pthread_rwlock_t *)ctx : &gs_lock;
+    
+    (void)type;
+    (void)pthread_rwlock_unlock(lock);
+}
+
+/**
+ * @brief  interface timestamp
+ * @return monotonic timestamp in us
+ * @note   it is only used by the stats build for the latency histograms
+ */
+uint64_t ds3231_interface_timestamp_us(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+}
+
 /**
  * @brief     interface receive callback
  * @param[in] type interrupt type
@@ -160,3 +474,34 @@ void ds3231_interface_receive_callback(uint8_t type)
         }
     }
 }
+
+/**
+ * @brief     interface receive callback with a context
+ * @param[in] *ctx pointer to a ds3231 interface context structure
+ * @param[in] type interrupt type
+ * @note      none
+ */
+void ds3231_interface_receive_callback_ctx(void *ctx, uint8_t type)
+{
+    ds3231_interface_ctx_t *c = (ds3231_interface_ctx_t *)ctx;
+    
+    switch (type)
+    {
+        case DS3231_STATUS_ALARM_2 :
+        {
+            ds3231_interface_debug_print("ds3231: bus %d irq alarm2.\n", c->bus);
+            
+            break;
+        }
+        case DS3231_STATUS_ALARM_1 :
+        {
+            ds3231_interface_debug_print("ds3231: bus %d irq alarm1.\n", c->bus);
+            
+            break;
+        }
+        default :
+        {
+            break;
+        }
+    }
+}
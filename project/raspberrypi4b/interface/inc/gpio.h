@@ -69,6 +69,48 @@ uint8_t gpio_interrupt_init(void);
  */
 uint8_t gpio_interrupt_deinit(void);
 
+/**
+ * @brief      gpio interrupt event init
+ * @param[out] *fd pointer to a line fd buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 init failed
+ * @note       no pthread is created, add the fd to the poll or epoll set of the application
+ *             and call gpio_interrupt_event_handler when it is readable
+ */
+uint8_t gpio_interrupt_event_init(int *fd);
+
+/**
+ * @brief      gpio interrupt event handler
+ * @param[out] *count pointer to a falling edge number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       all queued events are drained and the irq runs once when at least one falling edge is found,
+ *             g_gpio_irq_edge gets the kernel CLOCK_MONOTONIC timestamp of the last falling edge and is used instead of
+ *             g_gpio_irq when it is set
+ */
+uint8_t gpio_interrupt_event_handler(uint32_t *count);
+
+/**
+ * @brief  gpio interrupt event deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t gpio_interrupt_event_deinit(void);
+
+/**
+ * @brief  gpio iic bus recovery
+ * @return status code
+ *         - 0 success
+ *         - 1 recovery failed
+ * @note   up to 9 clocks are sent on scl until the slave releases sda, then a stop is sent,
+ *         the lines are given back to the iic controller at the end,
+ *         nothing is touched when sda is already high, so the other users of the bus are not disturbed
+ */
+uint8_t gpio_iic_bus_recovery(void);
+
 /**
  * @}
  */
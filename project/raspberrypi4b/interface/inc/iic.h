@@ -53,6 +53,31 @@ extern "C" {
  * @{
  */
 
+/**
+ * @brief iic transfer structure definition
+ */
+typedef struct iic_transfer_s
+{
+    uint8_t reg;         /**< register address */
+    uint8_t read;        /**< 1 for a read and 0 for a write */
+    uint8_t *buf;        /**< data buffer */
+    uint16_t len;        /**< data buffer length */
+} iic_transfer_t;
+
+/**
+ * @brief iic error structure definition
+ */
+typedef struct iic_error_s
+{
+    volatile uint32_t nack;            /**< no acknowledge, EREMOTEIO or ENXIO */
+    volatile uint32_t busy;            /**< arbitration lost, EAGAIN */
+    volatile uint32_t timeout;         /**< bus timeout, ETIMEDOUT */
+    volatile uint32_t other;           /**< errors which are not retried */
+    volatile uint32_t retry;           /**< retried transfers */
+    volatile uint32_t recovery;        /**< bus recoveries */
+    volatile uint32_t failed;          /**< transfers failed after all retries */
+} iic_error_t;
+
 /**
  * @brief      iic bus init
  * @param[in]  *name pointer to an iic device name buffer
@@ -156,6 +181,46 @@ uint8_t iic_write(int fd, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
  */
 uint8_t iic_write_address16(int fd, uint8_t addr, uint16_t reg, uint8_t *buf, uint16_t len);
 
+/**
+ * @brief     iic bus transfer
+ * @param[in] fd iic handle
+ * @param[in] addr iic device write address
+ * @param[in] *transfer pointer to a transfer list
+ * @param[in] num transfer number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      addr = device_address_7bits << 1,
+ *            all transfers are sent in one I2C_RDWR ioctl, a read takes two messages and a write takes one
+ */
+uint8_t iic_transfer(int fd, uint8_t addr, iic_transfer_t *transfer, uint8_t num);
+
+/**
+ * @brief     iic bus set the recovery hook
+ * @param[in] *recovery pointer to a bus recovery function
+ * @return    status code
+ *            - 0 success
+ * @note      NULL disables the recovery
+ */
+uint8_t iic_set_recovery(uint8_t (*recovery)(int fd));
+
+/**
+ * @brief      iic bus get the error counters
+ * @param[out] *error pointer to an iic error structure
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+uint8_t iic_get_error(iic_error_t *error);
+
+/**
+ * @brief  iic bus clear the error counters
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t iic_clear_error(void);
+
 /**
  * @}
  */
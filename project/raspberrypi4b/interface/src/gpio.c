@@ -37,6 +37,11 @@
 #include "gpio.h"
 #include <gpiod.h>
 #include <pthread.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
 
 /**
  * @brief gpio device name definition
@@ -48,13 +53,82 @@
  */
 #define GPIO_DEVICE_LINE 17                      /**< gpio device line */
 
+/**
+ * @brief gpio iic recovery definition
+ */
+#define GPIO_IIC_SDA_LINE    2                   /**< iic1 sda line */
+#define GPIO_IIC_SCL_LINE    3                   /**< iic1 scl line */
+#define GPIO_IIC_CLOCK_US    5                   /**< half period of the recovery clock */
+#define GPIO_MEMORY_NAME     "/dev/gpiomem"      /**< gpio register device name */
+
+/**
+ * @brief gpio event batch definition
+ */
+#define GPIO_EVENT_BATCH 16                      /**< events read at once */
+
 /**
  * @brief global var definition
  */
-static struct gpiod_chip *gs_chip;        /**< gpio chip handle */
-static struct gpiod_line *gs_line;        /**< gpio line handle */
-static pthread_t gs_pid;                  /**< gpio pthread pid */
-extern uint8_t (*g_gpio_irq)(void);       /**< gpio irq */
+static struct gpiod_chip *gs_chip;                               /**< gpio chip handle */
+static struct gpiod_line *gs_line;                               /**< gpio line handle */
+static pthread_t gs_pid;                                         /**< gpio pthread pid */
+static int gs_stop_fd = -1;                                      /**< gpio pthread stop event */
+extern uint8_t (*g_gpio_irq)(void);                              /**< gpio irq */
+extern uint8_t (*g_gpio_irq_edge)(uint64_t timestamp_ns);        /**< gpio irq with the edge timestamp */
+
+/**
+ * @brief  gpio open the line
+ * @return status code
+ *         - 0 success
+ *         - 1 open failed
+ * @note   the line fd is non-blocking so that a batch read stops at the last event
+ */
+static uint8_t a_gpio_open(void)
+{
+    int fd;
+    int flags;
+    
+    /* open the gpio group */
+    gs_chip = gpiod_chip_open(GPIO_DEVICE_NAME);
+    if (gs_chip == NULL)
+    {
+        perror("gpio: open failed.\n");
+
+        return 1;
+    }
+    
+    /* get the gpio line */
+    gs_line = gpiod_chip_get_line(gs_chip, GPIO_DEVICE_LINE);
+    if (gs_line == NULL) 
+    {
+        perror("gpio: get line failed.\n");
+        gpiod_chip_close(gs_chip);
+
+        return 1;
+    }
+
+    /* catch the falling edge */
+    if (gpiod_line_request_falling_edge_events(gs_line, "gpiointerrupt") < 0)
+    {
+        perror("gpio: set edge events failed.\n");
+        gpiod_chip_close(gs_chip);
+
+        return 1;
+    }
+    
+    /* set non-blocking */
+    fd = gpiod_line_event_get_fd(gs_line);
+    flags = fcntl(fd, F_GETFL);
+    if ((flags < 0) || (fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0))
+    {
+        perror("gpio: set non-blocking failed.\n");
+        gpiod_chip_close(gs_chip);
+
+        return 1;
+    }
+    
+    return 0;
+}
 
 /**
  * @brief  gpio interrupt pthread
@@ -65,39 +139,46 @@ extern uint8_t (*g_gpio_irq)(void);       /**< gpio irq */
 static void *a_gpio_interrupt_pthread(void *p)
 {
     int res;
-    struct gpiod_line_event event;
+    uint32_t count;
+    struct pollfd fds[2];
     
-    /* enable catching cancel signal */
-    pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, NULL);
-
-    /* cancel the pthread at once */
-    pthread_setcanceltype(PTHREAD_CANCEL_ASYNCHRONOUS, NULL);
+    (void)p;
+    
+    /* wait for the line and the stop event */
+    fds[0].fd = gpiod_line_event_get_fd(gs_line);
+    fds[0].events = POLLIN;
+    fds[1].fd = gs_stop_fd;
+    fds[1].events = POLLIN;
 
     /* loop */
     while (1)
     {
         /* wait for the event */
-        res = gpiod_line_event_wait(gs_line, NULL);
-        if (res == 1)
+        res = poll(fds, 2, -1);
+        if (res < 0)
         {
-            /* read the event */
-            if (gpiod_line_event_read(gs_line, &event) != 0)
+            if (errno == EINTR)
             {
                 continue;
             }
-
-            /* if the falling edge */
-            if (event.event_type == GPIOD_LINE_EVENT_FALLING_EDGE)
-            {
-                /* check the g_gpio_irq */
-                if (g_gpio_irq != NULL)
-                {
-                    /* run the callback */
-                    g_gpio_irq();
-                }
-            }
+            
+            break;
+        }
+        
+        /* stop request */
+        if (fds[1].revents != 0)
+        {
+            break;
+        }
+        
+        /* run the irq once for all queued edges */
+        if ((fds[0].revents & POLLIN) != 0)
+        {
+            (void)gpio_interrupt_event_handler(&count);
         }
     }
+    
+    return NULL;
 }
 
 /**
@@ -111,29 +192,18 @@ uint8_t gpio_interrupt_init(void)
 {
     uint8_t res;
     
-    /* open the gpio group */
-    gs_chip = gpiod_chip_open(GPIO_DEVICE_NAME);
-    if (gs_chip == NULL)
+    /* open the line */
+    res = a_gpio_open();
+    if (res != 0)
     {
-        perror("gpio: open failed.\n");
-
         return 1;
     }
     
-    /* get the gpio line */
-    gs_line = gpiod_chip_get_line(gs_chip, GPIO_DEVICE_LINE);
-    if (gs_line == NULL) 
+    /* creat the stop event */
+    gs_stop_fd = eventfd(0, EFD_CLOEXEC);
+    if (gs_stop_fd < 0)
     {
-        perror("gpio: get line failed.\n");
-        gpiod_chip_close(gs_chip);
-
-        return 1;
-    }
-
-    /* catch the falling edge */
-    if (gpiod_line_request_falling_edge_events(gs_line, "gpiointerrupt") < 0)
-    {
-        perror("gpio: set edge events failed.\n");
+        perror("gpio: creat eventfd failed.\n");
         gpiod_chip_close(gs_chip);
 
         return 1;
@@ -144,6 +214,8 @@ uint8_t gpio_interrupt_init(void)
     if (res != 0)
     {
         perror("gpio: creat pthread failed.\n");
+        (void)close(gs_stop_fd);
+        gs_stop_fd = -1;
         gpiod_chip_close(gs_chip);
 
         return 1;
@@ -160,20 +232,314 @@ uint8_t gpio_interrupt_init(void)
  * @note   none
  */
 uint8_t gpio_interrupt_deinit(void)
+{
+    uint64_t stop = 1;
+    
+    /* stop the gpio interrupt pthread */
+    if (write(gs_stop_fd, &stop, sizeof(stop)) != sizeof(stop))
+    {
+        perror("gpio: stop pthread failed.\n");
+
+        return 1;
+    }
+    
+    /* wait for the pthread */
+    if (pthread_join(gs_pid, NULL) != 0)
+    {
+        perror("gpio: join pthread failed.\n");
+
+        return 1;
+    }
+    (void)close(gs_stop_fd);
+    gs_stop_fd = -1;
+
+    /* close the gpio */
+    gpiod_chip_close(gs_chip);
+    
+    return 0;
+}
+
+/**
+ * @brief      gpio interrupt event init
+ * @param[out] *fd pointer to a line fd buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 init failed
+ * @note       no pthread is created, add the fd to the poll or epoll set of the application
+ *             and call gpio_interrupt_event_handler when it is readable
+ */
+uint8_t gpio_interrupt_event_init(int *fd)
 {
     uint8_t res;
     
-    /* close the gpio interrupt pthread */
-    res = pthread_cancel(gs_pid);
+    /* open the line */
+    res = a_gpio_open();
     if (res != 0)
     {
-        perror("gpio: delete pthread failed.\n");
-
         return 1;
     }
+    
+    /* get the fd */
+    *fd = gpiod_line_event_get_fd(gs_line);
+    
+    return 0;
+}
+
+/**
+ * @brief      gpio interrupt event handler
+ * @param[out] *count pointer to a falling edge number buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       all queued events are drained and the irq runs once when at least one falling edge is found,
+ *             g_gpio_irq_edge gets the kernel CLOCK_MONOTONIC timestamp of the last falling edge and is used instead of
+ *             g_gpio_irq when it is set
+ */
+uint8_t gpio_interrupt_event_handler(uint32_t *count)
+{
+    int i;
+    int num;
+    uint64_t edge_ns;
+    struct gpiod_line_event events[GPIO_EVENT_BATCH];
+    
+    /* drain the queue */
+    *count = 0;
+    edge_ns = 0;
+    while (1)
+    {
+        num = gpiod_line_event_read_multiple(gs_line, events, GPIO_EVENT_BATCH);
+        if (num < 0)
+        {
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+            {
+                break;
+            }
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            perror("gpio: read events failed.\n");
+            
+            return 1;
+        }
+        for (i = 0; i < num; i++)
+        {
+            if (events[i].event_type == GPIOD_LINE_EVENT_FALLING_EDGE)
+            {
+                /* the kernel stamps the edge in the interrupt */
+                edge_ns = (uint64_t)events[i].ts.tv_sec * 1000000000ULL + (uint64_t)events[i].ts.tv_nsec;
+                (*count)++;
+            }
+        }
+        if (num < GPIO_EVENT_BATCH)
+        {
+            break;
+        }
+    }
+    
+    /* coalesce the edges into one irq */
+    if ((*count != 0) && (g_gpio_irq_edge != NULL))
+    {
+        /* run the callback with the last edge */
+        (void)g_gpio_irq_edge(edge_ns);
+    }
+    else if ((*count != 0) && (g_gpio_irq != NULL))
+    {
+        /* run the callback */
+        (void)g_gpio_irq();
+    }
+    
+    return 0;
+}
 
+/**
+ * @brief  gpio interrupt event deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t gpio_interrupt_event_deinit(void)
+{
     /* close the gpio */
     gpiod_chip_close(gs_chip);
     
     return 0;
 }
+
+/**
+ * @brief     gpio set a line back to the alt0 function
+ * @param[in] *lines pointer to a line number list
+ * @param[in] num line number
+ * @return    status code
+ *            - 0 success
+ *            - 1 set failed
+ * @note      releasing a line leaves it as a gpio input, the iic controller needs alt0 again
+ */
+static uint8_t a_gpio_set_alt0(const uint32_t *lines, uint8_t num)
+{
+    int fd;
+    uint8_t i;
+    uint32_t shift;
+    volatile uint32_t *reg;
+    
+    /* map the gpio registers */
+    fd = open(GPIO_MEMORY_NAME, O_RDWR | O_SYNC);
+    if (fd < 0)
+    {
+        perror("gpio: open gpiomem failed.\n");
+        
+        return 1;
+    }
+    reg = (volatile uint32_t *)mmap(NULL, 4096, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (reg == (volatile uint32_t *)MAP_FAILED)
+    {
+        perror("gpio: map gpiomem failed.\n");
+        
+        return 1;
+    }
+    
+    /* function select, 3 bits per line, alt0 is 4 */
+    for (i = 0; i < num; i++)
+    {
+        shift = (lines[i] % 10) * 3;
+        reg[lines[i] / 10] = (reg[lines[i] / 10] & ~(7U << shift)) | (4U << shift);
+    }
+    (void)munmap((void *)reg, 4096);
+    
+    return 0;
+}
+
+/**
+ * @brief      gpio read a line level
+ * @param[in]  line line number
+ * @param[out] *value pointer to a level buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       the level register is read, so the line keeps its current function
+ */
+static uint8_t a_gpio_get_level(uint32_t line, uint8_t *value)
+{
+    int fd;
+    volatile uint32_t *reg;
+    
+    /* map the gpio registers */
+    fd = open(GPIO_MEMORY_NAME, O_RDONLY | O_SYNC);
+    if (fd < 0)
+    {
+        perror("gpio: open gpiomem failed.\n");
+        
+        return 1;
+    }
+    reg = (volatile uint32_t *)mmap(NULL, 4096, PROT_READ, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (reg == (volatile uint32_t *)MAP_FAILED)
+    {
+        perror("gpio: map gpiomem failed.\n");
+        
+        return 1;
+    }
+    
+    /* level register 0 is at 0x34 */
+    *value = (uint8_t)((reg[13 + line / 32] >> (line % 32)) & 0x01);
+    (void)munmap((void *)reg, 4096);
+    
+    return 0;
+}
+
+/**
+ * @brief  gpio iic bus recovery
+ * @return status code
+ *         - 0 success
+ *         - 1 recovery failed
+ * @note   up to 9 clocks are sent on scl until the slave releases sda, then a stop is sent,
+ *         the lines are given back to the iic controller at the end,
+ *         nothing is touched when sda is already high, so the other users of the bus are not disturbed
+ */
+uint8_t gpio_iic_bus_recovery(void)
+{
+    uint8_t i;
+    uint8_t res;
+    uint8_t level;
+    struct gpiod_chip *chip;
+    struct gpiod_line *scl;
+    struct gpiod_line *sda;
+    const uint32_t lines[2] = {GPIO_IIC_SDA_LINE, GPIO_IIC_SCL_LINE};
+    
+    /* the bus is not stuck when sda is released */
+    if (a_gpio_get_level(GPIO_IIC_SDA_LINE, &level) != 0)
+    {
+        return 1;
+    }
+    if (level == 1)
+    {
+        return 0;
+    }
+    
+    /* open the gpio group */
+    chip = gpiod_chip_open(GPIO_DEVICE_NAME);
+    if (chip == NULL)
+    {
+        perror("gpio: open failed.\n");
+
+        return 1;
+    }
+    scl = gpiod_chip_get_line(chip, GPIO_IIC_SCL_LINE);
+    sda = gpiod_chip_get_line(chip, GPIO_IIC_SDA_LINE);
+    if ((scl == NULL) || (sda == NULL))
+    {
+        perror("gpio: get line failed.\n");
+        gpiod_chip_close(chip);
+
+        return 1;
+    }
+    
+    /* scl open drain high and sda input */
+    if ((gpiod_line_request_output_flags(scl, "iicrecovery", GPIOD_LINE_REQUEST_FLAG_OPEN_DRAIN, 1) < 0) ||
+        (gpiod_line_request_input(sda, "iicrecovery") < 0))
+    {
+        perror("gpio: request line failed.\n");
+        gpiod_chip_close(chip);
+        (void)a_gpio_set_alt0(lines, 2);
+
+        return 1;
+    }
+    
+    /* clock until the slave releases sda */
+    for (i = 0; i < 9; i++)
+    {
+        if (gpiod_line_get_value(sda) == 1)
+        {
+            break;
+        }
+        (void)gpiod_line_set_value(scl, 0);
+        (void)usleep(GPIO_IIC_CLOCK_US);
+        (void)gpiod_line_set_value(scl, 1);
+        (void)usleep(GPIO_IIC_CLOCK_US);
+    }
+    res = (gpiod_line_get_value(sda) == 1) ? 0 : 1;
+    
+    /* stop, sda rises while scl is high */
+    gpiod_line_release(sda);
+    if (gpiod_line_request_output_flags(sda, "iicrecovery", GPIOD_LINE_REQUEST_FLAG_OPEN_DRAIN, 1) == 0)
+    {
+        (void)gpiod_line_set_value(scl, 0);
+        (void)usleep(GPIO_IIC_CLOCK_US);
+        (void)gpiod_line_set_value(sda, 0);
+        (void)usleep(GPIO_IIC_CLOCK_US);
+        (void)gpiod_line_set_value(scl, 1);
+        (void)usleep(GPIO_IIC_CLOCK_US);
+        (void)gpiod_line_set_value(sda, 1);
+        (void)usleep(GPIO_IIC_CLOCK_US);
+    }
+    
+    /* give the lines back to the iic controller */
+    gpiod_chip_close(chip);
+    if (a_gpio_set_alt0(lines, 2) != 0)
+    {
+        return 1;
+    }
+    
+    return res;
+}
@@ -39,6 +39,134 @@
 #include <linux/i2c-dev.h>
 #include <sys/ioctl.h>
 #include <fcntl.h>
+#include <errno.h>
+#include <time.h>
+
+/**
+ * @brief iic retry definition
+ */
+#define IIC_RETRY_TIMES       3         /**< retries after the first failed transfer */
+#define IIC_RETRY_DELAY_US    50        /**< first backoff delay, doubled on every retry */
+
+/**
+ * @brief global var definition
+ */
+static iic_error_t gs_error;                     /**< error counters */
+static uint8_t (*gs_recovery)(int fd) = NULL;    /**< bus recovery hook */
+
+/**
+ * @brief     add one to an error counter
+ * @param[in] *counter pointer to a counter
+ * @note      the counters may be updated from several threads
+ */
+static void a_iic_count(volatile uint32_t *counter)
+{
+    (void)__sync_fetch_and_add(counter, 1);
+}
+
+/**
+ * @brief     sleep for the backoff delay
+ * @param[in] us delay in microseconds
+ * @note      none
+ */
+static void a_iic_backoff(uint32_t us)
+{
+    struct timespec ts;
+    
+    ts.tv_sec = us / 1000000;
+    ts.tv_nsec = (long)(us % 1000000) * 1000;
+    while (nanosleep(&ts, &ts) < 0)
+    {
+        if (errno != EINTR)
+        {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief     run an I2C_RDWR ioctl with retries
+ * @param[in] fd iic handle
+ * @param[in] *data pointer to an ioctl data structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      nack, arbitration loss and timeout are retried with an exponential backoff,
+ *            the recovery hook runs once when the bus still times out or stays busy after all retries
+ */
+static uint8_t a_iic_rdwr(int fd, struct i2c_rdwr_ioctl_data *data)
+{
+    uint32_t delay;
+    uint8_t retry;
+    uint8_t recovered;
+    int err;
+    
+    delay = IIC_RETRY_DELAY_US;
+    retry = 0;
+    recovered = 0;
+    while (1)
+    {
+        /* transmit */
+        if (ioctl(fd, I2C_RDWR, data) >= 0)
+        {
+            return 0;
+        }
+        err = errno;
+        
+        /* count the error */
+        if ((err == EREMOTEIO) || (err == ENXIO))
+        {
+            a_iic_count(&gs_error.nack);
+        }
+        else if (err == EAGAIN)
+        {
+            a_iic_count(&gs_error.busy);
+        }
+        else if (err == ETIMEDOUT)
+        {
+            a_iic_count(&gs_error.timeout);
+        }
+        else if (err == EINTR)
+        {
+            continue;
+        }
+        else
+        {
+            /* bad fd or invalid messages never recover by retrying */
+            a_iic_count(&gs_error.other);
+            a_iic_count(&gs_error.failed);
+            errno = err;
+            
+            return 1;
+        }
+        
+        /* retry with a longer delay */
+        if (retry < IIC_RETRY_TIMES)
+        {
+            retry++;
+            a_iic_count(&gs_error.retry);
+            a_iic_backoff(delay);
+            delay = delay * 2;
+            
+            continue;
+        }
+        
+        /* a slave holding the bus needs clocks, try once more after the recovery, a nack is not a stuck bus */
+        if ((recovered == 0) && (gs_recovery != NULL) && ((err == ETIMEDOUT) || (err == EAGAIN)))
+        {
+            recovered = 1;
+            a_iic_count(&gs_error.recovery);
+            if (gs_recovery(fd) == 0)
+            {
+                continue;
+            }
+        }
+        a_iic_count(&gs_error.failed);
+        errno = err;
+        
+        return 1;
+    }
+}
 
 /**
  * @brief      iic bus init
@@ -121,7 +249,7 @@ uint8_t iic_read_cmd(int fd, uint8_t addr, uint8_t *buf, uint16_t len)
     i2c_rdwr_data.nmsgs = 1;
     
     /* transmit */
-    if (ioctl(fd, I2C_RDWR, &i2c_rdwr_data) < 0)
+    if (a_iic_rdwr(fd, &i2c_rdwr_data) != 0)
     {
         perror("iic: read failed.\n");
         
@@ -167,7 +295,7 @@ uint8_t iic_read(int fd, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
     i2c_rdwr_data.nmsgs = 2;
     
     /* transmit */
-    if (ioctl(fd, I2C_RDWR, &i2c_rdwr_data) < 0)
+    if (a_iic_rdwr(fd, &i2c_rdwr_data) != 0)
     {
         perror("iic: read failed.\n");
         
@@ -216,7 +344,7 @@ uint8_t iic_read_address16(int fd, uint8_t addr, uint16_t reg, uint8_t *buf, uin
     i2c_rdwr_data.nmsgs = 2;
     
     /* transmit */
-    if (ioctl(fd, I2C_RDWR, &i2c_rdwr_data) < 0)
+    if (a_iic_rdwr(fd, &i2c_rdwr_data) != 0)
     {
         perror("iic: read failed.\n");
         
@@ -257,7 +385,7 @@ uint8_t iic_write_cmd(int fd, uint8_t addr, uint8_t *buf, uint16_t len)
     i2c_rdwr_data.nmsgs = 1;
     
     /* transmit */
-    if (ioctl(fd, I2C_RDWR, &i2c_rdwr_data) < 0)
+    if (a_iic_rdwr(fd, &i2c_rdwr_data) != 0)
     {
         perror("iic: write failed.\n");
         
@@ -305,7 +433,7 @@ uint8_t iic_write(int fd, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
     i2c_rdwr_data.nmsgs = 1;
     
     /* transmit */
-    if (ioctl(fd, I2C_RDWR, &i2c_rdwr_data) < 0)
+    if (a_iic_rdwr(fd, &i2c_rdwr_data) != 0)
     {
         perror("iic: write failed.\n");
         
@@ -354,7 +482,7 @@ uint8_t iic_write_address16(int fd, uint8_t addr, uint16_t reg, uint8_t *buf, ui
     i2c_rdwr_data.nmsgs = 1;
     
     /* transmit */
-    if (ioctl(fd, I2C_RDWR, &i2c_rdwr_data) < 0)
+    if (a_iic_rdwr(fd, &i2c_rdwr_data) != 0)
     {
         perror("iic: write failed.\n");
         
@@ -363,3 +491,149 @@ uint8_t iic_write_address16(int fd, uint8_t addr, uint16_t reg, uint8_t *buf, ui
      
     return 0;
 }
+
+/**
+ * @brief     iic bus transfer
+ * @param[in] fd iic handle
+ * @param[in] addr iic device write address
+ * @param[in] *transfer pointer to a transfer list
+ * @param[in] num transfer number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      addr = device_address_7bits << 1,
+ *            all transfers are sent in one I2C_RDWR ioctl, a read takes two messages and a write takes one
+ */
+uint8_t iic_transfer(int fd, uint8_t addr, iic_transfer_t *transfer, uint8_t num)
+{
+    struct i2c_rdwr_ioctl_data i2c_rdwr_data;
+    struct i2c_msg msgs[I2C_RDWR_IOCTL_MAX_MSGS];
+    uint32_t size;
+    uint32_t offset;
+    uint32_t n;
+    uint8_t i;
+    
+    /* count the messages and the sent bytes */
+    size = 0;
+    n = 0;
+    for (i = 0; i < num; i++)
+    {
+        if (transfer[i].read != 0)
+        {
+            n += 2;
+        }
+        else
+        {
+            n += 1;
+            size += transfer[i].len + 1;
+        }
+    }
+    if ((n == 0) || (n > I2C_RDWR_IOCTL_MAX_MSGS))
+    {
+        perror("iic: transfer messages is invalid.\n");
+        
+        return 1;
+    }
+    
+    {
+        uint8_t buf_send[size + 1];
+        
+        /* clear ioctl data */
+        memset(&i2c_rdwr_data, 0, sizeof(struct i2c_rdwr_ioctl_data));
+        
+        /* clear msgs data */
+        memset(msgs, 0, sizeof(struct i2c_msg) * n);
+        
+        /* set the param */
+        n = 0;
+        offset = 0;
+        for (i = 0; i < num; i++)
+        {
+            if (transfer[i].read != 0)
+            {
+                /* register address then a repeated start read */
+                msgs[n].addr = addr >> 1;
+                msgs[n].flags = 0;
+                msgs[n].buf = &transfer[i].reg;
+                msgs[n].len = 1;
+                n++;
+                msgs[n].addr = addr >> 1;
+                msgs[n].flags = I2C_M_RD;
+                msgs[n].buf = transfer[i].buf;
+                msgs[n].len = transfer[i].len;
+                n++;
+            }
+            else
+            {
+                /* register address and data in one message */
+                buf_send[offset] = transfer[i].reg;
+                memcpy(&buf_send[offset + 1], transfer[i].buf, transfer[i].len);
+                msgs[n].addr = addr >> 1;
+                msgs[n].flags = 0;
+                msgs[n].buf = &buf_send[offset];
+                msgs[n].len = transfer[i].len + 1;
+                offset += transfer[i].len + 1;
+                n++;
+            }
+        }
+        i2c_rdwr_data.msgs = msgs;
+        i2c_rdwr_data.nmsgs = n;
+        
+        /* transmit */
+        if (a_iic_rdwr(fd, &i2c_rdwr_data) != 0)
+        {
+            perror("iic: transfer failed.\n");
+            
+            return 1;
+        }
+    }
+     
+    return 0;
+}
+
+/**
+ * @brief     iic bus set the recovery hook
+ * @param[in] *recovery pointer to a bus recovery function
+ * @return    status code
+ *            - 0 success
+ * @note      NULL disables the recovery
+ */
+uint8_t iic_set_recovery(uint8_t (*recovery)(int fd))
+{
+    gs_recovery = recovery;
+    
+    return 0;
+}
+
+/**
+ * @brief      iic bus get the error counters
+ * @param[out] *error pointer to an iic error structure
+ * @return     status code
+ *             - 0 success
+ * @note       none
+ */
+uint8_t iic_get_error(iic_error_t *error)
+{
+    error->nack = gs_error.nack;
+    error->busy = gs_error.busy;
+    error->timeout = gs_error.timeout;
+    error->other = gs_error.other;
+    error->retry = gs_error.retry;
+    error->recovery = gs_error.recovery;
+    error->failed = gs_error.failed;
+    
+    return 0;
+}
+
+/**
+ * @brief  iic bus clear the error counters
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t iic_clear_error(void)
+{
+    memset((void *)&gs_error, 0, sizeof(iic_error_t));
+    
+    return 0;
+}
@@ -0,0 +1,100 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      ds3231_server.h
+ * @brief     ds3231 server header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2022-11-11
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2022/11/11  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DS3231_SERVER_H
+#define DS3231_SERVER_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup ds3231_server ds3231 server function
+ * @brief    ds3231 server function modules
+ * @{
+ */
+
+/**
+ * @brief ds3231 server definition
+ */
+#define DS3231_SERVER_DEFAULT_PATH        "/tmp/ds3231.sock"        /**< default socket path */
+#define DS3231_SERVER_MAX_CLIENTS         16                        /**< max connected clients */
+#define DS3231_SERVER_LINE_SIZE           128                       /**< max request line length */
+#define DS3231_SERVER_BUFFER_SIZE         4096                      /**< per client response buffer */
+
+/**
+ * @brief     server init
+ * @param[in] *path pointer to a socket path, NULL uses the default path
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the device is initialized once and kept open until deinit, the aging offset stored in the chip is kept,
+ *            a stale socket file left at the path is removed, init fails when the path is not a socket or
+ *            another server is still accepting on it
+ */
+uint8_t ds3231_server_init(const char *path);
+
+/**
+ * @brief  server deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   all clients are disconnected and the socket file is removed
+ */
+uint8_t ds3231_server_deinit(void);
+
+/**
+ * @brief     server wait for the sockets and answer the requests
+ * @param[in] timeout_ms max waiting time in ms, -1 waits forever
+ * @return    status code
+ *            - 0 success
+ *            - 1 poll failed
+ * @note      one request per line, requests of one client are answered in order so they can be pipelined,
+ *            an interrupted wait returns 0 so the caller can check its stop flag
+ */
+uint8_t ds3231_server_poll(int timeout_ms);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
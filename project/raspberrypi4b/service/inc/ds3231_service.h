@@ -0,0 +1,91 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      ds3231_service.h
+ * @brief     ds3231 service header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2022-11-11
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2022/11/11  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DS3231_SERVICE_H
+#define DS3231_SERVICE_H
+
+#include "driver_ds3231_interface.h"
+#include "ds3231_service_client.h"
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup ds3231_service ds3231 service function
+ * @brief    ds3231 service function modules
+ * @{
+ */
+
+/**
+ * @brief     service init
+ * @param[in] *name pointer to a shared memory name, NULL uses the default name
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the daemon owns the device, the pin outputs a 1Hz square wave after init,
+ *            connect it to an interrupt capable gpio
+ */
+uint8_t ds3231_service_init(const char *name);
+
+/**
+ * @brief  service deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   the shared memory is unlinked, mapped clients keep the last data and see it go stale
+ */
+uint8_t ds3231_service_deinit(void);
+
+/**
+ * @brief     service square wave edge handler
+ * @param[in] timestamp_ns CLOCK_MONOTONIC timestamp of the falling edge in nanoseconds
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      one snapshot transaction is issued per edge and the result is published
+ */
+uint8_t ds3231_service_edge(uint64_t timestamp_ns);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
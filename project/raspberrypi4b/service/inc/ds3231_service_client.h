@@ -0,0 +1,154 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      ds3231_service_client.h
+ * @brief     ds3231 service client header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2022-11-11
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2022/11/11  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DS3231_SERVICE_CLIENT_H
+#define DS3231_SERVICE_CLIENT_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup ds3231_service_client ds3231 service client function
+ * @brief    ds3231 service client function modules
+ * @{
+ */
+
+/**
+ * @brief ds3231 service shared memory definition
+ */
+#define DS3231_SERVICE_DEFAULT_NAME        "/ds3231"          /**< default shared memory name */
+#define DS3231_SERVICE_MAGIC               0x31333244U        /**< "DS31" */
+#define DS3231_SERVICE_LAYOUT_VERSION      1                  /**< bumped on every layout change */
+#define DS3231_SERVICE_STALE_NS            2000000000ULL      /**< no edge for 2s means the daemon or the square wave is lost */
+
+/**
+ * @brief ds3231 service data structure definition
+ */
+typedef struct ds3231_service_data_s
+{
+    int64_t timestamp;           /**< rtc unix timestamp of the anchor edge */
+    uint64_t anchor_ns;          /**< CLOCK_MONOTONIC timestamp of the anchor edge */
+    uint64_t update;             /**< published edges */
+    float temperature;           /**< last temperature conversion */
+    uint8_t status;              /**< status register */
+} ds3231_service_data_t;
+
+/**
+ * @brief ds3231 service shared memory structure definition
+ */
+typedef struct ds3231_service_shm_s
+{
+    uint32_t magic;                       /**< DS3231_SERVICE_MAGIC */
+    uint32_t version;                     /**< DS3231_SERVICE_LAYOUT_VERSION */
+    volatile uint32_t sequence;           /**< data sequence, odd while the daemon is updating */
+    uint32_t reserved;                    /**< reserved */
+    volatile ds3231_service_data_t data;  /**< published data */
+} ds3231_service_shm_t;
+
+/**
+ * @brief ds3231 service client structure definition
+ */
+typedef struct ds3231_service_client_s
+{
+    const ds3231_service_shm_t *shm;        /**< mapped shared memory */
+} ds3231_service_client_t;
+
+/**
+ * @brief      open the service shared memory
+ * @param[out] *client pointer to a client structure
+ * @param[in]  *name pointer to a shared memory name, NULL uses the default name
+ * @return     status code
+ *             - 0 success
+ *             - 1 open failed
+ *             - 2 client is NULL
+ *             - 4 layout is not supported
+ * @note       the segment is mapped read only, no file descriptor is kept
+ */
+uint8_t ds3231_service_client_open(ds3231_service_client_t *client, const char *name);
+
+/**
+ * @brief     close the service shared memory
+ * @param[in] *client pointer to a client structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 close failed
+ *            - 2 client is NULL
+ *            - 3 client is not opened
+ * @note      none
+ */
+uint8_t ds3231_service_client_close(ds3231_service_client_t *client);
+
+/**
+ * @brief      read the published data
+ * @param[in]  *client pointer to a client structure
+ * @param[out] *data pointer to a data structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 client or data is NULL
+ *             - 3 client is not opened
+ *             - 4 nothing is published
+ * @note       lock free, the read retries while the daemon is updating
+ */
+uint8_t ds3231_service_client_read(ds3231_service_client_t *client, ds3231_service_data_t *data);
+
+/**
+ * @brief      get the current time
+ * @param[in]  *client pointer to a client structure
+ * @param[out] *timestamp pointer to a unix timestamp buffer
+ * @param[out] *ns pointer to a nanosecond buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 client or buffer is NULL
+ *             - 3 client is not opened
+ *             - 4 nothing is published
+ *             - 5 data is stale
+ * @note       the time is extrapolated from the last edge with CLOCK_MONOTONIC,
+ *             which is served by the vdso, so no system call is made
+ */
+uint8_t ds3231_service_client_get_time(ds3231_service_client_t *client, int64_t *timestamp, uint32_t *ns);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
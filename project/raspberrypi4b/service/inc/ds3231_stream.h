@@ -0,0 +1,110 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      ds3231_stream.h
+ * @brief     ds3231 stream header file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2022-11-11
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2022/11/11  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DS3231_STREAM_H
+#define DS3231_STREAM_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @defgroup ds3231_stream ds3231 stream function
+ * @brief    ds3231 stream function modules
+ * @{
+ */
+
+/**
+ * @brief ds3231 stream definition
+ */
+#define DS3231_STREAM_BUFFER_SIZE        65536        /**< output buffer size */
+#define DS3231_STREAM_RECORD_SIZE        24           /**< binary record size */
+
+/**
+ * @brief ds3231 stream format enumeration definition
+ */
+typedef enum
+{
+    DS3231_STREAM_FORMAT_CSV    = 0x00,        /**< comma separated values with a header line */
+    DS3231_STREAM_FORMAT_NDJSON = 0x01,        /**< one json object per line */
+    DS3231_STREAM_FORMAT_BINARY = 0x02,        /**< fixed width little endian records */
+} ds3231_stream_format_t;
+
+/**
+ * @brief     stream init
+ * @param[in] *fp pointer to an output file
+ * @param[in] format output format
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      call it before any other input or output on fp, the buffer is kept until fp is closed,
+ *            the binary record is u64 host unix ns, u16 year, u8 month, date, hour in 24h, minute, second, week,
+ *            u8 status, u8 control, s16 temperature register (1/256C) and u32 sequence
+ */
+uint8_t ds3231_stream_init(FILE *fp, ds3231_stream_format_t format);
+
+/**
+ * @brief  stream deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 flush failed
+ * @note   none
+ */
+uint8_t ds3231_stream_deinit(void);
+
+/**
+ * @brief     stream take one sample
+ * @param[in] host_ns host unix timestamp of the sample in nanoseconds
+ * @return    status code
+ *            - 0 success
+ *            - 1 sample failed
+ * @note      the device must be initialized with ds3231_basic_init_keep_aging,
+ *            one snapshot transaction per sample, the record is buffered
+ */
+uint8_t ds3231_stream_sample(uint64_t host_ns);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
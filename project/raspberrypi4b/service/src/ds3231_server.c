@@ -0,0 +1,599 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      ds3231_server.c
+ * @brief     ds3231 server source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2022-11-11
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2022/11/11  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "ds3231_server.h"
+#include "driver_ds3231_basic.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+/**
+ * @brief server client structure definition
+ */
+typedef struct ds3231_server_client_s
+{
+    int fd;                                           /**< socket, -1 when unused */
+    uint16_t in_len;                                  /**< buffered request bytes */
+    uint16_t out_len;                                 /**< buffered response bytes */
+    uint16_t out_pos;                                 /**< sent response bytes */
+    uint8_t drop;                                     /**< skipping an overlong line */
+    char in[DS3231_SERVER_LINE_SIZE];                 /**< request buffer */
+    char out[DS3231_SERVER_BUFFER_SIZE];              /**< response buffer */
+} ds3231_server_client_t;
+
+static int gs_listen_fd = -1;                                                   /**< listening socket */
+static int gs_epoll_fd = -1;                                                    /**< epoll instance */
+static char gs_path[108];                                                       /**< socket path */
+static ds3231_server_client_t gs_clients[DS3231_SERVER_MAX_CLIENTS];            /**< clients */
+
+/**
+ * @brief     close a client
+ * @param[in] *client pointer to a client
+ * @note      none
+ */
+static void a_ds3231_server_close(ds3231_server_client_t *client)
+{
+    (void)epoll_ctl(gs_epoll_fd, EPOLL_CTL_DEL, client->fd, NULL);
+    (void)close(client->fd);
+    client->fd = -1;
+}
+
+/**
+ * @brief     append a response line
+ * @param[in] *client pointer to a client
+ * @param[in] *line pointer to a response line
+ * @note      the response is dropped when the client stops reading and the buffer is full
+ */
+static void a_ds3231_server_reply(ds3231_server_client_t *client, const char *line)
+{
+    size_t len;
+    
+    len = strlen(line);
+    if ((size_t)client->out_len + len > DS3231_SERVER_BUFFER_SIZE)
+    {
+        return;
+    }
+    memcpy(&client->out[client->out_len], line, len);
+    client->out_len = (uint16_t)(client->out_len + len);
+}
+
+/**
+ * @brief     run one request
+ * @param[in] *client pointer to a client
+ * @param[in] *line pointer to a request line without the new line
+ * @note      none
+ */
+static void a_ds3231_server_request(ds3231_server_client_t *client, char *line)
+{
+    char buf[64];
+    char *arg;
+    char *end;
+    time_t timestamp;
+    int16_t raw;
+    float s;
+    ds3231_time_t t;
+    
+    /* split the argument */
+    arg = strchr(line, ' ');
+    if (arg != NULL)
+    {
+        *arg = '\0';
+        arg++;
+    }
+    
+    if (strcmp("ping", line) == 0)
+    {
+        a_ds3231_server_reply(client, "ok\n");
+    }
+    else if (strcmp("get-time", line) == 0)
+    {
+        if (ds3231_basic_get_time(&t) != 0)
+        {
+            a_ds3231_server_reply(client, "err get time failed\n");
+            
+            return;
+        }
+        if (t.format == DS3231_FORMAT_24H)
+        {
+            (void)snprintf(buf, 64, "ok %04d-%02d-%02d %02d:%02d:%02d %d\n",
+                           t.year, t.month, t.date, t.hour, t.minute, t.second, t.week);
+        }
+        else
+        {
+            (void)snprintf(buf, 64, "ok %04d-%02d-%02d %s %02d:%02d:%02d %d\n",
+                           t.year, t.month, t.date, (t.am_pm == DS3231_AM) ? "AM" : "PM",
+                           t.hour, t.minute, t.second, t.week);
+        }
+        a_ds3231_server_reply(client, buf);
+    }
+    else if (strcmp("get-timestamp", line) == 0)
+    {
+        if (ds3231_basic_get_timestamp(&timestamp) != 0)
+        {
+            a_ds3231_server_reply(client, "err get timestamp failed\n");
+            
+            return;
+        }
+        (void)snprintf(buf, 64, "ok %lld\n", (long long)timestamp);
+        a_ds3231_server_reply(client, buf);
+    }
+    else if (strcmp("set-timestamp", line) == 0)
+    {
+        if ((arg == NULL) || (*arg == '\0'))
+        {
+            a_ds3231_server_reply(client, "err param is invalid\n");
+            
+            return;
+        }
+        timestamp = (time_t)strtoll(arg, &end, 10);
+        if (*end != '\0')
+        {
+            a_ds3231_server_reply(client, "err param is invalid\n");
+            
+            return;
+        }
+        if (ds3231_basic_set_timestamp(timestamp) != 0)
+        {
+            a_ds3231_server_reply(client, "err set timestamp failed\n");
+            
+            return;
+        }
+        a_ds3231_server_reply(client, "ok\n");
+    }
+    else if (strcmp("get-temperature", line) == 0)
+    {
+        if (ds3231_basic_get_temperature(&raw, &s) != 0)
+        {
+            a_ds3231_server_reply(client, "err get temperature failed\n");
+            
+            return;
+        }
+        (void)snprintf(buf, 64, "ok %0.2f\n", s);
+        a_ds3231_server_reply(client, buf);
+    }
+    else
+    {
+        a_ds3231_server_reply(client, "err unknown command\n");
+    }
+}
+
+/**
+ * @brief     send the buffered responses
+ * @param[in] *client pointer to a client
+ * @return    status code
+ *            - 0 success
+ *            - 1 send failed
+ * @note      the client is watched for writing instead of reading while a response is left
+ */
+static uint8_t a_ds3231_server_flush(ds3231_server_client_t *client)
+{
+    ssize_t n;
+    struct epoll_event ev;
+    
+    while (client->out_pos < client->out_len)
+    {
+        n = send(client->fd, &client->out[client->out_pos], client->out_len - client->out_pos, MSG_NOSIGNAL);
+        if (n < 0)
+        {
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+            {
+                break;
+            }
+            
+            return 1;
+        }
+        client->out_pos = (uint16_t)(client->out_pos + n);
+    }
+    if (client->out_pos == client->out_len)
+    {
+        client->out_pos = 0;
+        client->out_len = 0;
+    }
+    
+    /* stop reading requests until the responses are sent */
+    ev.events = (client->out_len != 0) ? EPOLLOUT : EPOLLIN;
+    ev.data.ptr = client;
+    (void)epoll_ctl(gs_epoll_fd, EPOLL_CTL_MOD, client->fd, &ev);
+    
+    return 0;
+}
+
+/**
+ * @brief     read and answer the requests of a client
+ * @param[in] *client pointer to a client
+ * @return    status code
+ *            - 0 success
+ *            - 1 the client is closed
+ * @note      all complete lines in one read are answered before one send,
+ *            one read is short enough that its responses always fit into the buffer
+ */
+static uint8_t a_ds3231_server_read(ds3231_server_client_t *client)
+{
+    char buf[DS3231_SERVER_LINE_SIZE];
+    ssize_t n;
+    ssize_t i;
+    
+    n = recv(client->fd, buf, sizeof(buf), 0);
+    if (n == 0)
+    {
+        return 1;
+    }
+    if (n < 0)
+    {
+        return ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == EINTR)) ? 0 : 1;
+    }
+    
+    /* split the lines */
+    for (i = 0; i < n; i++)
+    {
+        if (buf[i] == '\n')
+        {
+            if (client->drop != 0)
+            {
+                client->drop = 0;
+                a_ds3231_server_reply(client, "err line is too long\n");
+            }
+            else
+            {
+                if ((client->in_len != 0) && (client->in[client->in_len - 1] == '\r'))
+                {
+                    client->in_len--;
+                }
+                client->in[client->in_len] = '\0';
+                a_ds3231_server_request(client, client->in);
+            }
+            client->in_len = 0;
+        }
+        else if (client->drop != 0)
+        {
+            continue;
+        }
+        else if (client->in_len < DS3231_SERVER_LINE_SIZE - 1)
+        {
+            client->in[client->in_len++] = buf[i];
+        }
+        else
+        {
+            client->drop = 1;
+            client->in_len = 0;
+        }
+    }
+    
+    return a_ds3231_server_flush(client);
+}
+
+/**
+ * @brief  accept the pending connections
+ * @note   connections beyond DS3231_SERVER_MAX_CLIENTS are closed at once
+ */
+static void a_ds3231_server_accept(void)
+{
+    int fd;
+    uint32_t i;
+    struct epoll_event ev;
+    
+    while (1)
+    {
+        fd = accept(gs_listen_fd, NULL, NULL);
+        if (fd < 0)
+        {
+            return;
+        }
+        if (fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK) != 0)
+        {
+            (void)close(fd);
+            
+            continue;
+        }
+        for (i = 0; i < DS3231_SERVER_MAX_CLIENTS; i++)
+        {
+            if (gs_clients[i].fd < 0)
+            {
+                break;
+            }
+        }
+        if (i == DS3231_SERVER_MAX_CLIENTS)
+        {
+            (void)close(fd);
+            
+            continue;
+        }
+        gs_clients[i].fd = fd;
+        gs_clients[i].in_len = 0;
+        gs_clients[i].out_len = 0;
+        gs_clients[i].out_pos = 0;
+        gs_clients[i].drop = 0;
+        ev.events = EPOLLIN;
+        ev.data.ptr = &gs_clients[i];
+        if (epoll_ctl(gs_epoll_fd, EPOLL_CTL_ADD, fd, &ev) != 0)
+        {
+            (void)close(fd);
+            gs_clients[i].fd = -1;
+        }
+    }
+}
+
+/**
+ * @brief     remove a stale socket file
+ * @param[in] *addr pointer to a socket address
+ * @return    status code
+ *            - 0 success
+ *            - 1 path is in use
+ * @note      only a socket nobody accepts on is removed
+ */
+static uint8_t a_ds3231_server_remove_stale(const struct sockaddr_un *addr)
+{
+    int fd;
+    int res;
+    struct stat st;
+    
+    /* check the file type */
+    if (lstat(addr->sun_path, &st) != 0)
+    {
+        return (errno == ENOENT) ? 0 : 1;
+    }
+    if (!S_ISSOCK(st.st_mode))
+    {
+        ds3231_interface_debug_print("ds3231: %s is not a socket.\n", addr->sun_path);
+        
+        return 1;
+    }
+    
+    /* probe the socket */
+    fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        return 1;
+    }
+    res = connect(fd, (const struct sockaddr *)addr, sizeof(struct sockaddr_un));
+    (void)close(fd);
+    if ((res == 0) || (errno != ECONNREFUSED))
+    {
+        ds3231_interface_debug_print("ds3231: %s is in use.\n", addr->sun_path);
+        
+        return 1;
+    }
+    
+    /* remove the socket */
+    if (unlink(addr->sun_path) != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     server init
+ * @param[in] *path pointer to a socket path, NULL uses the default path
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the device is initialized once and kept open until deinit, the aging offset stored in the chip is kept,
+ *            a stale socket file left at the path is removed, init fails when the path is not a socket or
+ *            another server is still accepting on it
+ */
+uint8_t ds3231_server_init(const char *path)
+{
+    uint32_t i;
+    struct sockaddr_un addr;
+    struct epoll_event ev;
+    
+    /* check the path */
+    if (path == NULL)
+    {
+        path = DS3231_SERVER_DEFAULT_PATH;
+    }
+    if (strlen(path) >= sizeof(addr.sun_path))
+    {
+        ds3231_interface_debug_print("ds3231: socket path is too long.\n");
+        
+        return 1;
+    }
+    memset(gs_path, 0, sizeof(char) * 108);
+    strncpy(gs_path, path, sizeof(addr.sun_path) - 1);
+    memset(&addr, 0, sizeof(struct sockaddr_un));
+    addr.sun_family = AF_UNIX;
+    memcpy(addr.sun_path, gs_path, strlen(gs_path));
+    
+    /* remove the stale socket */
+    if (a_ds3231_server_remove_stale(&addr) != 0)
+    {
+        return 1;
+    }
+    
+    /* basic init */
+    if (ds3231_basic_init_keep_aging() != 0)
+    {
+        return 1;
+    }
+    
+    /* creat the socket */
+    gs_listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (gs_listen_fd < 0)
+    {
+        ds3231_interface_debug_print("ds3231: creat socket failed.\n");
+        (void)ds3231_basic_deinit();
+        
+        return 1;
+    }
+    if ((bind(gs_listen_fd, (struct sockaddr *)&addr, sizeof(struct sockaddr_un)) != 0) ||
+        (listen(gs_listen_fd, DS3231_SERVER_MAX_CLIENTS) != 0))
+    {
+        ds3231_interface_debug_print("ds3231: bind %s failed.\n", gs_path);
+        (void)close(gs_listen_fd);
+        gs_listen_fd = -1;
+        (void)ds3231_basic_deinit();
+        
+        return 1;
+    }
+    
+    /* creat the epoll */
+    gs_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    ev.events = EPOLLIN;
+    ev.data.ptr = NULL;
+    if ((gs_epoll_fd < 0) || (epoll_ctl(gs_epoll_fd, EPOLL_CTL_ADD, gs_listen_fd, &ev) != 0))
+    {
+        ds3231_interface_debug_print("ds3231: creat epoll failed.\n");
+        if (gs_epoll_fd >= 0)
+        {
+            (void)close(gs_epoll_fd);
+            gs_epoll_fd = -1;
+        }
+        (void)close(gs_listen_fd);
+        gs_listen_fd = -1;
+        (void)unlink(gs_path);
+        (void)ds3231_basic_deinit();
+        
+        return 1;
+    }
+    for (i = 0; i < DS3231_SERVER_MAX_CLIENTS; i++)
+    {
+        gs_clients[i].fd = -1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  server deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   all clients are disconnected and the socket file is removed
+ */
+uint8_t ds3231_server_deinit(void)
+{
+    uint32_t i;
+    
+    /* close the clients */
+    for (i = 0; i < DS3231_SERVER_MAX_CLIENTS; i++)
+    {
+        if (gs_clients[i].fd >= 0)
+        {
+            a_ds3231_server_close(&gs_clients[i]);
+        }
+    }
+    
+    /* close the socket */
+    if (gs_epoll_fd >= 0)
+    {
+        (void)close(gs_epoll_fd);
+        gs_epoll_fd = -1;
+    }
+    if (gs_listen_fd >= 0)
+    {
+        (void)close(gs_listen_fd);
+        gs_listen_fd = -1;
+        (void)unlink(gs_path);
+    }
+    
+    /* basic deinit */
+    if (ds3231_basic_deinit() != 0)
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     server wait for the sockets and answer the requests
+ * @param[in] timeout_ms max waiting time in ms, -1 waits forever
+ * @return    status code
+ *            - 0 success
+ *            - 1 poll failed
+ * @note      one request per line, requests of one client are answered in order so they can be pipelined,
+ *            an interrupted wait returns 0 so the caller can check its stop flag
+ */
+uint8_t ds3231_server_poll(int timeout_ms)
+{
+    int n;
+    int i;
+    struct epoll_event ev[DS3231_SERVER_MAX_CLIENTS + 1];
+    ds3231_server_client_t *client;
+    
+    n = epoll_wait(gs_epoll_fd, ev, DS3231_SERVER_MAX_CLIENTS + 1, timeout_ms);
+    if (n < 0)
+    {
+        return (errno == EINTR) ? 0 : 1;
+    }
+    for (i = 0; i < n; i++)
+    {
+        client = (ds3231_server_client_t *)ev[i].data.ptr;
+        if (client == NULL)
+        {
+            a_ds3231_server_accept();
+            
+            continue;
+        }
+        if (client->fd < 0)
+        {
+            continue;
+        }
+        if ((ev[i].events & EPOLLIN) != 0)
+        {
+            if (a_ds3231_server_read(client) != 0)
+            {
+                a_ds3231_server_close(client);
+                
+                continue;
+            }
+        }
+        else if ((ev[i].events & EPOLLOUT) != 0)
+        {
+            if (a_ds3231_server_flush(client) != 0)
+            {
+                a_ds3231_server_close(client);
+                
+                continue;
+            }
+        }
+        else if ((ev[i].events & (EPOLLERR | EPOLLHUP)) != 0)
+        {
+            a_ds3231_server_close(client);
+        }
+    }
+    
+    return 0;
+}
@@ -0,0 +1,245 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      ds3231_service.c
+ * @brief     ds3231 service source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2022-11-11
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2022/11/11  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "ds3231_service.h"
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+/**
+ * @brief service edge window definition
+ */
+#define DS3231_SERVICE_EDGE_MIN_NS        500000000ULL        /**< shorter intervals are glitches */
+
+/**
+ * @brief service memory barrier definition
+ */
+#if defined(__GNUC__)
+#define DS3231_SERVICE_BARRIER()        __sync_synchronize()
+#else
+#define DS3231_SERVICE_BARRIER()
+#endif
+
+static ds3231_handle_t gs_handle;                   /**< ds3231 handle */
+static ds3231_service_shm_t *gs_shm = NULL;         /**< mapped shared memory */
+static char gs_name[256];                           /**< shared memory name */
+static uint64_t gs_edge_ns = 0;                     /**< last accepted edge */
+
+/**
+ * @brief     publish the edge state
+ * @param[in] timestamp rtc unix timestamp of the edge
+ * @param[in] anchor_ns kernel monotonic timestamp of the edge
+ * @param[in] *snapshot pointer to the register snapshot
+ * @note      only called from the edge handler, readers retry while the sequence is odd or changed
+ */
+static void a_ds3231_service_publish(int64_t timestamp, uint64_t anchor_ns, ds3231_snapshot_t *snapshot)
+{
+    gs_shm->sequence = gs_shm->sequence + 1;
+    DS3231_SERVICE_BARRIER();
+    gs_shm->data.timestamp = timestamp;
+    gs_shm->data.anchor_ns = anchor_ns;
+    gs_shm->data.update = gs_shm->data.update + 1;
+    gs_shm->data.temperature = snapshot->temperature;
+    gs_shm->data.status = snapshot->status;
+    DS3231_SERVICE_BARRIER();
+    gs_shm->sequence = gs_shm->sequence + 1;
+}
+
+/**
+ * @brief     service init
+ * @param[in] *name pointer to a shared memory name, NULL uses the default name
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the daemon owns the device, the pin outputs a 1Hz square wave after init,
+ *            connect it to an interrupt capable gpio
+ */
+uint8_t ds3231_service_init(const char *name)
+{
+    uint8_t res;
+    int fd;
+    void *addr;
+    
+    /* link functions */
+    DRIVER_DS3231_LINK_INIT(&gs_handle, ds3231_handle_t);
+    DRIVER_DS3231_LINK_IIC_INIT(&gs_handle, ds3231_interface_iic_init);
+    DRIVER_DS3231_LINK_IIC_DEINIT(&gs_handle, ds3231_interface_iic_deinit);
+    DRIVER_DS3231_LINK_IIC_READ(&gs_handle, ds3231_interface_iic_read);
+    DRIVER_DS3231_LINK_IIC_WRITE(&gs_handle, ds3231_interface_iic_write);
+    DRIVER_DS3231_LINK_IIC_TRANSFER(&gs_handle, ds3231_interface_iic_transfer);
+    DRIVER_DS3231_LINK_DELAY_MS(&gs_handle, ds3231_interface_delay_ms);
+    DRIVER_DS3231_LINK_DEBUG_PRINT(&gs_handle, ds3231_interface_debug_print);
+    DRIVER_DS3231_LINK_RECEIVE_CALLBACK(&gs_handle, ds3231_interface_receive_callback);
+    DRIVER_DS3231_LINK_LOCK(&gs_handle, ds3231_interface_lock);
+    DRIVER_DS3231_LINK_UNLOCK(&gs_handle, ds3231_interface_unlock);
+    
+    /* ds3231 init */
+    res = ds3231_init(&gs_handle);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* output the 1Hz square wave */
+    res = ds3231_set_square_wave_frequency(&gs_handle, DS3231_SQUARE_WAVE_FREQUENCY_1HZ);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: set square wave frequency failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds3231_set_pin(&gs_handle, DS3231_PIN_SQUARE_WAVE);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: set pin failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* creat the segment */
+    memset(gs_name, 0, sizeof(char) * 256);
+    strncpy(gs_name, (name != NULL) ? name : DS3231_SERVICE_DEFAULT_NAME, 255);
+    fd = shm_open(gs_name, O_CREAT | O_RDWR, 0644);
+    if (fd < 0)
+    {
+        ds3231_interface_debug_print("ds3231: open %s failed.\n", gs_name);
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    if (ftruncate(fd, sizeof(ds3231_service_shm_t)) != 0)
+    {
+        ds3231_interface_debug_print("ds3231: resize %s failed.\n", gs_name);
+        (void)close(fd);
+        (void)shm_unlink(gs_name);
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    addr = mmap(NULL, sizeof(ds3231_service_shm_t), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (addr == MAP_FAILED)
+    {
+        ds3231_interface_debug_print("ds3231: map %s failed.\n", gs_name);
+        (void)shm_unlink(gs_name);
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* nothing is published until the first edge */
+    gs_shm = (ds3231_service_shm_t *)addr;
+    memset(gs_shm, 0, sizeof(ds3231_service_shm_t));
+    gs_shm->version = DS3231_SERVICE_LAYOUT_VERSION;
+    DS3231_SERVICE_BARRIER();
+    gs_shm->magic = DS3231_SERVICE_MAGIC;
+    gs_edge_ns = 0;
+    
+    return 0;
+}
+
+/**
+ * @brief  service deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 deinit failed
+ * @note   the shared memory is unlinked, mapped clients keep the last data and see it go stale
+ */
+uint8_t ds3231_service_deinit(void)
+{
+    uint8_t res;
+    
+    /* remove the segment */
+    res = 0;
+    if (gs_shm != NULL)
+    {
+        (void)munmap(gs_shm, sizeof(ds3231_service_shm_t));
+        (void)shm_unlink(gs_name);
+        gs_shm = NULL;
+    }
+    
+    /* ds3231 deinit */
+    if (ds3231_deinit(&gs_handle) != 0)
+    {
+        res = 1;
+    }
+    
+    return res;
+}
+
+/**
+ * @brief     service square wave edge handler
+ * @param[in] timestamp_ns CLOCK_MONOTONIC timestamp of the falling edge in nanoseconds
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      one snapshot transaction is issued per edge and the result is published
+ */
+uint8_t ds3231_service_edge(uint64_t timestamp_ns)
+{
+    int64_t timestamp;
+    ds3231_snapshot_t snapshot;
+    
+    if (gs_shm == NULL)
+    {
+        return 1;
+    }
+    
+    /* ignore glitches */
+    if ((gs_edge_ns != 0) && (timestamp_ns > gs_edge_ns) && ((timestamp_ns - gs_edge_ns) < DS3231_SERVICE_EDGE_MIN_NS))
+    {
+        return 0;
+    }
+    gs_edge_ns = timestamp_ns;
+    
+    /* the seconds register has just been updated by this edge */
+    if (ds3231_read_snapshot(&gs_handle, &snapshot) != 0)
+    {
+        return 1;
+    }
+    if (ds3231_time_to_unix(&gs_handle, &snapshot.time, 0, &timestamp) != 0)
+    {
+        return 1;
+    }
+    a_ds3231_service_publish(timestamp, timestamp_ns, &snapshot);
+    
+    return 0;
+}
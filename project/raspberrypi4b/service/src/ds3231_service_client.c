@@ -0,0 +1,220 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      ds3231_service_client.c
+ * @brief     ds3231 service client source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2022-11-11
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2022/11/11  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "ds3231_service_client.h"
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+/**
+ * @brief service client memory barrier definition
+ */
+#if defined(__GNUC__)
+#define DS3231_SERVICE_BARRIER()        __sync_synchronize()
+#else
+#define DS3231_SERVICE_BARRIER()
+#endif
+
+/**
+ * @brief      open the service shared memory
+ * @param[out] *client pointer to a client structure
+ * @param[in]  *name pointer to a shared memory name, NULL uses the default name
+ * @return     status code
+ *             - 0 success
+ *             - 1 open failed
+ *             - 2 client is NULL
+ *             - 4 layout is not supported
+ * @note       the segment is mapped read only, no file descriptor is kept
+ */
+uint8_t ds3231_service_client_open(ds3231_service_client_t *client, const char *name)
+{
+    int fd;
+    void *addr;
+    
+    if (client == NULL)
+    {
+        return 2;
+    }
+    
+    /* map the segment */
+    fd = shm_open((name != NULL) ? name : DS3231_SERVICE_DEFAULT_NAME, O_RDONLY, 0);
+    if (fd < 0)
+    {
+        return 1;
+    }
+    addr = mmap(NULL, sizeof(ds3231_service_shm_t), PROT_READ, MAP_SHARED, fd, 0);
+    (void)close(fd);
+    if (addr == MAP_FAILED)
+    {
+        return 1;
+    }
+    
+    /* check the layout */
+    client->shm = (const ds3231_service_shm_t *)addr;
+    if ((client->shm->magic != DS3231_SERVICE_MAGIC) || (client->shm->version != DS3231_SERVICE_LAYOUT_VERSION))
+    {
+        (void)munmap(addr, sizeof(ds3231_service_shm_t));
+        client->shm = NULL;
+        
+        return 4;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     close the service shared memory
+ * @param[in] *client pointer to a client structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 close failed
+ *            - 2 client is NULL
+ *            - 3 client is not opened
+ * @note      none
+ */
+uint8_t ds3231_service_client_close(ds3231_service_client_t *client)
+{
+    if (client == NULL)
+    {
+        return 2;
+    }
+    if (client->shm == NULL)
+    {
+        return 3;
+    }
+    
+    /* unmap the segment */
+    if (munmap((void *)client->shm, sizeof(ds3231_service_shm_t)) != 0)
+    {
+        return 1;
+    }
+    client->shm = NULL;
+    
+    return 0;
+}
+
+/**
+ * @brief      read the published data
+ * @param[in]  *client pointer to a client structure
+ * @param[out] *data pointer to a data structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 client or data is NULL
+ *             - 3 client is not opened
+ *             - 4 nothing is published
+ * @note       lock free, the read retries while the daemon is updating
+ */
+uint8_t ds3231_service_client_read(ds3231_service_client_t *client, ds3231_service_data_t *data)
+{
+    uint32_t sequence;
+    
+    if ((client == NULL) || (data == NULL))
+    {
+        return 2;
+    }
+    if (client->shm == NULL)
+    {
+        return 3;
+    }
+    
+    /* plain loads, retried while the sequence is odd or changed */
+    do
+    {
+        sequence = client->shm->sequence;
+        DS3231_SERVICE_BARRIER();
+        data->timestamp = client->shm->data.timestamp;
+        data->anchor_ns = client->shm->data.anchor_ns;
+        data->update = client->shm->data.update;
+        data->temperature = client->shm->data.temperature;
+        data->status = client->shm->data.status;
+        DS3231_SERVICE_BARRIER();
+    } while (((sequence & 1) != 0) || (sequence != client->shm->sequence));
+    if (data->update == 0)
+    {
+        return 4;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      get the current time
+ * @param[in]  *client pointer to a client structure
+ * @param[out] *timestamp pointer to a unix timestamp buffer
+ * @param[out] *ns pointer to a nanosecond buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 client or buffer is NULL
+ *             - 3 client is not opened
+ *             - 4 nothing is published
+ *             - 5 data is stale
+ * @note       the time is extrapolated from the last edge with CLOCK_MONOTONIC,
+ *             which is served by the vdso, so no system call is made
+ */
+uint8_t ds3231_service_client_get_time(ds3231_service_client_t *client, int64_t *timestamp, uint32_t *ns)
+{
+    uint8_t res;
+    uint64_t now;
+    uint64_t elapsed;
+    struct timespec ts;
+    ds3231_service_data_t data;
+    
+    if ((timestamp == NULL) || (ns == NULL))
+    {
+        return 2;
+    }
+    
+    /* load the last edge */
+    res = ds3231_service_client_read(client, &data);
+    if (res != 0)
+    {
+        return res;
+    }
+    
+    /* extrapolate from the edge */
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    now = (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+    elapsed = (now > data.anchor_ns) ? (now - data.anchor_ns) : 0;
+    if (elapsed > DS3231_SERVICE_STALE_NS)
+    {
+        return 5;
+    }
+    *timestamp = data.timestamp + (int64_t)(elapsed / 1000000000ULL);
+    *ns = (uint32_t)(elapsed % 1000000000ULL);
+    
+    return 0;
+}
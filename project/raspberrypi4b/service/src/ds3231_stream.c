@@ -0,0 +1,178 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      ds3231_stream.c
+ * @brief     ds3231 stream source file
+ * @version   1.0.0
+ * @author    Shifeng Li
+ * @date      2022-11-11
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2022/11/11  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "ds3231_stream.h"
+#include "driver_ds3231_basic.h"
+
+static FILE *gs_fp = NULL;                                          /**< output file */
+static ds3231_stream_format_t gs_format;                            /**< output format */
+static uint32_t gs_sequence = 0;                                    /**< written records */
+static char gs_buffer[DS3231_STREAM_BUFFER_SIZE];                   /**< output buffer */
+
+/**
+ * @brief     put a little endian value
+ * @param[in] *buf pointer to a buffer
+ * @param[in] value written value
+ * @param[in] len value length in bytes
+ * @note      none
+ */
+static void a_ds3231_stream_put(uint8_t *buf, uint64_t value, uint8_t len)
+{
+    uint8_t i;
+    
+    for (i = 0; i < len; i++)
+    {
+        buf[i] = (uint8_t)(value >> (i * 8));
+    }
+}
+
+/**
+ * @brief     stream init
+ * @param[in] *fp pointer to an output file
+ * @param[in] format output format
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      call it before any other input or output on fp, the buffer is kept until fp is closed,
+ *            the binary record is u64 host unix ns, u16 year, u8 month, date, hour in 24h, minute, second, week,
+ *            u8 status, u8 control, s16 temperature register (1/256C) and u32 sequence
+ */
+uint8_t ds3231_stream_init(FILE *fp, ds3231_stream_format_t format)
+{
+    /* one write per full buffer */
+    if (setvbuf(fp, gs_buffer, _IOFBF, DS3231_STREAM_BUFFER_SIZE) != 0)
+    {
+        return 1;
+    }
+    gs_fp = fp;
+    gs_format = format;
+    gs_sequence = 0;
+    
+    /* write the header */
+    if (format == DS3231_STREAM_FORMAT_CSV)
+    {
+        (void)fprintf(gs_fp, "host_ns,time,status,control,temperature\n");
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  stream deinit
+ * @return status code
+ *         - 0 success
+ *         - 1 flush failed
+ * @note   none
+ */
+uint8_t ds3231_stream_deinit(void)
+{
+    uint8_t res;
+    
+    if (gs_fp == NULL)
+    {
+        return 0;
+    }
+    
+    /* flush the last records */
+    res = (fflush(gs_fp) != 0) ? 1 : 0;
+    gs_fp = NULL;
+    
+    return res;
+}
+
+/**
+ * @brief     stream take one sample
+ * @param[in] host_ns host unix timestamp of the sample in nanoseconds
+ * @return    status code
+ *            - 0 success
+ *            - 1 sample failed
+ * @note      the device must be initialized with ds3231_basic_init_keep_aging,
+ *            one snapshot transaction per sample, the record is buffered
+ */
+uint8_t ds3231_stream_sample(uint64_t host_ns)
+{
+    uint8_t hour;
+    uint8_t record[DS3231_STREAM_RECORD_SIZE];
+    ds3231_snapshot_t snapshot;
+    
+    /* read the registers */
+    if (ds3231_basic_read_snapshot(&snapshot) != 0)
+    {
+        return 1;
+    }
+    
+    /* all formats use the 24 hour clock */
+    hour = snapshot.time.hour;
+    if (snapshot.time.format == DS3231_FORMAT_12H)
+    {
+        hour = (uint8_t)((hour % 12) + ((snapshot.time.am_pm == DS3231_PM) ? 12 : 0));
+    }
+    
+    /* write the record */
+    if (gs_format == DS3231_STREAM_FORMAT_CSV)
+    {
+        (void)fprintf(gs_fp, "%llu,%04d-%02d-%02d %02d:%02d:%02d,0x%02X,0x%02X,%0.2f\n",
+                      (unsigned long long)host_ns, snapshot.time.year, snapshot.time.month, snapshot.time.date,
+                      hour, snapshot.time.minute, snapshot.time.second,
+                      snapshot.status, snapshot.control, snapshot.temperature);
+    }
+    else if (gs_format == DS3231_STREAM_FORMAT_NDJSON)
+    {
+        (void)fprintf(gs_fp, "{\"host_ns\":%llu,\"time\":\"%04d-%02d-%02d %02d:%02d:%02d\",\"status\":%d,\"control\":%d,\"temperature\":%0.2f}\n",
+                      (unsigned long long)host_ns, snapshot.time.year, snapshot.time.month, snapshot.time.date,
+                      hour, snapshot.time.minute, snapshot.time.second,
+                      snapshot.status, snapshot.control, snapshot.temperature);
+    }
+    else
+    {
+        a_ds3231_stream_put(&record[0], host_ns, 8);
+        a_ds3231_stream_put(&record[8], snapshot.time.year, 2);
+        record[10] = snapshot.time.month;
+        record[11] = snapshot.time.date;
+        record[12] = hour;
+        record[13] = snapshot.time.minute;
+        record[14] = snapshot.time.second;
+        record[15] = snapshot.time.week;
+        record[16] = snapshot.status;
+        record[17] = snapshot.control;
+        a_ds3231_stream_put(&record[18], (uint16_t)snapshot.raw_temperature, 2);
+        a_ds3231_stream_put(&record[20], gs_sequence, 4);
+        (void)fwrite(record, 1, DS3231_STREAM_RECORD_SIZE, gs_fp);
+    }
+    gs_sequence++;
+    
+    return (ferror(gs_fp) != 0) ? 1 : 0;
+}
@@ -38,17 +38,111 @@
 #include "driver_ds3231_readwrite_test.h"
 #include "driver_ds3231_alarm_test.h"
 #include "driver_ds3231_output_test.h"
+#include "driver_ds3231_calendar_test.h"
+#include "driver_ds3231_simulator.h"
 #include "driver_ds3231_basic.h"
 #include "driver_ds3231_alarm.h"
 #include "driver_ds3231_output.h"
+#include "driver_ds3231_clock.h"
+#include "driver_ds3231_scheduler.h"
+#include "driver_ds3231_calibration.h"
+#include "driver_ds3231_bench.h"
+#include "ds3231_service.h"
+#include "ds3231_server.h"
+#include "ds3231_stream.h"
 #include "gpio.h"
 #include <getopt.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
 
 /**
  * @brief global var definition
  */
-uint8_t (*g_gpio_irq)(void) = NULL;        /**< gpio irq function address */
+uint8_t (*g_gpio_irq)(void) = NULL;                                 /**< gpio irq function address */
+uint8_t (*g_gpio_irq_edge)(uint64_t timestamp_ns) = NULL;           /**< gpio irq with the edge timestamp */
+
+/**
+ * @brief  get the monotonic time
+ * @return monotonic time in microseconds
+ * @note   none
+ */
+static uint64_t a_clock_monotonic_us(void)
+{
+    struct timespec ts;
+    
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    
+    return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
+}
+
+/**
+ * @brief     clock square wave irq handler
+ * @param[in] timestamp_ns kernel monotonic timestamp of the edge in nanoseconds
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      none
+ */
+static uint8_t a_clock_irq_handler(uint64_t timestamp_ns)
+{
+    return ds3231_clock_edge(timestamp_ns / 1000);
+}
+
+/**
+ * @brief     calibration square wave irq handler
+ * @param[in] timestamp_ns kernel monotonic timestamp of the edge in nanoseconds
+ * @return    status code
+ *            - 0 success
+ * @note      the samples must be taken with the same clock
+ */
+static uint8_t a_calibration_irq_handler(uint64_t timestamp_ns)
+{
+    return ds3231_calibration_edge(timestamp_ns / 1000);
+}
+
+/**
+ * @brief     service square wave irq handler
+ * @param[in] timestamp_ns kernel monotonic timestamp of the edge in nanoseconds
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ * @note      the clients extrapolate with the same clock
+ */
+static uint8_t a_service_irq_handler(uint64_t timestamp_ns)
+{
+    return ds3231_service_edge(timestamp_ns);
+}
+
+static volatile sig_atomic_t gs_stop = 0;        /**< stop request */
+
+/**
+ * @brief     stop signal handler
+ * @param[in] sig signal number
+ * @note      none
+ */
+static void a_stop_handler(int sig)
+{
+    (void)sig;
+    gs_stop = 1;
+}
+
+static uint32_t gs_scheduler_fired = 0;        /**< scheduler fired timers */
+
+/**
+ * @brief     scheduler timer callback
+ * @param[in] id timer id
+ * @param[in] *arg pointer to the deadline
+ * @note      none
+ */
+static void a_scheduler_callback(uint16_t id, void *arg)
+{
+    gs_scheduler_fired++;
+    ds3231_interface_debug_print("ds3231: timer %d deadline %lld fired.\n", id, (long long)(*(int64_t *)arg));
+}
 
 /**
  * @brief     interface receive callback
@@ -94,12 +188,13 @@ uint8_t ds3231(uint8_t argc, char **argv)
 {
     int c;
     int longindex = 0;
-    const char short_options[] = "hipe:t:";
+    const char short_options[] = "hipbe:t:";
     const struct option long_options[] =
     {
         {"help", no_argument, NULL, 'h'},
         {"information", no_argument, NULL, 'i'},
         {"port", no_argument, NULL, 'p'},
+        {"bench", no_argument, NULL, 'b'},
         {"example", required_argument, NULL, 'e'},
         {"test", required_argument, NULL, 't'},
         {"enable", required_argument, NULL, 1},
@@ -107,11 +202,18 @@ uint8_t ds3231(uint8_t argc, char **argv)
         {"mode2", required_argument, NULL, 3},
         {"times", required_argument, NULL, 4},
         {"timestamp", required_argument, NULL, 5},
+        {"simulate", no_argument, NULL, 6},
+        {"file", required_argument, NULL, 7},
+        {"daemon", optional_argument, NULL, 8},
+        {"serve", optional_argument, NULL, 9},
+        {"stream", required_argument, NULL, 10},
+        {"rate", required_argument, NULL, 11},
         {NULL, 0, NULL, 0},
     };
     char type[33] = "unknown";
     char mode_name[32] = {0};
     uint32_t times = 3;
+    uint8_t times_flag = 0;
     uint32_t t = 0;
     uint8_t time_flag = 0;
     ds3231_bool_t enable = DS3231_BOOL_FALSE;
@@ -120,6 +222,13 @@ uint8_t ds3231(uint8_t argc, char **argv)
     uint8_t mode1_flag = 0;
     ds3231_alarm2_mode_t mode2 = DS3231_ALARM2_MODE_ONCE_A_MINUTE;
     uint8_t mode2_flag = 0;
+    char file[256] = {0};
+    uint8_t file_flag = 0;
+    char name[256] = DS3231_SERVICE_DEFAULT_NAME;
+    char path[108] = DS3231_SERVER_DEFAULT_PATH;
+    ds3231_stream_format_t format = DS3231_STREAM_FORMAT_CSV;
+    uint32_t rate = 1;
+    uint8_t rate_flag = 0;
     
     /* if no params */
     if (argc == 1)
@@ -170,6 +279,16 @@ uint8_t ds3231(uint8_t argc, char **argv)
                 break;
             }
             
+            /* bench */
+            case 'b' :
+            {
+                /* set the type */
+                memset(type, 0, sizeof(char) * 33);
+                snprintf(type, 32, "b");
+                
+                break;
+            }
+            
             /* example */
             case 'e' :
             {
@@ -307,6 +426,7 @@ uint8_t ds3231(uint8_t argc, char **argv)
             {
                 /* set the times */
                 times = atol(optarg);
+                times_flag = 1;
                 
                 break;
             } 
@@ -321,6 +441,109 @@ uint8_t ds3231(uint8_t argc, char **argv)
                 break;
             }
             
+            /* simulate */
+            case 6 :
+            {
+                /* link the tests to the simulated device */
+                (void)ds3231_simulator_enable(1);
+                
+                break;
+            }
+            
+            /* file */
+            case 7 :
+            {
+                /* set the file path */
+                memset(file, 0, sizeof(char) * 256);
+                strncpy(file, optarg, 255);
+                file_flag = 1;
+                
+                break;
+            }
+            
+            /* daemon */
+            case 8 :
+            {
+                /* set the type */
+                memset(type, 0, sizeof(char) * 33);
+                snprintf(type, 32, "d");
+                
+                /* set the shared memory name */
+                if (optarg != NULL)
+                {
+                    memset(name, 0, sizeof(char) * 256);
+                    strncpy(name, optarg, 255);
+                }
+                
+                break;
+            }
+            
+            /* serve */
+            case 9 :
+            {
+                /* set the type */
+                memset(type, 0, sizeof(char) * 33);
+                snprintf(type, 32, "s");
+                
+                /* set the socket path */
+                if (optarg != NULL)
+                {
+                    memset(path, 0, sizeof(char) * 108);
+                    strncpy(path, optarg, 107);
+                }
+                
+                break;
+            }
+            
+            /* stream */
+            case 10 :
+            {
+                /* set the type */
+                memset(type, 0, sizeof(char) * 33);
+                snprintf(type, 32, "stream");
+                
+                /* set the format */
+                if (strcmp("csv", optarg) == 0)
+                {
+                    format = DS3231_STREAM_FORMAT_CSV;
+                }
+                else if (strcmp("ndjson", optarg) == 0)
+                {
+                    format = DS3231_STREAM_FORMAT_NDJSON;
+                }
+                else if (strcmp("binary", optarg) == 0)
+                {
+                    format = DS3231_STREAM_FORMAT_BINARY;
+                }
+                else
+                {
+                    return 5;
+                }
+                
+                break;
+            }
+            
+            /* rate */
+            case 11 :
+            {
+                /* set the rate, 0 samples on every square wave edge */
+                if (strcmp("sqw", optarg) == 0)
+                {
+                    rate = 0;
+                }
+                else
+                {
+                    rate = (uint32_t)atol(optarg);
+                    if ((rate == 0) || (rate > 10000))
+                    {
+                        return 5;
+                    }
+                }
+                rate_flag = 1;
+                
+                break;
+            }
+            
             /* the end */
             case -1 :
             {
@@ -384,6 +607,30 @@ uint8_t ds3231(uint8_t argc, char **argv)
             return 0;
         }
     }
+    else if (strcmp("t_calendar", type) == 0)
+    {
+        /* run calendar test */
+        if (ds3231_calendar_test() != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    else if (strcmp("b", type) == 0)
+    {
+        /* run the bench */
+        if (ds3231_bench_run((times_flag != 0) ? times : DS3231_BENCH_DEFAULT_TIMES) != 0)
+        {
+            return 1;
+        }
+        else
+        {
+            return 0;
+        }
+    }
     else if (strcmp("e_basic-set-time", type) == 0)
     {
         uint8_t res;
@@ -1221,6 +1468,685 @@ uint8_t ds3231(uint8_t argc, char **argv)
         
         return 0;
     }
+    else if (strcmp("e_clock-get-time", type) == 0)
+    {
+        uint8_t res;
+        uint32_t i;
+        uint32_t us;
+        int64_t timestamp;
+        
+        /* clock init */
+        res = ds3231_clock_init();
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        /* gpio init */
+        res = gpio_interrupt_init();
+        if (res != 0)
+        {
+            (void)ds3231_clock_deinit();
+            
+            return 1;
+        }
+        
+        /* set gpio callback */
+        g_gpio_irq_edge = a_clock_irq_handler;
+        
+        /* wait for the square wave edges */
+        ds3231_interface_delay_ms(2500);
+        
+        for (i = 0; i < times; i++)
+        {
+            /* get the interpolated time */
+            res = ds3231_clock_get_time(a_clock_monotonic_us(), &timestamp, &us);
+            if (res != 0)
+            {
+                ds3231_interface_debug_print("ds3231: clock is not synchronized.\n");
+                (void)gpio_interrupt_deinit();
+                g_gpio_irq_edge = NULL;
+                (void)ds3231_clock_deinit();
+                
+                return 1;
+            }
+            
+            /* output */
+            ds3231_interface_debug_print("ds3231: clock timestamp %lld.%06u.\n", (long long)timestamp, (unsigned int)us);
+            
+            /* delay 250ms */
+            ds3231_interface_delay_ms(250);
+        }
+        
+        /* gpio deinit */
+        (void)gpio_interrupt_deinit();
+        g_gpio_irq_edge = NULL;
+        
+        /* clock deinit */
+        (void)ds3231_clock_deinit();
+        
+        return 0;
+    }
+    else if (strcmp("e_scheduler-run", type) == 0)
+    {
+        uint8_t res;
+        uint32_t i;
+        uint32_t timeout;
+        uint32_t count;
+        int fd;
+        struct pollfd pfd;
+        uint16_t id;
+        uint16_t fired;
+        int64_t now;
+        int64_t *deadline;
+        
+        /* scheduler init */
+        res = ds3231_scheduler_init();
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        /* deadline buffer */
+        deadline = (int64_t *)malloc(sizeof(int64_t) * (times + 1));
+        if (deadline == NULL)
+        {
+            (void)ds3231_scheduler_deinit();
+            
+            return 1;
+        }
+        
+        /* gpio event init */
+        res = gpio_interrupt_event_init(&fd);
+        if (res != 0)
+        {
+            free(deadline);
+            (void)ds3231_scheduler_deinit();
+            
+            return 1;
+        }
+        
+        /* set gpio callback */
+        gs_scheduler_fired = 0;
+        g_gpio_irq = ds3231_scheduler_irq_handler;
+        
+        /* get the current time */
+        res = ds3231_scheduler_get_timestamp(&now);
+        if (res != 0)
+        {
+            ds3231_interface_debug_print("ds3231: get timestamp failed.\n");
+            (void)gpio_interrupt_event_deinit();
+            g_gpio_irq = NULL;
+            free(deadline);
+            (void)ds3231_scheduler_deinit();
+            
+            return 1;
+        }
+        
+        /* two timers share every second */
+        for (i = 0; i < times; i++)
+        {
+            deadline[i] = now + 2 + i / 2;
+            res = ds3231_scheduler_add(deadline[i], a_scheduler_callback, &deadline[i], &id);
+            if (res != 0)
+            {
+                ds3231_interface_debug_print("ds3231: add timer failed.\n");
+                (void)gpio_interrupt_event_deinit();
+                g_gpio_irq = NULL;
+                free(deadline);
+                (void)ds3231_scheduler_deinit();
+                
+                return 1;
+            }
+        }
+        ds3231_interface_debug_print("ds3231: %d timers added.\n", times);
+        
+        /* wait for the line in the main thread and run the timers on every wake up */
+        pfd.fd = fd;
+        pfd.events = POLLIN;
+        timeout = times / 2 + 5;
+        while ((gs_scheduler_fired < times) && (timeout != 0))
+        {
+            if (poll(&pfd, 1, 1000) <= 0)
+            {
+                timeout--;
+                
+                continue;
+            }
+            
+            /* drain the edges and clear the alarm flag */
+            res = gpio_interrupt_event_handler(&count);
+            if ((res != 0) || (count == 0))
+            {
+                timeout--;
+                
+                continue;
+            }
+            
+            /* run the expired timers */
+            res = ds3231_scheduler_dispatch(&fired);
+            if (res != 0)
+            {
+                ds3231_interface_debug_print("ds3231: dispatch failed.\n");
+                (void)gpio_interrupt_event_deinit();
+                g_gpio_irq = NULL;
+                free(deadline);
+                (void)ds3231_scheduler_deinit();
+                
+                return 1;
+            }
+            ds3231_interface_debug_print("ds3231: wake up with %d timers.\n", fired);
+        }
+        
+        /* gpio event deinit */
+        (void)gpio_interrupt_event_deinit();
+        g_gpio_irq = NULL;
+        free(deadline);
+        
+        /* scheduler deinit */
+        (void)ds3231_scheduler_deinit();
+        
+        if (gs_scheduler_fired < times)
+        {
+            ds3231_interface_debug_print("ds3231: scheduler timeout.\n");
+            
+            return 1;
+        }
+        
+        return 0;
+    }
+    else if (strcmp("e_calibration-run", type) == 0)
+    {
+        uint8_t res;
+        uint32_t window;
+        uint32_t timeout;
+        uint32_t edges;
+        float ppm;
+        float sigma;
+        int8_t offset;
+        FILE *fp;
+        
+        /* calibration init */
+        res = ds3231_calibration_init();
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        /* gpio init */
+        res = gpio_interrupt_init();
+        if (res != 0)
+        {
+            (void)ds3231_calibration_deinit();
+            
+            return 1;
+        }
+        
+        /* set gpio callback */
+        g_gpio_irq_edge = a_calibration_irq_handler;
+        
+        /* fit the drift over the window */
+        window = (times_flag != 0) ? times : DS3231_CALIBRATION_DEFAULT_WINDOW;
+        timeout = window + 10;
+        edges = 0;
+        (void)ds3231_calibration_start();
+        while ((edges < window) && (timeout != 0))
+        {
+            ds3231_interface_delay_ms(1000);
+            timeout--;
+            if (ds3231_calibration_get_drift(&ppm, &sigma, &edges) != 0)
+            {
+                continue;
+            }
+            if ((edges % 60) == 0)
+            {
+                ds3231_interface_debug_print("ds3231: %d edges drift %0.3fppm sigma %0.3fppm.\n", edges, ppm, sigma);
+            }
+        }
+        
+        /* gpio deinit */
+        (void)gpio_interrupt_deinit();
+        g_gpio_irq_edge = NULL;
+        if (edges < window)
+        {
+            ds3231_interface_debug_print("ds3231: square wave timeout.\n");
+            (void)ds3231_calibration_deinit();
+            
+            return 1;
+        }
+        ds3231_interface_debug_print("ds3231: drift is %0.3fppm sigma %0.3fppm over %d edges.\n", ppm, sigma, edges);
+        
+        /* write the aging offset */
+        res = ds3231_calibration_apply(&offset);
+        if (res != 0)
+        {
+            (void)ds3231_calibration_deinit();
+            
+            return 1;
+        }
+        ds3231_interface_debug_print("ds3231: set aging offset %d.\n", offset);
+        
+        /* save the offset */
+        if (file_flag != 0)
+        {
+            fp = fopen(file, "w");
+            if (fp == NULL)
+            {
+                ds3231_interface_debug_print("ds3231: open %s failed.\n", file);
+                (void)ds3231_calibration_deinit();
+                
+                return 1;
+            }
+            (void)fprintf(fp, "%d\n", offset);
+            (void)fclose(fp);
+            ds3231_interface_debug_print("ds3231: save aging offset to %s.\n", file);
+        }
+        
+        /* calibration deinit */
+        (void)ds3231_calibration_deinit();
+        
+        return 0;
+    }
+    else if (strcmp("e_calibration-model", type) == 0)
+    {
+        uint8_t res;
+        uint32_t samples;
+        uint32_t count;
+        uint32_t i;
+        float coefficient[3];
+        int32_t correction;
+        static ds3231_calibration_sample_t history[DS3231_CALIBRATION_HISTORY_SIZE];
+        
+        /* calibration init */
+        res = ds3231_calibration_init();
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        /* gpio init */
+        res = gpio_interrupt_init();
+        if (res != 0)
+        {
+            (void)ds3231_calibration_deinit();
+            
+            return 1;
+        }
+        
+        /* set gpio callback */
+        g_gpio_irq_edge = a_calibration_irq_handler;
+        
+        /* sample once per temperature conversion */
+        samples = (times_flag != 0) ? times : DS3231_CALIBRATION_HISTORY_SIZE;
+        (void)ds3231_calibration_start();
+        for (i = 0; i < samples; i++)
+        {
+            ds3231_interface_delay_ms(DS3231_CALIBRATION_SAMPLE_INTERVAL_S * 1000);
+            res = ds3231_calibration_sample(a_clock_monotonic_us());
+            if (res != 0)
+            {
+                (void)gpio_interrupt_deinit();
+                g_gpio_irq_edge = NULL;
+                (void)ds3231_calibration_deinit();
+                
+                return 1;
+            }
+            ds3231_interface_debug_print("ds3231: sample %d/%d.\n", i + 1, samples);
+        }
+        
+        /* gpio deinit */
+        (void)gpio_interrupt_deinit();
+        g_gpio_irq_edge = NULL;
+        
+        /* print the history */
+        (void)ds3231_calibration_get_history(history, DS3231_CALIBRATION_HISTORY_SIZE, &count);
+        for (i = 0; i < count; i++)
+        {
+            if (history[i].valid != 0)
+            {
+                ds3231_interface_debug_print("ds3231: %0.2fC drift %0.3fppm.\n", history[i].temperature, history[i].ppm);
+            }
+        }
+        
+        /* fit the curve */
+        res = ds3231_calibration_fit_temperature(coefficient);
+        if (res != 0)
+        {
+            (void)ds3231_calibration_deinit();
+            
+            return 1;
+        }
+        ds3231_interface_debug_print("ds3231: drift is %0.4f + %0.4f*(t-25) + %0.5f*(t-25)^2 ppm.\n",
+                                     coefficient[0], coefficient[1], coefficient[2]);
+        if (count != 0)
+        {
+            (void)ds3231_calibration_predict(history[count - 1].temperature, 86400, &correction);
+            ds3231_interface_debug_print("ds3231: correction is %dus per day at %0.2fC.\n",
+                                         correction, history[count - 1].temperature);
+        }
+        
+        /* calibration deinit */
+        (void)ds3231_calibration_deinit();
+        
+        return 0;
+    }
+    else if (strcmp("e_calibration-restore", type) == 0)
+    {
+        uint8_t res;
+        int value;
+        FILE *fp;
+        
+        /* check the flag */
+        if (file_flag != 1)
+        {
+            return 5;
+        }
+        
+        /* load the offset */
+        fp = fopen(file, "r");
+        if (fp == NULL)
+        {
+            ds3231_interface_debug_print("ds3231: open %s failed.\n", file);
+            
+            return 1;
+        }
+        if ((fscanf(fp, "%d", &value) != 1) || (value < -128) || (value > 127))
+        {
+            ds3231_interface_debug_print("ds3231: %s is invalid.\n", file);
+            (void)fclose(fp);
+            
+            return 1;
+        }
+        (void)fclose(fp);
+        
+        /* calibration init */
+        res = ds3231_calibration_init();
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        /* restore the offset */
+        res = ds3231_calibration_restore((int8_t)value);
+        if (res != 0)
+        {
+            (void)ds3231_calibration_deinit();
+            
+            return 1;
+        }
+        ds3231_interface_debug_print("ds3231: restore aging offset %d.\n", value);
+        
+        /* calibration deinit */
+        (void)ds3231_calibration_deinit();
+        
+        return 0;
+    }
+    else if (strcmp("d", type) == 0)
+    {
+        uint8_t res;
+        uint32_t count;
+        uint32_t lost;
+        int fd;
+        struct pollfd pfd;
+        
+        /* service init */
+        res = ds3231_service_init(name);
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        /* gpio event init */
+        res = gpio_interrupt_event_init(&fd);
+        if (res != 0)
+        {
+            (void)ds3231_service_deinit();
+            
+            return 1;
+        }
+        
+        /* set gpio callback */
+        g_gpio_irq_edge = a_service_irq_handler;
+        
+        /* stop on the signals */
+        gs_stop = 0;
+        (void)signal(SIGINT, a_stop_handler);
+        (void)signal(SIGTERM, a_stop_handler);
+        ds3231_interface_debug_print("ds3231: publish to %s.\n", name);
+        
+        /* publish on every edge */
+        pfd.fd = fd;
+        pfd.events = POLLIN;
+        lost = 0;
+        while (gs_stop == 0)
+        {
+            if (poll(&pfd, 1, 2000) <= 0)
+            {
+                /* report the lost square wave once */
+                if ((gs_stop == 0) && (lost == 0))
+                {
+                    ds3231_interface_debug_print("ds3231: square wave is lost.\n");
+                }
+                lost = 1;
+                
+                continue;
+            }
+            
+            /* drain the edges and publish */
+            res = gpio_interrupt_event_handler(&count);
+            if ((res != 0) || (count == 0))
+            {
+                continue;
+            }
+            lost = 0;
+        }
+        
+        /* gpio event deinit */
+        (void)gpio_interrupt_event_deinit();
+        g_gpio_irq_edge = NULL;
+        
+        /* service deinit */
+        (void)ds3231_service_deinit();
+        ds3231_interface_debug_print("ds3231: stop publishing.\n");
+        
+        return 0;
+    }
+    else if (strcmp("s", type) == 0)
+    {
+        uint8_t res;
+        
+        /* server init */
+        res = ds3231_server_init(path);
+        if (res != 0)
+        {
+            return 1;
+        }
+        
+        /* stop on the signals */
+        gs_stop = 0;
+        (void)signal(SIGINT, a_stop_handler);
+        (void)signal(SIGTERM, a_stop_handler);
+        ds3231_interface_debug_print("ds3231: serve on %s.\n", path);
+        
+        /* answer the requests */
+        while (gs_stop == 0)
+        {
+            res = ds3231_server_poll(1000);
+            if (res != 0)
+            {
+                (void)ds3231_server_deinit();
+                
+                return 1;
+            }
+        }
+        
+        /* server deinit */
+        (void)ds3231_server_deinit();
+        ds3231_interface_debug_print("ds3231: stop serving.\n");
+        
+        return 0;
+    }
+    else if (strcmp("stream", type) == 0)
+    {
+        uint8_t res;
+        uint32_t i;
+        uint32_t count;
+        int fd;
+        uint64_t period;
+        uint64_t next;
+        uint64_t now;
+        struct pollfd pfd;
+        struct timespec ts;
+        FILE *fp;
+        
+        /* open the output */
+        if (file_flag != 0)
+        {
+            fp = fopen(file, "wb");
+            if (fp == NULL)
+            {
+                ds3231_interface_debug_print("ds3231: open %s failed.\n", file);
+                
+                return 1;
+            }
+        }
+        else
+        {
+            /* the records keep a copy of stdout and the messages move to stderr */
+            fd = dup(STDOUT_FILENO);
+            fp = (fd >= 0) ? fdopen(fd, "wb") : NULL;
+            if ((fp == NULL) || (dup2(STDERR_FILENO, STDOUT_FILENO) < 0))
+            {
+                ds3231_interface_debug_print("ds3231: open stdout failed.\n");
+                if (fp != NULL)
+                {
+                    (void)fclose(fp);
+                }
+                else if (fd >= 0)
+                {
+                    (void)close(fd);
+                }
+                
+                return 1;
+            }
+        }
+        
+        /* stream init before any output */
+        res = ds3231_stream_init(fp, format);
+        if (res != 0)
+        {
+            (void)fclose(fp);
+            
+            return 1;
+        }
+        
+        /* basic init */
+        res = ds3231_basic_init_keep_aging();
+        if (res != 0)
+        {
+            (void)ds3231_stream_deinit();
+            (void)fclose(fp);
+            
+            return 1;
+        }
+        
+        /* gpio event init, the edges are only drained */
+        fd = -1;
+        if ((rate_flag != 0) && (rate == 0))
+        {
+            /* sample once per second */
+            res = ds3231_basic_set_square_wave_frequency(DS3231_SQUARE_WAVE_FREQUENCY_1HZ);
+            if (res != 0)
+            {
+                (void)ds3231_stream_deinit();
+                (void)ds3231_basic_deinit();
+                (void)fclose(fp);
+                
+                return 1;
+            }
+            res = gpio_interrupt_event_init(&fd);
+            if (res != 0)
+            {
+                (void)ds3231_stream_deinit();
+                (void)ds3231_basic_deinit();
+                (void)fclose(fp);
+                
+                return 1;
+            }
+            g_gpio_irq = NULL;
+            pfd.fd = fd;
+            pfd.events = POLLIN;
+        }
+        
+        /* stop on the signals */
+        gs_stop = 0;
+        (void)signal(SIGINT, a_stop_handler);
+        (void)signal(SIGTERM, a_stop_handler);
+        
+        /* sample until the times or a signal */
+        period = (rate != 0) ? (1000000000ULL / rate) : 0;
+        (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+        next = (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+        res = 0;
+        for (i = 0; (gs_stop == 0) && ((times_flag == 0) || (i < times)); i++)
+        {
+            if (fd >= 0)
+            {
+                /* wait for the edge */
+                if (poll(&pfd, 1, 2000) <= 0)
+                {
+                    i--;
+                    
+                    continue;
+                }
+                (void)gpio_interrupt_event_handler(&count);
+                if (count == 0)
+                {
+                    i--;
+                    
+                    continue;
+                }
+            }
+            else
+            {
+                /* absolute deadlines do not drift, a late sample restarts the schedule */
+                next += period;
+                ts.tv_sec = (time_t)(next / 1000000000ULL);
+                ts.tv_nsec = (long)(next % 1000000000ULL);
+                (void)clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+                (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+                now = (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+                if (now > next + period)
+                {
+                    next = now;
+                }
+            }
+            
+            /* one snapshot per sample */
+            (void)clock_gettime(CLOCK_REALTIME, &ts);
+            res = ds3231_stream_sample((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec);
+            if (res != 0)
+            {
+                break;
+            }
+        }
+        
+        /* gpio event deinit */
+        if (fd >= 0)
+        {
+            (void)gpio_interrupt_event_deinit();
+        }
+        
+        /* flush the records */
+        if (ds3231_stream_deinit() != 0)
+        {
+            res = 1;
+        }
+        (void)ds3231_basic_deinit();
+        (void)fclose(fp);
+        
+        return (res != 0) ? 1 : 0;
+    }
     else if (strcmp("h", type) == 0)
     {
         help:
@@ -1228,10 +2154,15 @@ uint8_t ds3231(uint8_t argc, char **argv)
         ds3231_interface_debug_print("  ds3231 (-i | --information)\n");
         ds3231_interface_debug_print("  ds3231 (-h | --help)\n");
         ds3231_interface_debug_print("  ds3231 (-p | --port)\n");
-        ds3231_interface_debug_print("  ds3231 (-t reg | --test=reg)\n");
-        ds3231_interface_debug_print("  ds3231 (-t alarm | --test=alarm)\n");
-        ds3231_interface_debug_print("  ds3231 (-t readwrite | --test=readwrite) [--times=<num>]\n");
-        ds3231_interface_debug_print("  ds3231 (-t output | --test=output) [--times=<num>]\n");
+        ds3231_interface_debug_print("  ds3231 (-b | --bench) [--times=<num>]\n");
+        ds3231_interface_debug_print("  ds3231 --daemon[=<name>]\n");
+        ds3231_interface_debug_print("  ds3231 --serve[=<path>]\n");
+        ds3231_interface_debug_print("  ds3231 --stream=<csv | ndjson | binary> [--rate=<hz | sqw>] [--times=<num>] [--file=<path>]\n");
+        ds3231_interface_debug_print("  ds3231 (-t reg | --test=reg) [--simulate]\n");
+        ds3231_interface_debug_print("  ds3231 (-t alarm | --test=alarm) [--simulate]\n");
+        ds3231_interface_debug_print("  ds3231 (-t readwrite | --test=readwrite) [--times=<num>] [--simulate]\n");
+        ds3231_interface_debug_print("  ds3231 (-t output | --test=output) [--times=<num>] [--simulate]\n");
+        ds3231_interface_debug_print("  ds3231 (-t calendar | --test=calendar) [--simulate]\n");
         ds3231_interface_debug_print("  ds3231 (-e basic-set-time | --example=basic-set-time) --timestamp=<time>\n");
         ds3231_interface_debug_print("  ds3231 (-e basic-get-time | --example=basic-get-time)\n");
         ds3231_interface_debug_print("  ds3231 (-e basic-get-temperature | --example=basic-get-temperature)\n");
@@ -1253,16 +2184,26 @@ uint8_t ds3231(uint8_t argc, char **argv)
         ds3231_interface_debug_print("  ds3231 (-e output-get-1Hz | --example=output-get-1Hz)\n");
         ds3231_interface_debug_print("  ds3231 (-e output-get-32KHz | --example=output-get-32KHz)\n");
         ds3231_interface_debug_print("  ds3231 (-e output-get-temperature | --example=output-get-temperature)\n");
+        ds3231_interface_debug_print("  ds3231 (-e clock-get-time | --example=clock-get-time) [--times=<num>]\n");
+        ds3231_interface_debug_print("  ds3231 (-e scheduler-run | --example=scheduler-run) [--times=<num>]\n");
+        ds3231_interface_debug_print("  ds3231 (-e calibration-run | --example=calibration-run) [--times=<num>] [--file=<path>]\n");
+        ds3231_interface_debug_print("  ds3231 (-e calibration-restore | --example=calibration-restore) --file=<path>\n");
+        ds3231_interface_debug_print("  ds3231 (-e calibration-model | --example=calibration-model) [--times=<num>]\n");
         ds3231_interface_debug_print("\n");
         ds3231_interface_debug_print("Options:\n");
+        ds3231_interface_debug_print("  -b, --bench                     Run the driver bench on the simulated device and print json lines.\n");
+        ds3231_interface_debug_print("      --daemon[=<name>]           Publish the time to the shared memory until a signal, name defaults to /ds3231.\n");
         ds3231_interface_debug_print("  -e <basic-set-time | basic-get-time | basic-get-temperature | alarm-set-time | alarm-set-alarm1 | alarm-set-alarm2 | alarm-set-alarm1-mode\n");
         ds3231_interface_debug_print("     | alarm-set-alarm2-mode | alarm-get-time | alarm-get-temperature | alarm-get-alarm1 | alarm-get-alarm2 | output-set-time | output-set-1Hz\n");
-        ds3231_interface_debug_print("     | output-set-32KHz | output-get-time | output-get-1Hz | output-get-32KHz | output-get-temperature>, --example=<basic-set-time | basic-get-time \n");
-        ds3231_interface_debug_print("     | basic-get-temperature | alarm-set-time | alarm-set-alarm1 | alarm-set-alarm2 | alarm-set-alarm1-mode | alarm-set-alarm2-mode | alarm-get-time \n");
-        ds3231_interface_debug_print("     | alarm-get-temperature | alarm-get-alarm1 | alarm-get-alarm2 | output-set-time | output-set-1Hz | output-set-32KHz | output-get-time \n");
-        ds3231_interface_debug_print("     | output-get-1Hz | output-get-32KHz | output-get-temperature>\n");
+        ds3231_interface_debug_print("     | output-set-32KHz | output-get-time | output-get-1Hz | output-get-32KHz | output-get-temperature | clock-get-time | scheduler-run\n");
+        ds3231_interface_debug_print("     | calibration-run | calibration-restore | calibration-model>, --example=<basic-set-time | basic-get-time | basic-get-temperature | alarm-set-time \n");
+        ds3231_interface_debug_print("     | alarm-set-alarm1 | alarm-set-alarm2 | alarm-set-alarm1-mode | alarm-set-alarm2-mode | alarm-get-time | alarm-get-temperature \n");
+        ds3231_interface_debug_print("     | alarm-get-alarm1 | alarm-get-alarm2 | output-set-time | output-set-1Hz | output-set-32KHz | output-get-time | output-get-1Hz \n");
+        ds3231_interface_debug_print("     | output-get-32KHz | output-get-temperature | clock-get-time | scheduler-run | calibration-run | calibration-restore\n");
+        ds3231_interface_debug_print("     | calibration-model>\n");
         ds3231_interface_debug_print("                                  Run the driver example.\n");
         ds3231_interface_debug_print("      --enable=<true | false>     Enable or disable the function.\n");
+        ds3231_interface_debug_print("      --file=<path>               Set the file of the saved aging offset or the stream output.\n");
         ds3231_interface_debug_print("  -h, --help                      Show the help.\n");
         ds3231_interface_debug_print("  -i, --information               Show the chip information.\n");
         ds3231_interface_debug_print("      --mode1=<ONCE_A_SECOND | SECOND_MATCH | MINUTE_SECOND_MATCH | HOUR_MINUTE_SECOND_MATCH\n");
@@ -1271,7 +2212,13 @@ uint8_t ds3231(uint8_t argc, char **argv)
         ds3231_interface_debug_print("      --mode2=<ONCE_A_MINUTE | MINUTE_MATCH | HOUR_MINUTE_MATCH | DATE_HOUR_MINUTE_MATCH | WEEK_HOUR_MINUTE_MATCH>\n");
         ds3231_interface_debug_print("                                  Set the alarm2 mode.\n");
         ds3231_interface_debug_print("  -p, --port                      Display the pin connections of the current board.\n");
-        ds3231_interface_debug_print("  -t <reg | alarm | readwrite | output>, --test=<reg | alarm | readwrite | output>\n");
+        ds3231_interface_debug_print("      --rate=<hz | sqw>           Set the stream rate in Hz or sample on every square wave edge.([default: 1])\n");
+        ds3231_interface_debug_print("      --serve[=<path>]            Answer the requests on the unix socket until a signal, path defaults to /tmp/ds3231.sock.\n");
+        ds3231_interface_debug_print("      --simulate                  Run the tests on the simulated device.\n");
+        ds3231_interface_debug_print("                                  Speed scales the host clock, without it the clock only moves in delays.\n");
+        ds3231_interface_debug_print("      --stream=<csv | ndjson | binary>\n");
+        ds3231_interface_debug_print("                                  Sample the time, status and temperature until the times or a signal.\n");
+        ds3231_interface_debug_print("  -t <reg | alarm | readwrite | output | calendar>, --test=<reg | alarm | readwrite | output | calendar>\n");
         ds3231_interface_debug_print("                                  Run the driver test.\n");
         ds3231_interface_debug_print("      --times=<num>               Set the running times.([default: 3])\n");
         ds3231_interface_debug_print("      --timestamp=<time>          Set the the unix timestamp.\n");
@@ -41,6 +41,11 @@
 #include "uart.h"
 #include <stdarg.h>
 
+/**
+ * @brief bus lock definition
+ */
+static uint32_t gs_primask;        /**< interrupt mask saved by the bus lock */
+
 /**
  * @brief  interface iic bus init
  * @return status code
@@ -97,6 +102,218 @@ uint8_t ds3231_interface_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint
     return iic_write(addr, reg, buf, len);
 }
 
+/**
+ * @brief     lock the bus of a context
+ * @param[in] *c pointer to a ds3231 interface context structure
+ * @note      only a context behind a mux takes the lock, the interrupts are masked so a handler can not
+ *            switch the channel between the select and the access
+ */
+static void a_iic_bus_lock(ds3231_interface_ctx_t *c)
+{
+    uint32_t primask;
+    
+    if (c->mux_addr != 0)
+    {
+        primask = __get_PRIMASK();
+        __disable_irq();
+        gs_primask = primask;
+    }
+}
+
+/**
+ * @brief     unlock the bus of a context
+ * @param[in] *c pointer to a ds3231 interface context structure
+ * @note      none
+ */
+static void a_iic_bus_unlock(ds3231_interface_ctx_t *c)
+{
+    if (c->mux_addr != 0)
+    {
+        __set_PRIMASK(gs_primask);
+    }
+}
+
+/**
+ * @brief     select the mux channel of a context
+ * @param[in] *c pointer to a ds3231 interface context structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 select failed
+ * @note      the bus lock must be held until the access after the select is done
+ */
+static uint8_t a_iic_select(ds3231_interface_ctx_t *c)
+{
+    uint8_t channel;
+    
+    /* no mux */
+    if (c->mux_addr == 0)
+    {
+        return 0;
+    }
+    
+    /* enable only this channel */
+    channel = (uint8_t)(1 << c->mux_channel);
+    
+    return iic_write_cmd(c->mux_addr, &channel, 1);
+}
+
+/**
+ * @brief     interface iic bus init with a context
+ * @param[in] *ctx pointer to a ds3231 interface context structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic init failed
+ * @note      none
+ */
+uint8_t ds3231_interface_iic_init_ctx(void *ctx)
+{
+    ds3231_interface_ctx_t *c = (ds3231_interface_ctx_t *)ctx;
+    
+    /* only one bus is wired */
+    if (c->bus != 0)
+    {
+        return 1;
+    }
+    c->fd = 0;
+    
+    return iic_init();
+}
+
+/**
+ * @brief     interface iic bus deinit with a context
+ * @param[in] *ctx pointer to a ds3231 interface context structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 iic deinit failed
+ * @note      none
+ */
+uint8_t ds3231_interface_iic_deinit_ctx(void *ctx)
+{
+    (void)ctx;
+    
+    return iic_deinit();
+}
+
+/**
+ * @brief      interface iic bus read with a context
+ * @param[in]  *ctx pointer to a ds3231 interface context structure
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t ds3231_interface_iic_read_ctx(void *ctx, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    ds3231_interface_ctx_t *c = (ds3231_interface_ctx_t *)ctx;
+    uint8_t res;
+    
+    /* keep the channel selected until the access is done */
+    a_iic_bus_lock(c);
+    res = a_iic_select(c);
+    if (res == 0)
+    {
+        res = iic_read(addr, reg, buf, len);
+    }
+    a_iic_bus_unlock(c);
+    
+    return res;
+}
+
+/**
+ * @brief     interface iic bus write with a context
+ * @param[in] *ctx pointer to a ds3231 interface context structure
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t ds3231_interface_iic_write_ctx(void *ctx, uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    ds3231_interface_ctx_t *c = (ds3231_interface_ctx_t *)ctx;
+    uint8_t res;
+    
+    /* keep the channel selected until the access is done */
+    a_iic_bus_lock(c);
+    res = a_iic_select(c);
+    if (res == 0)
+    {
+        res = iic_write(addr, reg, buf, len);
+    }
+    a_iic_bus_unlock(c);
+    
+    return res;
+}
+
+/**
+ * @brief     interface iic bus transfer
+ * @param[in] addr iic device write address
+ * @param[in] *msg pointer to a message list
+ * @param[in] num message number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      the bus driver has no message list, so the accesses are run one by one
+ */
+uint8_t ds3231_interface_iic_transfer(uint8_t addr, ds3231_iic_msg_t *msg, uint8_t num)
+{
+    uint8_t i;
+    uint8_t res;
+    
+    for (i = 0; i < num; i++)
+    {
+        if (msg[i].read != 0)
+        {
+            res = iic_read(addr, msg[i].reg, msg[i].buf, msg[i].len);
+        }
+        else
+        {
+            res = iic_write(addr, msg[i].reg, msg[i].buf, msg[i].len);
+        }
+        if (res != 0)
+        {
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     interface iic bus transfer with a context
+ * @param[in] *ctx pointer to a ds3231 interface context structure
+ * @param[in] addr iic device write address
+ * @param[in] *msg pointer to a message list
+ * @param[in] num message number
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ * @note      none
+ */
+uint8_t ds3231_interface_iic_transfer_ctx(void *ctx, uint8_t addr, ds3231_iic_msg_t *msg, uint8_t num)
+{
+    ds3231_interface_ctx_t *c = (ds3231_interface_ctx_t *)ctx;
+    uint8_t res;
+    
+    /* keep the channel selected until the access is done */
+    a_iic_bus_lock(c);
+    res = a_iic_select(c);
+    if (res == 0)
+    {
+        res = ds3231_interface_iic_transfer(addr, msg, num);
+    }
+    a_iic_bus_unlock(c);
+    
+    return res;
+}
+
 /**
  * @brief     interface delay ms
  * @param[in] ms time
@@ -127,6 +344,40 @@ void ds3231_interface_debug_print(const char *const fmt, ...)
     (void)uart_write((uint8_t *)str, len);
 }
 
+/**
+ * @brief     interface lock
+ * @param[in] *ctx pointer to a lock context
+ * @param[in] type lock type
+ * @note      none
+ */
+void ds3231_interface_lock(void *ctx, ds3231_lock_t type)
+{
+    (void)ctx;
+    (void)type;
+}
+
+/**
+ * @brief     interface unlock
+ * @param[in] *ctx pointer to a lock context
+ * @param[in] type lock type
+ * @note      none
+ */
+void ds3231_interface_unlock(void *ctx, ds3231_lock_t type)
+{
+    (void)ctx;
+    (void)type;
+}
+
+/**
+ * @brief  interface timestamp
+ * @return monotonic timestamp in us
+ * @note   it is only used by the stats build for the latency histograms, the resolution is 1 ms
+ */
+uint64_t ds3231_interface_timestamp_us(void)
+{
+    return (uint64_t)HAL_GetTick() * 1000;
+}
+
 /**
  * @brief     interface receive callback
  * @param[in] type interrupt type
@@ -154,3 +405,34 @@ void ds3231_interface_receive_callback(uint8_t type)
         }
     }
 }
+
+/**
+ * @brief     interface receive callback with a context
+ * @param[in] *ctx pointer to a ds3231 interface context structure
+ * @param[in] type interrupt type
+ * @note      none
+ */
+void ds3231_interface_receive_callback_ctx(void *ctx, uint8_t type)
+{
+    ds3231_interface_ctx_t *c = (ds3231_interface_ctx_t *)ctx;
+    
+    switch (type)
+    {
+        case DS3231_STATUS_ALARM_2 :
+        {
+            ds3231_interface_debug_print("ds3231: bus %d irq alarm2.\n", c->bus);
+            
+            break;
+        }
+        case DS3231_STATUS_ALARM_1 :
+        {
+            ds3231_interface_debug_print("ds3231: bus %d irq alarm1.\n", c->bus);
+            
+            break;
+        }
+        default :
+        {
+            break;
+        }
+    }
+}
@@ -78,622 +78,1013 @@
 #define DS3231_ADDRESS        0xD0        /**< iic device address */ 
 
 /**
- * @brief     write one byte
- * @param[in] *handle pointer to a ds3231 handle structure
- * @param[in] reg iic register address
- * @param[in] data written data
- * @return    status code
- *            - 0 success
- *            - 1 write failed
- * @note      none
+ * @brief event queue size check definition
  */
-static uint8_t a_ds3231_iic_write(ds3231_handle_t *handle, uint8_t reg, uint8_t data)
-{
-    if (handle->iic_write(DS3231_ADDRESS, reg, &data, 1) != 0)        /* write data */
-    {
-        return 1;                                                     /* return error */
-    }
-    else
-    {
-        return 0;                                                     /* success return 0 */
-    }
-}
+typedef char ds3231_event_queue_size_check_t[((DS3231_EVENT_QUEUE_SIZE & (DS3231_EVENT_QUEUE_SIZE - 1)) == 0) ? 1 : -1];
 
 /**
- * @brief      read multiple bytes
- * @param[in]  *handle pointer to a ds3231 handle structure
- * @param[in]  reg iic register address
- * @param[out] *buf pointer to a data buffer
- * @param[in]  len data buffer length
- * @return     status code
- *             - 0 success
- *             - 1 read failed
- * @note       none
+ * @brief memory barrier definition
+ */
+#if defined(__GNUC__)
+    #define DS3231_MEMORY_BARRIER()        __sync_synchronize()
+#else
+    #define DS3231_MEMORY_BARRIER()
+#endif
+
+/**
+ * @brief debug print definition
+ */
+#if (DS3231_DEBUG_PRINT_ENABLE != 0)
+    #define DS3231_DEBUG_PRINT(HANDLE, STR)        (HANDLE)->debug_print(STR)
+#else
+    #define DS3231_DEBUG_PRINT(HANDLE, STR)        ((void)(HANDLE))
+#endif
+
+/**
+ * @brief bcd table row definition
+ */
+#define DS3231_BCD_ENCODE_ROW(t)        (t << 4) | 0x0, (t << 4) | 0x1, (t << 4) | 0x2, (t << 4) | 0x3, (t << 4) | 0x4, \
+                                        (t << 4) | 0x5, (t << 4) | 0x6, (t << 4) | 0x7, (t << 4) | 0x8, (t << 4) | 0x9        /**< encode row */
+#define DS3231_BCD_DECODE_ROW(t)        t * 10 + 0, t * 10 + 1, t * 10 + 2, t * 10 + 3, t * 10 + 4, \
+                                        t * 10 + 5, t * 10 + 6, t * 10 + 7, t * 10 + 8, t * 10 + 9, \
+                                        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF                                                     /**< decode row */
+#define DS3231_BCD_INVALID_ROW          0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, \
+                                        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF                                         /**< invalid row */
+
+/**
+ * @brief hex to bcd table, 0 - 99
  */
-static uint8_t a_ds3231_iic_multiple_read(ds3231_handle_t *handle, uint8_t reg, uint8_t *buf, uint8_t len)
+static const uint8_t gs_hex2bcd[100] =
 {
-    if (handle->iic_read(DS3231_ADDRESS, reg, buf, len) != 0)        /* read data */
-    {
-        return 1;                                                    /* return error */
-    }
-    else
-    {                                                                /* success return 0 */
-        return 0;
-    }
-}
+    DS3231_BCD_ENCODE_ROW(0), DS3231_BCD_ENCODE_ROW(1), DS3231_BCD_ENCODE_ROW(2), DS3231_BCD_ENCODE_ROW(3), DS3231_BCD_ENCODE_ROW(4),
+    DS3231_BCD_ENCODE_ROW(5), DS3231_BCD_ENCODE_ROW(6), DS3231_BCD_ENCODE_ROW(7), DS3231_BCD_ENCODE_ROW(8), DS3231_BCD_ENCODE_ROW(9),
+};
 
 /**
- * @brief     hex to bcd
- * @param[in] val hex data
- * @return    bcd data
- * @note      none
+ * @brief bcd to hex table, 0xFF marks an invalid bcd byte
  */
-static uint8_t a_ds3231_hex2bcd(uint8_t val)
+static const uint8_t gs_bcd2hex[256] =
 {
-    uint8_t i, j, k;
-    
-    i = val / 10;            /* get tens place */
-    j = val % 10;            /* get ones place */
-    k = j + (i << 4);        /* set bcd */
-    
-    return k;                /* return bcd */
-}
+    DS3231_BCD_DECODE_ROW(0), DS3231_BCD_DECODE_ROW(1), DS3231_BCD_DECODE_ROW(2), DS3231_BCD_DECODE_ROW(3),
+    DS3231_BCD_DECODE_ROW(4), DS3231_BCD_DECODE_ROW(5), DS3231_BCD_DECODE_ROW(6), DS3231_BCD_DECODE_ROW(7),
+    DS3231_BCD_DECODE_ROW(8), DS3231_BCD_DECODE_ROW(9), DS3231_BCD_INVALID_ROW, DS3231_BCD_INVALID_ROW,
+    DS3231_BCD_INVALID_ROW, DS3231_BCD_INVALID_ROW, DS3231_BCD_INVALID_ROW, DS3231_BCD_INVALID_ROW,
+};
 
+#if (DS3231_STATS_ENABLE != 0)
 /**
- * @brief     bcd to hex
- * @param[in] val bcd data
- * @return    hex data
- * @note      none
+ * @brief     record the latency of the api holding the lock
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @note      bucket n counts 2^n to 2^(n+1) - 1 us, the first bucket also counts 0 us
+ *            and the last one everything longer
  */
-static uint8_t a_ds3231_bcd2hex(uint8_t val)
+static void a_ds3231_stats_sample(ds3231_handle_t *handle)
 {
-    uint8_t temp;
+    uint64_t us;
+    uint8_t bucket;
     
-    temp = val & 0x0F;              /* get ones place */
-    val = (val >> 4) & 0x0F;        /* get tens place */
-    val = val * 10;                 /* set tens place */
-    temp = temp + val;              /* get hex */
-    
-    return temp;                    /* return hex */
+    if (handle->stats_api == DS3231_STATS_API_NONE)                                    /* check the api */
+    {
+        return;                                                                        /* not sampled */
+    }
+    handle->stats.call[handle->stats_api]++;                                           /* count the call */
+    if (handle->timestamp_us != NULL)                                                  /* check the timestamp function */
+    {
+        us = handle->timestamp_us() - handle->stats_start;                             /* get the latency */
+        bucket = 0;                                                                    /* init 0 */
+        while ((us > 1) && (bucket < (DS3231_STATS_HISTOGRAM_SIZE - 1)))               /* find the log2 bucket */
+        {
+            us >>= 1;                                                                  /* halve */
+            bucket++;                                                                  /* next bucket */
+        }
+        handle->stats.latency[handle->stats_api][bucket]++;                            /* count the latency */
+    }
+    handle->stats_api = DS3231_STATS_API_NONE;                                         /* clear the api */
 }
 
 /**
- * @brief     set the current time
+ * @brief     count an iic access
  * @param[in] *handle pointer to a ds3231 handle structure
- * @param[in] *t pointer to a time structure
- * @return    status code
- *            - 0 success
- *            - 1 set time failed
- *            - 2 handle or time is NULL
- *            - 3 handle is not initialized
- *            - 4 time is invalid
+ * @param[in] read 1 for a read and 0 for a write
+ * @param[in] len data length
+ * @param[in] res iic result
  * @note      none
  */
-uint8_t ds3231_set_time(ds3231_handle_t *handle, ds3231_time_t *t)
+static void a_ds3231_stats_iic(ds3231_handle_t *handle, uint8_t read, uint16_t len, uint8_t res)
 {
-    uint8_t res;
-    uint8_t reg;
-    uint8_t century;
-    uint16_t year;
-    
-    if (handle == NULL)                                                                                      /* check handle */
+    if (read != 0)                                                    /* check the direction */
     {
-        return 2;                                                                                            /* return error */
+        handle->stats.iic_read++;                                     /* count the read */
+        handle->stats.read_bytes += len;                              /* count the bytes */
     }
-    if (handle->inited != 1)                                                                                 /* check handle initialization */
+    else
     {
-        return 3;                                                                                            /* return error */
+        handle->stats.iic_write++;                                    /* count the write */
+        handle->stats.write_bytes += len;                             /* count the bytes */
     }
-    if (t == NULL)                                                                                           /* check time */
+    if (res != 0)                                                     /* check result */
     {
-        handle->debug_print("ds3231: time is null.\n");                                                      /* time is null */
-        
-        return 2;                                                                                            /* return error */
+        handle->stats.failed[handle->stats_api]++;                    /* count the failure */
     }
-    if (t->format == DS3231_FORMAT_12H)                                                                      /* if 12H */
+}
+
+/**
+ * @brief     count an iic transfer
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @param[in] *msg pointer to a message list
+ * @param[in] num message number
+ * @param[in] res iic result
+ * @note      none
+ */
+static void a_ds3231_stats_transfer(ds3231_handle_t *handle, ds3231_iic_msg_t *msg, uint8_t num, uint8_t res)
+{
+    uint8_t i;
+    
+    handle->stats.iic_transfer++;                                     /* count the transfer */
+    for (i = 0; i < num; i++)                                         /* count all accesses */
     {
-        if ((t->year < 2000) || (t->year > 2199))                                                            /* check year */
-        {
-            handle->debug_print("ds3231: year can't be over 2199 or less than 2000.\n");                     /* year can't be over 2199 or less than 2000 */
-            
-            return 4;                                                                                        /* return error */
-        }
-        if ((t->month == 0) || (t->month > 12))                                                              /* check month */
-        {
-            handle->debug_print("ds3231: month can't be zero or over than 12.\n");                           /* month can't be zero or over than 12 */
-            
-            return 4;                                                                                        /* return error */
-        }
-        if ((t->week == 0) || (t->week > 7))                                                                 /* check week */
-        {
-            handle->debug_print("ds3231: week can't be zero or over than 7.\n");                             /* week can't be zero or over than 7 */
-            
-            return 4;                                                                                        /* return error */
-        }
-        if ((t->date == 0) || (t->date > 31))                                                                /* check data */
-        {
-            handle->debug_print("ds3231: date can't be zero or over than 31.\n");                            /* date can't be zero or over than 31 */
-            
-            return 4;                                                                                        /* return error */
-        }
-        if ((t->hour < 1) || (t->hour > 12))                                                                 /* check hour */
-        {
-            handle->debug_print("ds3231: hour can't be over than 12 or less 1.\n");                          /* hour can't be over than 12 or less 1 */
-            
-            return 4;                                                                                        /* return error */
-        }
-        if (t->minute > 59)                                                                                  /* check minute */
+        if (msg[i].read != 0)                                         /* check the direction */
         {
-            handle->debug_print("ds3231: minute can't be over than 59.\n");                                  /* minute can't be over than 59 */
-            
-            return 4;                                                                                        /* return error */
+            handle->stats.read_bytes += msg[i].len;                   /* count the bytes */
         }
-        if (t->second > 59)                                                                                  /* check second */
+        else
         {
-            handle->debug_print("ds3231: second can't be over than 59.\n");                                  /* second can't be over than 59 */
-            
-            return 4;                                                                                        /* return error */
+            handle->stats.write_bytes += msg[i].len;                  /* count the bytes */
         }
     }
-    else if (t->format == DS3231_FORMAT_24H)                                                                 /* if 24H */
+    if (res != 0)                                                     /* check result */
     {
-        if ((t->year < 2000) || (t->year > 2199))                                                            /* check year */
-        {
-            handle->debug_print("ds3231: year can't be over 2199 or less than 2000.\n");                     /* year can't be over 2199 or less than 2000 */
-            
-            return 4;                                                                                        /* return error */
-        }
-        if ((t->month == 0) || (t->month > 12))                                                              /* check month */
-        {
-            handle->debug_print("ds3231: month can't be zero or over than 12.\n");                           /* month can't be zero or over than 12 */
-            
-            return 4;                                                                                        /* return error */
-        }
-        if ((t->week == 0) || (t->week > 7))                                                                 /* check week */
-        {
-            handle->debug_print("ds3231: week can't be zero or over than 7.\n");                             /* week can't be zero or over than 7 */
-            
-            return 4;                                                                                        /* return error */
-        }
-        if ((t->date == 0) || (t->date > 31))                                                                /* check data */
-        {
-            handle->debug_print("ds3231: date can't be zero or over than 31.\n");                            /* date can't be zero or over than 31 */
-            
-            return 4;                                                                                        /* return error */
-        }
-        if (t->hour > 23)                                                                                    /* check hour */
-        {
-            handle->debug_print("ds3231: hour can't be over than 23.\n");                                    /* hour can't be over than 23 */
-            
-            return 4;                                                                                        /* return error */
-        }
-        if (t->minute > 59)                                                                                  /* check minute */
-        {
-            handle->debug_print("ds3231: minute can't be over than 59.\n");                                  /* minute can't be over than 59 */
-            
-            return 4;                                                                                        /* return error */
-        }
-        if (t->second > 59)                                                                                  /* check second */
-        {
-            handle->debug_print("ds3231: second can't be over than 59.\n");                                  /* second can't be over than 59 */
-            
-            return 4;                                                                                        /* return error */
-        }
+        handle->stats.failed[handle->stats_api]++;                    /* count the failure */
     }
-    else
+}
+#endif
+
+/**
+ * @brief     initialize the iic bus
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 init failed
+ * @note      the context function is used when it is linked
+ */
+static uint8_t a_ds3231_iic_init(ds3231_handle_t *handle)
+{
+    uint8_t res;
+    
+    if (handle->iic_init_ctx != NULL)                                /* check the context function */
     {
-        handle->debug_print("ds3231: format is invalid.\n");                                                 /* format is invalid */
-        
-        return 4;                                                                                            /* return error */
+        res = handle->iic_init_ctx(handle->user_ctx);                /* init with the context */
     }
-    
-    res = a_ds3231_iic_write(handle, DS3231_REG_SECOND, a_ds3231_hex2bcd(t->second));                        /* write second */
-    if (res != 0)                                                                                            /* check result */
+    else
     {
-        handle->debug_print("ds3231: write second failed.\n");                                               /* write second failed */
-        
-        return 1;                                                                                            /* return error */
+        res = handle->iic_init();                                    /* init */
     }
-    res = a_ds3231_iic_write(handle, DS3231_REG_MINUTE, a_ds3231_hex2bcd(t->minute));                        /* write minute */
-    if (res != 0)                                                                                            /* check result */
+    if (res != 0)                                                    /* check result */
     {
-        handle->debug_print("ds3231: write minute failed.\n");                                               /* write minute failed */
-        
-        return 1;                                                                                            /* return error */
+        return 1;                                                    /* return error */
     }
-    if (t->format == DS3231_FORMAT_12H)                                                                      /* if 12H */
+    else
     {
-        reg = (uint8_t)((1 << 6) | (t->am_pm << 5) | a_ds3231_hex2bcd(t->hour));                             /* set hour in 12H */
+        return 0;                                                    /* success return 0 */
     }
-    else                                                                                                     /* if 24H */
+}
+
+/**
+ * @brief     deinitialize the iic bus
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 deinit failed
+ * @note      the context function is used when it is linked
+ */
+static uint8_t a_ds3231_iic_deinit(ds3231_handle_t *handle)
+{
+    uint8_t res;
+    
+    if (handle->iic_deinit_ctx != NULL)                              /* check the context function */
     {
-        reg = (0 << 6) | a_ds3231_hex2bcd(t->hour);                                                          /* set hour in 24H */
+        res = handle->iic_deinit_ctx(handle->user_ctx);              /* deinit with the context */
     }
-    res = a_ds3231_iic_write(handle, DS3231_REG_HOUR, reg);                                                  /* write hour */
-    if (res != 0)                                                                                            /* check result */
+    else
     {
-        handle->debug_print("ds3231: write hour failed.\n");                                                 /* write hour failed */
-        
-        return 1;                                                                                            /* return error */
+        res = handle->iic_deinit();                                  /* deinit */
     }
-    res = a_ds3231_iic_write(handle, DS3231_REG_WEEK, a_ds3231_hex2bcd(t->week));                            /* write week */
-    if (res != 0)                                                                                            /* check result */
+    if (res != 0)                                                    /* check result */
     {
-        handle->debug_print("ds3231: write week failed.\n");                                                 /* write week failed */
-        
-        return 1;                                                                                            /* return error */
+        return 1;                                                    /* return error */
     }
-    res = a_ds3231_iic_write(handle, DS3231_REG_DATE, a_ds3231_hex2bcd(t->date));                            /* write data */
-    if (res != 0)                                                                                            /* check result */
+    else
     {
-        handle->debug_print("ds3231: write date failed.\n");                                                 /* write date failed */
-        
-        return 1;                                                                                            /* return error */
+        return 0;                                                    /* success return 0 */
     }
-    year = t->year - 2000;                                                                                   /* year - 2000 */
-    if (year >= 100)                                                                                         /* check year */
+}
+
+/**
+ * @brief     write multiple bytes
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      the context function is used when it is linked
+ */
+static uint8_t a_ds3231_iic_multiple_write(ds3231_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint8_t res;
+    
+    if (handle->iic_write_ctx != NULL)                                                       /* check the context function */
     {
-        century = 1;                                                                                         /* set century */
-        year -= 100;                                                                                         /* year -= 100 */
+        res = handle->iic_write_ctx(handle->user_ctx, handle->iic_addr, reg, buf, len);      /* write data with the context */
     }
     else
     {
-        century = 0;                                                                                         /* set century 0 */
+        res = handle->iic_write(handle->iic_addr, reg, buf, len);                            /* write data */
     }
-    res = a_ds3231_iic_write(handle, DS3231_REG_MONTH, a_ds3231_hex2bcd(t->month) | (century << 7));         /* write month and century */
-    if (res != 0)                                                                                            /* check result */
+#if (DS3231_STATS_ENABLE != 0)
+    a_ds3231_stats_iic(handle, 0, len, res);                                                 /* count the access */
+#endif
+    if (res != 0)                                                                            /* check result */
     {
-        handle->debug_print("ds3231: write century and month failed.\n");                                    /* write century and month failed */
-        
-        return 1;                                                                                            /* return error */
+        return 1;                                                                            /* return error */
     }
-    res = a_ds3231_iic_write(handle, DS3231_REG_YEAR, a_ds3231_hex2bcd((uint8_t)year));                      /* write year */
-    if (res != 0)                                                                                            /* check result */
+    else
     {
-        handle->debug_print("ds3231: write year failed.\n");                                                 /* write year failed */
-        
-        return 1;                                                                                            /* return error */
+        return 0;                                                                            /* success return 0 */
     }
-    
-    return 0;                                                                                                /* success return 0 */
 }
 
 /**
- * @brief      get the current time
+ * @brief     write one byte
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @param[in] reg iic register address
+ * @param[in] data written data
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+static uint8_t a_ds3231_iic_write(ds3231_handle_t *handle, uint8_t reg, uint8_t data)
+{
+    return a_ds3231_iic_multiple_write(handle, reg, &data, 1);        /* write data */
+}
+
+/**
+ * @brief      read multiple bytes
  * @param[in]  *handle pointer to a ds3231 handle structure
- * @param[out] *t pointer to a time structure
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data buffer length
  * @return     status code
  *             - 0 success
- *             - 1 get time failed
- *             - 2 handle or time is NULL
- *             - 3 handle is not initialized
- * @note       none
+ *             - 1 read failed
+ * @note       the context function is used when it is linked
  */
-uint8_t ds3231_get_time(ds3231_handle_t *handle, ds3231_time_t *t)
+static uint8_t a_ds3231_iic_multiple_read(ds3231_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
 {
     uint8_t res;
-    uint8_t buf[7];
     
-    if (handle == NULL)                                                                   /* check handle */
-    {
-        return 2;                                                                         /* return error */
-    }
-    if (handle->inited != 1)                                                              /* check handle initialization */
-    {
-        return 3;                                                                         /* return error */
-    }
-    if (t == NULL)                                                                        /* check time */
+    if (handle->iic_read_ctx != NULL)                                                        /* check the context function */
     {
-        handle->debug_print("ds3231: time is null.\n");                                   /* time is null */
-        
-        return 2;                                                                         /* return error */
+        res = handle->iic_read_ctx(handle->user_ctx, handle->iic_addr, reg, buf, len);       /* read data with the context */
     }
-    
-    memset(buf, 0, sizeof(uint8_t) * 7);                                                  /* clear the buffer */
-    res = a_ds3231_iic_multiple_read(handle, DS3231_REG_SECOND, (uint8_t *)buf, 7);       /* multiple_read */
-    if (res != 0)                                                                         /* check result */
+    else
     {
-        handle->debug_print("ds3231: multiple read failed.\n");                           /* multiple read failed */
-        
-        return 1;                                                                         /* return error */
+        res = handle->iic_read(handle->iic_addr, reg, buf, len);                             /* read data */
     }
-    t->year = a_ds3231_bcd2hex(buf[6]) + 2000 + ((buf[5] >> 7) & 0x01) * 100;             /* get year */
-    t->month = a_ds3231_bcd2hex(buf[5]&0x1F);                                             /* get month */
-    t->week = a_ds3231_bcd2hex(buf[3]);                                                   /* get week */
-    t->date = a_ds3231_bcd2hex(buf[4]);                                                   /* get date */
-    t->am_pm = (ds3231_am_pm_t)((buf[2] >> 5) & 0x01);                                    /* get am pm */
-    t->format = (ds3231_format_t)((buf[2] >> 6) & 0x01);                                  /* get format */
-    if (t->format == DS3231_FORMAT_12H)                                                   /* if 12H */
+#if (DS3231_STATS_ENABLE != 0)
+    a_ds3231_stats_iic(handle, 1, len, res);                                                 /* count the access */
+#endif
+    if (res != 0)                                                                            /* check result */
     {
-        t->hour = a_ds3231_bcd2hex(buf[2] & 0x1F);                                        /* get hour */
+        return 1;                                                                            /* return error */
     }
     else
     {
-        t->hour = a_ds3231_bcd2hex(buf[2] & 0x3F);                                        /* get hour */
+        return 0;                                                                            /* success return 0 */
     }
-    t->minute = a_ds3231_bcd2hex(buf[1]);                                                 /* get minute */
-    t->second = a_ds3231_bcd2hex(buf[0]);                                                 /* get second */
-    
-    return 0;                                                                             /* success return 0 */
 }
 
 /**
- * @brief     set the alarm1 time
+ * @brief     run a list of register accesses
  * @param[in] *handle pointer to a ds3231 handle structure
- * @param[in] *t pointer to a time structure
- * @param[in] mode alarm1 interrupt mode
+ * @param[in] *msg pointer to a message list
+ * @param[in] num message number
  * @return    status code
  *            - 0 success
- *            - 1 set alarm1 failed
- *            - 2 handle or time is NULL
- *            - 3 handle is not initialized
- * @note      none
+ *            - 1 transfer failed
+ * @note      the transfer function is used when it is linked, otherwise the accesses are run one by one
  */
-uint8_t ds3231_set_alarm1(ds3231_handle_t *handle, ds3231_time_t *t, ds3231_alarm1_mode_t mode)
+static uint8_t a_ds3231_iic_transfer(ds3231_handle_t *handle, ds3231_iic_msg_t *msg, uint8_t num)
 {
     uint8_t res;
-    uint8_t reg;
+    uint8_t i;
     
-    if (handle == NULL)                                                                                                            /* check handle */
-    {
-        return 2;                                                                                                                  /* return error */
-    }
-    if (handle->inited != 1)                                                                                                       /* check handle initialization */
+    if (handle->iic_transfer_ctx != NULL)                                                            /* check the context function */
     {
-        return 3;                                                                                                                  /* return error */
+        res = handle->iic_transfer_ctx(handle->user_ctx, handle->iic_addr, msg, num);                /* transfer with the context */
+#if (DS3231_STATS_ENABLE != 0)
+        a_ds3231_stats_transfer(handle, msg, num, res);                                              /* count the transfer */
+#endif
     }
-    if (t == NULL)                                                                                                                 /* check time */
+    else if (handle->iic_transfer != NULL)                                                           /* check the transfer function */
     {
-        handle->debug_print("ds3231: time is null.\n");                                                                            /* time is null */
-        
-        return 2;                                                                                                                  /* return error */
+        res = handle->iic_transfer(handle->iic_addr, msg, num);                                      /* transfer */
+#if (DS3231_STATS_ENABLE != 0)
+        a_ds3231_stats_transfer(handle, msg, num, res);                                              /* count the transfer */
+#endif
     }
-    if (t->format == DS3231_FORMAT_12H)                                                                                            /* if 12H */
+    else
     {
-        if ((t->week == 0) || (t->week > 7))                                                                                       /* check week */
-        {
-            handle->debug_print("ds3231: week can't be zero or over than 7.\n");                                                   /* week can't be zero or over than 7 */
-            
-            return 1;                                                                                                              /* return error */
-        }
-        if ((t->date == 0) || (t->date > 31))                                                                                      /* check data */
-        {
-            handle->debug_print("ds3231: date can't be zero or over than 31.\n");                                                  /* date can't be zero or over than 31 */
-            
-            return 1;                                                                                                              /* return error */
-        }
-        if ((t->hour < 1) || (t->hour > 12))                                                                                       /* check hour */
-        {
-            handle->debug_print("ds3231: hour can't be over than 12 or less 1.\n");                                                /* hour can't be over than 12 or less 1 */
-            
-            return 1;                                                                                                              /* return error */
-        }
-        if (t->minute > 59)                                                                                                        /* check minute */
-        {
-            handle->debug_print("ds3231: minute can't be over than 59.\n");                                                        /* minute can't be over than 59 */
-            
-            return 1;                                                                                                              /* return error */
-        }
-        if (t->second > 59)                                                                                                        /* check second  */
+        res = 0;                                                                                     /* init 0 */
+        for (i = 0; i < num; i++)                                                                    /* run all accesses */
         {
-            handle->debug_print("ds3231: second can't be over than 59.\n");                                                        /* second can't be over than 59 */
-            
-            return 1;                                                                                                              /* return error */
+            if (msg[i].read != 0)                                                                    /* check the direction */
+            {
+                res = a_ds3231_iic_multiple_read(handle, msg[i].reg, msg[i].buf, msg[i].len);        /* read data */
+            }
+            else
+            {
+                res = a_ds3231_iic_multiple_write(handle, msg[i].reg, msg[i].buf, msg[i].len);       /* write data */
+            }
+            if (res != 0)                                                                            /* check result */
+            {
+                break;                                                                               /* stop at the first error */
+            }
         }
     }
-    else if (t->format == DS3231_FORMAT_24H)                                                                                       /* if 24H */
+    if (res != 0)                                                                                    /* check result */
     {
-        if ((t->week == 0) || (t->week > 7))                                                                                       /* check week */
-        {
-            handle->debug_print("ds3231: week can't be zero or over than 7.\n");                                                   /* week can't be zero or over than 7 */
-            
-            return 1;                                                                                                              /* return error */
-        }
-        if ((t->date == 0) || (t->date > 31))                                                                                      /* check data */
-        {
-            handle->debug_print("ds3231: date can't be zero or over than 31.\n");                                                  /* date can't be zero or over than 31 */
-            
-            return 1;                                                                                                              /* return error */
-        }
-        if (t->hour > 23)                                                                                                          /* check hour */
-        {
-            handle->debug_print("ds3231: hour can't be over than 23.\n");                                                          /* hour can't be over than 23 */
-            
-            return 1;                                                                                                              /* return error */
-        }
-        if (t->minute > 59)                                                                                                        /* check minute */
-        {
-            handle->debug_print("ds3231: minute can't be over than 59.\n");                                                        /* minute can't be over than 59 */
-            
-            return 1;                                                                                                              /* return error */
-        }
-        if (t->second > 59)                                                                                                        /* check second */
-        {
-            handle->debug_print("ds3231: second can't be over than 59.\n");                                                        /* second can't be over than 59 */
-            
-            return 1;                                                                                                              /* return error */
-        }
+        return 1;                                                                                    /* return error */
     }
     else
     {
-        handle->debug_print("ds3231: format is invalid.\n");                                                                       /* format is invalid */
-        
-        return 1;                                                                                                                  /* return error */
+        return 0;                                                                                    /* success return 0 */
     }
+}
+
+/**
+ * @brief     queue a register access
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @param[in] *transaction pointer to a transaction structure
+ * @param[in] reg iic register address
+ * @param[in] read 1 for a read and 0 for a write
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle, transaction or buf is NULL
+ *            - 3 handle is not initialized
+ *            - 4 transaction is full
+ * @note      none
+ */
+static uint8_t a_ds3231_transaction_add(ds3231_handle_t *handle, ds3231_transaction_t *transaction, uint8_t reg, uint8_t read, uint8_t *buf, uint16_t len)
+{
+    uint8_t cost;
     
-    res = a_ds3231_iic_write(handle, DS3231_REG_ALARM1_SECOND, a_ds3231_hex2bcd(t->second) | ((mode & 0x01) << 7));                /* write second */
-    if (res != 0)                                                                                                                  /* check result */
-    {
-        handle->debug_print("ds3231: write alarm1 second failed.\n");                                                              /* write alarm1 second failed */
-        
-        return 1;                                                                                                                  /* return error */
-    }
-    res = a_ds3231_iic_write(handle, DS3231_REG_ALARM1_MINUTE, a_ds3231_hex2bcd(t->minute) | (((mode >> 1) & 0x01) << 7));         /* write minute */
-    if (res != 0)                                                                                                                  /* check result */
+    if (handle == NULL)                                                             /* check handle */
     {
-        handle->debug_print("ds3231: write alarm1 minute failed.\n");                                                              /* write alarm1 minute failed */
-        
-        return 1;                                                                                                                  /* return error */
+        return 2;                                                                   /* return error */
     }
-    if (t->format == DS3231_FORMAT_12H)                                                                                            /* if 12H */
+    if (handle->inited != 1)                                                        /* check handle initialization */
     {
-        reg = (uint8_t)((((mode >> 2) & 0x01) << 7) | (1 << 6) | (t->am_pm << 5) | a_ds3231_hex2bcd(t->hour));                     /* set hour in 12H */
+        return 3;                                                                   /* return error */
     }
-    else                                                                                                                           /* if 24H */
+    if ((transaction == NULL) || (buf == NULL))                                     /* check transaction and buf */
     {
-        reg = (((mode >> 2) & 0x01) << 7) | a_ds3231_hex2bcd(t->hour);                                                             /* set hour in 24H */
+        DS3231_DEBUG_PRINT(handle, "ds3231: transaction or buf is null.\n");        /* transaction or buf is null */
+        
+        return 2;                                                                   /* return error */
     }
-    res = a_ds3231_iic_write(handle, DS3231_REG_ALARM1_HOUR, reg);                                                                 /* write hour */
-    if (res != 0)                                                                                                                  /* check result */
+    
+    cost = (read != 0) ? 2 : 1;                                                     /* a read needs the register address message */
+    if ((transaction->cost + cost) > DS3231_TRANSACTION_MAX_MSG)                    /* check the space */
     {
-        handle->debug_print("ds3231: write alarm1 hour failed.\n");                                                                /* write alarm1 hour failed */
+        DS3231_DEBUG_PRINT(handle, "ds3231: transaction is full.\n");               /* transaction is full */
         
-        return 1;                                                                                                                  /* return error */
+        return 4;                                                                   /* return error */
     }
-    if (mode >= DS3231_ALARM1_MODE_WEEK_HOUR_MINUTE_SECOND_MATCH)                                                                  /* if week */
+    transaction->msg[transaction->num].reg = reg;                                   /* set register */
+    transaction->msg[transaction->num].read = read;                                 /* set direction */
+    transaction->msg[transaction->num].buf = buf;                                   /* set buffer */
+    transaction->msg[transaction->num].len = len;                                   /* set length */
+    transaction->num++;                                                             /* number++ */
+    transaction->cost = (uint8_t)(transaction->cost + cost);                        /* add cost */
+    
+    return 0;                                                                       /* success return 0 */
+}
+
+/**
+ * @brief     run the receive callback
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @param[in] type interrupt type
+ * @note      the context function is used when it is linked
+ */
+static void a_ds3231_receive_callback(ds3231_handle_t *handle, uint8_t type)
+{
+    if (handle->receive_callback_ctx != NULL)                       /* check the context function */
     {
-        reg = (((mode >> 3) & 0x01) << 7) | (1 << 6) | a_ds3231_hex2bcd(t->week);                                                  /* set data in week */
+        handle->receive_callback_ctx(handle->user_ctx, type);       /* run callback with the context */
     }
-    else                                                                                                                           /* if day */
+    else if (handle->receive_callback != NULL)                      /* check the callback */
     {
-        reg = (((mode >> 3) & 0x01) << 7) | a_ds3231_hex2bcd(t->date);                                                             /* set data in date */
+        handle->receive_callback(type);                             /* run callback */
     }
-    res = a_ds3231_iic_write(handle, DS3231_REG_ALARM1_WEEK, reg);                                                                 /* write week */
-    if (res != 0)                                                                                                                  /* check result */
+    else
     {
-        handle->debug_print("ds3231: write alarm1 week failed.\n");                                                                /* write alarm1 week failed */
-        
-        return 1;                                                                                                                  /* return error */
+                                                                    /* do nothing */
     }
-    
-    return 0;                                                                                                                      /* success return 0 */
 }
 
 /**
- * @brief      get the alarm1 time
- * @param[in]  *handle pointer to a ds3231 handle structure
- * @param[out] *t pointer to a time structure
- * @param[out] *mode pointer to an alarm1 interrupt mode buffer
- * @return     status code
- *             - 0 success
- *             - 1 get alarm1 failed
- *             - 2 handle or time is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief     lock the handle
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @param[in] type lock type
+ * @param[in] api api taking the lock
+ * @note      nothing is done when no lock function is linked,
+ *            the stats build always takes the write lock as the counters are written
  */
-uint8_t ds3231_get_alarm1(ds3231_handle_t *handle, ds3231_time_t *t, ds3231_alarm1_mode_t *mode)
+static void a_ds3231_lock(ds3231_handle_t *handle, ds3231_lock_t type, ds3231_stats_api_t api)
 {
-    uint8_t res;
-    uint8_t buf[4];
-    
-    if (handle == NULL)                                                                                                                   /* check handle */
+#if (DS3231_STATS_ENABLE != 0)
+    type = DS3231_LOCK_WRITE;                                  /* the counters need the write lock */
+#endif
+    if (handle->lock != NULL)                                  /* check the lock function */
     {
-        return 2;                                                                                                                         /* return error */
+        handle->lock(handle->lock_ctx, type);                  /* lock */
     }
-    if (handle->inited != 1)                                                                                                              /* check handle initialization */
+#if (DS3231_STATS_ENABLE != 0)
+    handle->stats_api = api;                                   /* set the api */
+    if (handle->timestamp_us != NULL)                          /* check the timestamp function */
     {
-        return 3;                                                                                                                         /* return error */
+        handle->stats_start = handle->timestamp_us();          /* set the start time */
     }
-    if (t == NULL)                                                                                                                        /* check time */
+#else
+    (void)api;                                                 /* not used */
+#endif
+}
+
+/**
+ * @brief     unlock the handle
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @param[in] type lock type
+ * @note      nothing is done when no unlock function is linked
+ */
+static void a_ds3231_unlock(ds3231_handle_t *handle, ds3231_lock_t type)
+{
+#if (DS3231_STATS_ENABLE != 0)
+    a_ds3231_stats_sample(handle);                             /* record the latency */
+    type = DS3231_LOCK_WRITE;                                  /* the counters need the write lock */
+#endif
+    if (handle->unlock != NULL)                                /* check the unlock function */
     {
-        handle->debug_print("ds3231: time is null.\n");                                                                                   /* time is null */
-        
-        return 2;                                                                                                                         /* return error */
+        handle->unlock(handle->lock_ctx, type);                /* unlock */
     }
-    
-    memset(buf, 0, sizeof(uint8_t) * 4);                                                                                                  /* clear the buffer */
-    res = a_ds3231_iic_multiple_read(handle, DS3231_REG_ALARM1_SECOND, (uint8_t *)buf, 4);                                                /* multiple_read */
-    if (res != 0)                                                                                                                         /* check result */
+}
+
+/**
+ * @brief     lock the handle for a shadow register read
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @param[in] api api taking the lock
+ * @return    taken lock type
+ * @note      a read lock is enough while the shadow is valid or disabled,
+ *            refilling the shadow needs the write lock, the stats build always holds it
+ */
+static ds3231_lock_t a_ds3231_shadow_lock(ds3231_handle_t *handle, ds3231_stats_api_t api)
+{
+    a_ds3231_lock(handle, DS3231_LOCK_READ, api);                             /* read lock */
+#if (DS3231_STATS_ENABLE == 0)
+    if ((handle->cache_enable != 0) && (handle->cache_valid == 0))            /* check the shadow */
     {
-        handle->debug_print("ds3231: multiple read failed.\n");                                                                           /* multiple read failed */
+        a_ds3231_unlock(handle, DS3231_LOCK_READ);                            /* read unlock */
+        a_ds3231_lock(handle, DS3231_LOCK_WRITE, api);                        /* write lock */
         
-        return 1;                                                                                                                         /* return error */
+        return DS3231_LOCK_WRITE;                                             /* return write lock */
     }
-    t->year = 0;                                                                                                                          /* get year */
-    t->month = 0;                                                                                                                         /* get month */
-    if (((buf[3] >> 6) & 0x01) != 0)                                                                                                      /* if week */
+#endif
+    
+    return DS3231_LOCK_READ;                                                  /* return read lock */
+}
+
+#if (DS3231_STATS_ENABLE != 0)
+/**
+ * @brief     count a blocking temperature conversion
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @param[in] ms waited time in ms
+ * @note      none
+ */
+static void a_ds3231_stats_conversion(ds3231_handle_t *handle, uint32_t ms)
+{
+    a_ds3231_lock(handle, DS3231_LOCK_WRITE, DS3231_STATS_API_NONE);         /* lock */
+    handle->stats.conversion++;                                              /* count the conversion */
+    handle->stats.conversion_wait_ms += ms;                                  /* count the wait */
+    a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                              /* unlock */
+}
+#endif
+
+/**
+ * @brief      read the control or status register through the shadow cache
+ * @param[in]  *handle pointer to a ds3231 handle structure
+ * @param[in]  reg DS3231_REG_CONTROL or DS3231_REG_STATUS
+ * @param[out] *data pointer to a register buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       a cache miss refills both shadows with one 2 bytes read
+ */
+static uint8_t a_ds3231_shadow_read(ds3231_handle_t *handle, uint8_t reg, uint8_t *data)
+{
+    uint8_t buf[2];
+    
+    if (handle->cache_enable == 0)                                                            /* if cache is disabled */
     {
-        t->week = a_ds3231_bcd2hex(buf[3] & 0x0F);                                                                                        /* get week */
-        t->date = 0;                                                                                                                      /* get data */
+        return a_ds3231_iic_multiple_read(handle, reg, data, 1);                              /* read from the chip */
     }
-    else                                                                                                                                  /* if data */
+    if (handle->cache_valid == 0)                                                             /* if cache is invalid */
     {
-        t->week = 0;                                                                                                                      /* get week */
-        t->date = a_ds3231_bcd2hex(buf[3] & 0x3F);                                                                                        /* get data */
+        if (a_ds3231_iic_multiple_read(handle, DS3231_REG_CONTROL, (uint8_t *)buf, 2) != 0)   /* read control and status */
+        {
+            return 1;                                                                         /* return error */
+        }
+        handle->control_shadow = buf[0];                                                      /* set control shadow */
+        handle->status_shadow = buf[1];                                                       /* set status shadow */
+        handle->cache_valid = 1;                                                              /* set cache valid */
     }
-    t->am_pm = (ds3231_am_pm_t)((buf[2] >> 5) & 0x01);                                                                                    /* get am pm */
-    t->format = (ds3231_format_t)((buf[2] >> 6) & 0x01);                                                                                  /* get format */
-    if (t->format == DS3231_FORMAT_12H)                                                                                                   /* if 12H */
+    if (reg == DS3231_REG_CONTROL)                                                            /* if control */
     {
-        t->hour = a_ds3231_bcd2hex(buf[2]&0x1F);                                                                                          /* get hour */
+        *data = handle->control_shadow;                                                       /* get control shadow */
     }
-    else                                                                                                                                  /* if 24H */
+    else                                                                                      /* if status */
     {
-        t->hour = a_ds3231_bcd2hex(buf[2]&0x3F);                                                                                          /* get hour */
+        *data = handle->status_shadow;                                                        /* get status shadow */
     }
-    t->minute = a_ds3231_bcd2hex(buf[1] & 0x7F);                                                                                          /* get minute */
-    t->second = a_ds3231_bcd2hex(buf[0] & 0x7F);                                                                                          /* get second */
-    *mode = (ds3231_alarm1_mode_t)(((buf[0]>>7)&0x01)<<0 | ((buf[1]>>7)&0x01)<<1 | ((buf[2]>>7)&0x01)<<2 | ((buf[3]>>7)&0x01)<<3 |
-                                   ((buf[3] >> 6)&0x01)<<4
-                                  );                                                                                                      /* get mode */
     
-    return 0;                                                                                                                             /* success return 0 */
+    return 0;                                                                                 /* success return 0 */
 }
 
 /**
- * @brief     set the alarm2 time
+ * @brief     write the control or status register and update the shadow cache
  * @param[in] *handle pointer to a ds3231 handle structure
- * @param[in] *t pointer to a time structure
- * @param[in] mode alarm2 interrupt mode
+ * @param[in] reg DS3231_REG_CONTROL or DS3231_REG_STATUS
+ * @param[in] data written data
  * @return    status code
  *            - 0 success
- *            - 1 set alarm2 failed
- *            - 2 handle or time is NULL
- *            - 3 handle is not initialized
- * @note      none
+ *            - 1 write failed
+ * @note      the self clearing conv bit is never kept in the control shadow
  */
-uint8_t ds3231_set_alarm2(ds3231_handle_t *handle, ds3231_time_t *t, ds3231_alarm2_mode_t mode)
+static uint8_t a_ds3231_shadow_write(ds3231_handle_t *handle, uint8_t reg, uint8_t data)
 {
-    uint8_t res;
-    uint8_t reg;
-    
-    if (handle == NULL)                                                                                                            /* check handle */
+    if (a_ds3231_iic_write(handle, reg, data) != 0)                                           /* write data */
     {
-        return 2;                                                                                                                  /* return error */
+        handle->cache_valid = 0;                                                              /* invalidate the cache */
+        
+        return 1;                                                                             /* return error */
     }
-    if (handle->inited != 1)                                                                                                       /* check handle initialization */
+    if (reg == DS3231_REG_CONTROL)                                                            /* if control */
     {
-        return 3;                                                                                                                  /* return error */
+        handle->control_shadow = data & (uint8_t)(~(1 << 5));                                 /* set control shadow */
     }
-    if (t == NULL)                                                                                                                 /* check time */
+    else                                                                                      /* if status */
     {
-        handle->debug_print("ds3231: time is null.\n");                                                                            /* time is null */
-        
-        return 2;                                                                                                                  /* return error */
+        handle->status_shadow = data;                                                         /* set status shadow */
     }
-    if (t->format == DS3231_FORMAT_12H)                                                                                            /* if 12H */
+    
+    return 0;                                                                                 /* success return 0 */
+}
+
+/**
+ * @brief     hex to bcd
+ * @param[in] val hex data
+ * @return    bcd data
+ * @note      callers range check the value, anything over 99 encodes as 0
+ */
+static uint8_t a_ds3231_hex2bcd(uint8_t val)
+{
+    if (val > 99)                        /* check range */
     {
-        if ((t->week == 0) || (t->week > 7))                                                                                       /* check week */
+        return 0x00;                     /* return zero */
+    }
+    
+    return gs_hex2bcd[val];              /* return bcd */
+}
+
+/**
+ * @brief     bcd to hex
+ * @param[in] val bcd data
+ * @return    hex data
+ * @note      an invalid bcd byte returns 0xFF
+ */
+static uint8_t a_ds3231_bcd2hex(uint8_t val)
+{
+    return gs_bcd2hex[val];              /* return hex */
+}
+
+/**
+ * @brief      decode the temperature registers
+ * @param[in]  *buf pointer to the 2 bytes temperature registers
+ * @param[out] *raw pointer to a raw temperature buffer
+ * @param[out] *s pointer to a converted temperature buffer
+ * @note       none
+ */
+static void a_ds3231_temperature_decode(uint8_t *buf, int16_t *raw, float *s)
+{
+    *raw = (int16_t)(((uint16_t)buf[0]) << 8) | buf[1];                   /* set raw temperature */
+    *s = (float)((int8_t)(buf[0])) + (float)(buf[1] >> 6) * 0.25f;        /* set converted temperature */
+}
+
+/**
+ * @brief      encode the time registers
+ * @param[in]  *handle pointer to a ds3231 handle structure
+ * @param[in]  *t pointer to a time structure
+ * @param[out] *buf pointer to a 7 bytes register buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 time is invalid
+ * @note       none
+ */
+static uint8_t a_ds3231_time_encode(ds3231_handle_t *handle, ds3231_time_t *t, uint8_t *buf)
+{
+    uint8_t century;
+    uint16_t year;
+    
+    if (t->format == DS3231_FORMAT_12H)                                                                  /* if 12H */
+    {
+        if ((t->year < 2000) || (t->year > 2199))                                                        /* check year */
         {
-            handle->debug_print("ds3231: week can't be zero or over than 7.\n");                                                   /* week can't be zero or over than 7 */
+            DS3231_DEBUG_PRINT(handle, "ds3231: year can't be over 2199 or less than 2000.\n");          /* year can't be over 2199 or less than 2000 */
             
-            return 1;                                                                                                              /* return error */
+            return 1;                                                                                    /* return error */
         }
-        if ((t->date == 0) || (t->date > 31))                                                                                      /* check data */
+        if ((t->month == 0) || (t->month > 12))                                                          /* check month */
         {
-            handle->debug_print("ds3231: date can't be zero or over than 31.\n");                                                  /* date can't be zero or over than 31 */
+            DS3231_DEBUG_PRINT(handle, "ds3231: month can't be zero or over than 12.\n");                /* month can't be zero or over than 12 */
             
-            return 1;                                                                                                              /* return error */
+            return 1;                                                                                    /* return error */
         }
-        if ((t->hour < 1) || (t->hour > 12))                                                                                       /* check hour */
+        if ((t->week == 0) || (t->week > 7))                                                             /* check week */
         {
-            handle->debug_print("ds3231: hour can't be over than 12 or less 1.\n");                                                /* hour can't be over than 12 or less 1 */
+            DS3231_DEBUG_PRINT(handle, "ds3231: week can't be zero or over than 7.\n");                  /* week can't be zero or over than 7 */
             
-            return 1;                                                                                                              /* return error */
+            return 1;                                                                                    /* return error */
+        }
+        if ((t->date == 0) || (t->date > 31))                                                            /* check data */
+        {
+            DS3231_DEBUG_PRINT(handle, "ds3231: date can't be zero or over than 31.\n");                 /* date can't be zero or over than 31 */
+            
+            return 1;                                                                                    /* return error */
+        }
+        if ((t->hour < 1) || (t->hour > 12))                                                             /* check hour */
+        {
+            DS3231_DEBUG_PRINT(handle, "ds3231: hour can't be over than 12 or less 1.\n");               /* hour can't be over than 12 or less 1 */
+            
+            return 1;                                                                                    /* return error */
+        }
+        if (t->minute > 59)                                                                              /* check minute */
+        {
+            DS3231_DEBUG_PRINT(handle, "ds3231: minute can't be over than 59.\n");                       /* minute can't be over than 59 */
+            
+            return 1;                                                                                    /* return error */
+        }
+        if (t->second > 59)                                                                              /* check second */
+        {
+            DS3231_DEBUG_PRINT(handle, "ds3231: second can't be over than 59.\n");                       /* second can't be over than 59 */
+            
+            return 1;                                                                                    /* return error */
+        }
+    }
+    else if (t->format == DS3231_FORMAT_24H)                                                             /* if 24H */
+    {
+        if ((t->year < 2000) || (t->year > 2199))                                                        /* check year */
+        {
+            DS3231_DEBUG_PRINT(handle, "ds3231: year can't be over 2199 or less than 2000.\n");          /* year can't be over 2199 or less than 2000 */
+            
+            return 1;                                                                                    /* return error */
+        }
+        if ((t->month == 0) || (t->month > 12))                                                          /* check month */
+        {
+            DS3231_DEBUG_PRINT(handle, "ds3231: month can't be zero or over than 12.\n");                /* month can't be zero or over than 12 */
+            
+            return 1;                                                                                    /* return error */
+        }
+        if ((t->week == 0) || (t->week > 7))                                                             /* check week */
+        {
+            DS3231_DEBUG_PRINT(handle, "ds3231: week can't be zero or over than 7.\n");                  /* week can't be zero or over than 7 */
+            
+            return 1;                                                                                    /* return error */
+        }
+        if ((t->date == 0) || (t->date > 31))                                                            /* check data */
+        {
+            DS3231_DEBUG_PRINT(handle, "ds3231: date can't be zero or over than 31.\n");                 /* date can't be zero or over than 31 */
+            
+            return 1;                                                                                    /* return error */
+        }
+        if (t->hour > 23)                                                                                /* check hour */
+        {
+            DS3231_DEBUG_PRINT(handle, "ds3231: hour can't be over than 23.\n");                         /* hour can't be over than 23 */
+            
+            return 1;                                                                                    /* return error */
+        }
+        if (t->minute > 59)                                                                              /* check minute */
+        {
+            DS3231_DEBUG_PRINT(handle, "ds3231: minute can't be over than 59.\n");                       /* minute can't be over than 59 */
+            
+            return 1;                                                                                    /* return error */
+        }
+        if (t->second > 59)                                                                              /* check second */
+        {
+            DS3231_DEBUG_PRINT(handle, "ds3231: second can't be over than 59.\n");                       /* second can't be over than 59 */
+            
+            return 1;                                                                                    /* return error */
+        }
+    }
+    else
+    {
+        DS3231_DEBUG_PRINT(handle, "ds3231: format is invalid.\n");                                      /* format is invalid */
+        
+        return 1;                                                                                        /* return error */
+    }
+    
+    buf[0] = a_ds3231_hex2bcd(t->second);                                                                /* set second */
+    buf[1] = a_ds3231_hex2bcd(t->minute);                                                                /* set minute */
+    if (t->format == DS3231_FORMAT_12H)                                                                  /* if 12H */
+    {
+        buf[2] = (uint8_t)((1 << 6) | (t->am_pm << 5) | a_ds3231_hex2bcd(t->hour));                      /* set hour in 12H */
+    }
+    else                                                                                                 /* if 24H */
+    {
+        buf[2] = (0 << 6) | a_ds3231_hex2bcd(t->hour);                                                   /* set hour in 24H */
+    }
+    buf[3] = a_ds3231_hex2bcd(t->week);                                                                  /* set week */
+    buf[4] = a_ds3231_hex2bcd(t->date);                                                                  /* set date */
+    year = t->year - 2000;                                                                               /* year - 2000 */
+    if (year >= 100)                                                                                     /* check year */
+    {
+        century = 1;                                                                                     /* set century */
+        year -= 100;                                                                                     /* year -= 100 */
+    }
+    else
+    {
+        century = 0;                                                                                     /* set century 0 */
+    }
+    buf[5] = a_ds3231_hex2bcd(t->month) | (century << 7);                                                /* set month and century */
+    buf[6] = a_ds3231_hex2bcd((uint8_t)year);                                                            /* set year */
+    
+    return 0;                                                                                            /* success return 0 */
+}
+
+/**
+ * @brief      decode the time registers
+ * @param[in]  *buf pointer to the 7 bytes time registers
+ * @param[out] *t pointer to a time structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 registers hold an invalid bcd value
+ * @note       every field is decoded even when a field is invalid
+ */
+static uint8_t a_ds3231_time_decode(uint8_t *buf, ds3231_time_t *t)
+{
+    uint8_t year;
+    
+    year = a_ds3231_bcd2hex(buf[6]);                                                                     /* get year in the century */
+    t->year = (uint16_t)(year + 2000 + ((buf[5] >> 7) & 0x01) * 100);                                    /* get year */
+    t->month = a_ds3231_bcd2hex(buf[5] & 0x1F);                                                          /* get month */
+    t->week = a_ds3231_bcd2hex(buf[3]);                                                                  /* get week */
+    t->date = a_ds3231_bcd2hex(buf[4]);                                                                  /* get date */
+    t->am_pm = (ds3231_am_pm_t)((buf[2] >> 5) & 0x01);                                                   /* get am pm */
+    t->format = (ds3231_format_t)((buf[2] >> 6) & 0x01);                                                 /* get format */
+    if (t->format == DS3231_FORMAT_12H)                                                                  /* if 12H */
+    {
+        t->hour = a_ds3231_bcd2hex(buf[2] & 0x1F);                                                       /* get hour */
+    }
+    else
+    {
+        t->hour = a_ds3231_bcd2hex(buf[2] & 0x3F);                                                       /* get hour */
+    }
+    t->minute = a_ds3231_bcd2hex(buf[1]);                                                                /* get minute */
+    t->second = a_ds3231_bcd2hex(buf[0]);                                                                /* get second */
+    
+    return ((year | t->month | t->week | t->date | t->hour | t->minute | t->second) >> 7) & 0x01;        /* 0xFF marks an invalid field */
+}
+
+/**
+ * @brief      decode the alarm1 registers
+ * @param[in]  *buf pointer to the 4 bytes alarm1 registers
+ * @param[out] *t pointer to a time structure
+ * @param[out] *mode pointer to an alarm1 interrupt mode buffer
+ * @note       none
+ */
+static void a_ds3231_alarm1_decode(uint8_t *buf, ds3231_time_t *t, ds3231_alarm1_mode_t *mode)
+{
+    t->year = 0;                                                                                                                          /* get year */
+    t->month = 0;                                                                                                                         /* get month */
+    if (((buf[3] >> 6) & 0x01) != 0)                                                                                                      /* if week */
+    {
+        t->week = a_ds3231_bcd2hex(buf[3] & 0x0F);                                                                                        /* get week */
+        t->date = 0;                                                                                                                      /* get data */
+    }
+    else                                                                                                                                  /* if data */
+    {
+        t->week = 0;                                                                                                                      /* get week */
+        t->date = a_ds3231_bcd2hex(buf[3] & 0x3F);                                                                                        /* get data */
+    }
+    t->am_pm = (ds3231_am_pm_t)((buf[2] >> 5) & 0x01);                                                                                    /* get am pm */
+    t->format = (ds3231_format_t)((buf[2] >> 6) & 0x01);                                                                                  /* get format */
+    if (t->format == DS3231_FORMAT_12H)                                                                                                   /* if 12H */
+    {
+        t->hour = a_ds3231_bcd2hex(buf[2]&0x1F);                                                                                          /* get hour */
+    }
+    else                                                                                                                                  /* if 24H */
+    {
+        t->hour = a_ds3231_bcd2hex(buf[2]&0x3F);                                                                                          /* get hour */
+    }
+    t->minute = a_ds3231_bcd2hex(buf[1] & 0x7F);                                                                                          /* get minute */
+    t->second = a_ds3231_bcd2hex(buf[0] & 0x7F);                                                                                          /* get second */
+    *mode = (ds3231_alarm1_mode_t)(((buf[0]>>7)&0x01)<<0 | ((buf[1]>>7)&0x01)<<1 | ((buf[2]>>7)&0x01)<<2 | ((buf[3]>>7)&0x01)<<3 |
+                                   ((buf[3] >> 6)&0x01)<<4
+                                  );                                                                                                      /* get mode */
+}
+
+/**
+ * @brief      decode the alarm2 registers
+ * @param[in]  *buf pointer to the 3 bytes alarm2 registers
+ * @param[out] *t pointer to a time structure
+ * @param[out] *mode pointer to an alarm2 interrupt mode buffer
+ * @note       none
+ */
+static void a_ds3231_alarm2_decode(uint8_t *buf, ds3231_time_t *t, ds3231_alarm2_mode_t *mode)
+{
+    t->year = 0;                                                                                                                          /* get year */
+    t->month = 0;                                                                                                                         /* get month */
+    if (((buf[2] >> 6) & 0x01) != 0)                                                                                                      /* if week */
+    {
+        t->week = a_ds3231_bcd2hex(buf[2] & 0x0F);                                                                                        /* get week */
+        t->date = 0;                                                                                                                      /* get data */
+    }
+    else                                                                                                                                  /* if data */
+    {
+        t->week = 0;                                                                                                                      /* get week */
+        t->date = a_ds3231_bcd2hex(buf[2] & 0x3F);                                                                                        /* get data */
+    }
+    t->am_pm = (ds3231_am_pm_t)((buf[1] >> 5) & 0x01);                                                                                    /* get am pm */
+    t->format = (ds3231_format_t)((buf[1] >> 6) & 0x01);                                                                                  /* get format */
+    if (t->format == DS3231_FORMAT_12H)                                                                                                   /* if 12H */
+    {
+        t->hour = a_ds3231_bcd2hex(buf[1]&0x1F);                                                                                          /* get hour */
+    }
+    else                                                                                                                                  /* if 24H */
+    {
+        t->hour = a_ds3231_bcd2hex(buf[1]&0x3F);                                                                                          /* get hour */
+    }
+    t->minute = a_ds3231_bcd2hex(buf[0] & 0x7F);                                                                                          /* get minute */
+    t->second = 0;                                                                                                                        /* get second */
+    *mode = (ds3231_alarm2_mode_t)(((buf[0]>>7)&0x01)<<0 | ((buf[1]>>7)&0x01)<<1 | ((buf[2]>>7)&0x01)<<2 | ((buf[2]>>6)&0x01)<<4);        /* get mode */
+}
+
+/**
+ * @brief      encode the alarm1 registers
+ * @param[in]  *handle pointer to a ds3231 handle structure
+ * @param[in]  *t pointer to a time structure
+ * @param[in]  mode alarm1 interrupt mode
+ * @param[out] *buf pointer to a 4 bytes register buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 time is invalid
+ * @note       none
+ */
+static uint8_t a_ds3231_alarm1_encode(ds3231_handle_t *handle, ds3231_time_t *t, ds3231_alarm1_mode_t mode, uint8_t *buf)
+{
+    if (t->format == DS3231_FORMAT_12H)                                                                                            /* if 12H */
+    {
+        if ((t->week == 0) || (t->week > 7))                                                                                       /* check week */
+        {
+            DS3231_DEBUG_PRINT(handle, "ds3231: week can't be zero or over than 7.\n");                                            /* week can't be zero or over than 7 */
+            
+            return 1;                                                                                                              /* return error */
+        }
+        if ((t->date == 0) || (t->date > 31))                                                                                      /* check data */
+        {
+            DS3231_DEBUG_PRINT(handle, "ds3231: date can't be zero or over than 31.\n");                                           /* date can't be zero or over than 31 */
+            
+            return 1;                                                                                                              /* return error */
+        }
+        if ((t->hour < 1) || (t->hour > 12))                                                                                       /* check hour */
+        {
+            DS3231_DEBUG_PRINT(handle, "ds3231: hour can't be over than 12 or less 1.\n");                                         /* hour can't be over than 12 or less 1 */
+            
+            return 1;                                                                                                              /* return error */
+        }
+        if (t->minute > 59)                                                                                                        /* check minute */
+        {
+            DS3231_DEBUG_PRINT(handle, "ds3231: minute can't be over than 59.\n");                                                 /* minute can't be over than 59 */
+            
+            return 1;                                                                                                              /* return error */
+        }
+        if (t->second > 59)                                                                                                        /* check second  */
+        {
+            DS3231_DEBUG_PRINT(handle, "ds3231: second can't be over than 59.\n");                                                 /* second can't be over than 59 */
+            
+            return 1;                                                                                                              /* return error */
+        }
+    }
+    else if (t->format == DS3231_FORMAT_24H)                                                                                       /* if 24H */
+    {
+        if ((t->week == 0) || (t->week > 7))                                                                                       /* check week */
+        {
+            DS3231_DEBUG_PRINT(handle, "ds3231: week can't be zero or over than 7.\n");                                            /* week can't be zero or over than 7 */
+            
+            return 1;                                                                                                              /* return error */
+        }
+        if ((t->date == 0) || (t->date > 31))                                                                                      /* check data */
+        {
+            DS3231_DEBUG_PRINT(handle, "ds3231: date can't be zero or over than 31.\n");                                           /* date can't be zero or over than 31 */
+            
+            return 1;                                                                                                              /* return error */
+        }
+        if (t->hour > 23)                                                                                                          /* check hour */
+        {
+            DS3231_DEBUG_PRINT(handle, "ds3231: hour can't be over than 23.\n");                                                   /* hour can't be over than 23 */
+            
+            return 1;                                                                                                              /* return error */
+        }
+        if (t->minute > 59)                                                                                                        /* check minute */
+        {
+            DS3231_DEBUG_PRINT(handle, "ds3231: minute can't be over than 59.\n");                                                 /* minute can't be over than 59 */
+            
+            return 1;                                                                                                              /* return error */
+        }
+        if (t->second > 59)                                                                                                        /* check second */
+        {
+            DS3231_DEBUG_PRINT(handle, "ds3231: second can't be over than 59.\n");                                                 /* second can't be over than 59 */
+            
+            return 1;                                                                                                              /* return error */
+        }
+    }
+    else
+    {
+        DS3231_DEBUG_PRINT(handle, "ds3231: format is invalid.\n");                                                                /* format is invalid */
+        
+        return 1;                                                                                                                  /* return error */
+    }
+    
+    buf[0] = a_ds3231_hex2bcd(t->second) | ((mode & 0x01) << 7);                                                                   /* set second */
+    buf[1] = a_ds3231_hex2bcd(t->minute) | (((mode >> 1) & 0x01) << 7);                                                            /* set minute */
+    if (t->format == DS3231_FORMAT_12H)                                                                                            /* if 12H */
+    {
+        buf[2] = (uint8_t)((((mode >> 2) & 0x01) << 7) | (1 << 6) | (t->am_pm << 5) | a_ds3231_hex2bcd(t->hour));                  /* set hour in 12H */
+    }
+    else                                                                                                                           /* if 24H */
+    {
+        buf[2] = (((mode >> 2) & 0x01) << 7) | a_ds3231_hex2bcd(t->hour);                                                          /* set hour in 24H */
+    }
+    if (mode >= DS3231_ALARM1_MODE_WEEK_HOUR_MINUTE_SECOND_MATCH)                                                                  /* if week */
+    {
+        buf[3] = (((mode >> 3) & 0x01) << 7) | (1 << 6) | a_ds3231_hex2bcd(t->week);                                               /* set data in week */
+    }
+    else                                                                                                                           /* if day */
+    {
+        buf[3] = (((mode >> 3) & 0x01) << 7) | a_ds3231_hex2bcd(t->date);                                                          /* set data in date */
+    }
+    
+    return 0;                                                                                                                      /* success return 0 */
+}
+
+/**
+ * @brief      encode the alarm2 registers
+ * @param[in]  *handle pointer to a ds3231 handle structure
+ * @param[in]  *t pointer to a time structure
+ * @param[in]  mode alarm2 interrupt mode
+ * @param[out] *buf pointer to a 3 bytes register buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 time is invalid
+ * @note       none
+ */
+static uint8_t a_ds3231_alarm2_encode(ds3231_handle_t *handle, ds3231_time_t *t, ds3231_alarm2_mode_t mode, uint8_t *buf)
+{
+    if (t->format == DS3231_FORMAT_12H)                                                                                            /* if 12H */
+    {
+        if ((t->week == 0) || (t->week > 7))                                                                                       /* check week */
+        {
+            DS3231_DEBUG_PRINT(handle, "ds3231: week can't be zero or over than 7.\n");                                            /* week can't be zero or over than 7 */
+            
+            return 1;                                                                                                              /* return error */
+        }
+        if ((t->date == 0) || (t->date > 31))                                                                                      /* check data */
+        {
+            DS3231_DEBUG_PRINT(handle, "ds3231: date can't be zero or over than 31.\n");                                           /* date can't be zero or over than 31 */
+            
+            return 1;                                                                                                              /* return error */
+        }
+        if ((t->hour < 1) || (t->hour > 12))                                                                                       /* check hour */
+        {
+            DS3231_DEBUG_PRINT(handle, "ds3231: hour can't be over than 12 or less 1.\n");                                         /* hour can't be over than 12 or less 1 */
+            
+            return 1;                                                                                                              /* return error */
         }
         if (t->minute > 59)                                                                                                        /* check minute */
         {
-            handle->debug_print("ds3231: minute can't be over than 59.\n");                                                        /* minute can't be over than 59 */
+            DS3231_DEBUG_PRINT(handle, "ds3231: minute can't be over than 59.\n");                                                 /* minute can't be over than 59 */
             
             return 1;                                                                                                              /* return error */
         }
@@ -702,158 +1093,792 @@ uint8_t ds3231_set_alarm2(ds3231_handle_t *handle, ds3231_time_t *t, ds3231_alar
     {
         if ((t->week == 0) || (t->week > 7))                                                                                       /* check week */
         {
-            handle->debug_print("ds3231: week can't be zero or over than 7.\n");                                                   /* week can't be zero or over than 7 */
+            DS3231_DEBUG_PRINT(handle, "ds3231: week can't be zero or over than 7.\n");                                            /* week can't be zero or over than 7 */
             
             return 1;                                                                                                              /* return error */
         }
         if ((t->date == 0) || (t->date > 31))                                                                                      /* check data */
         {
-            handle->debug_print("ds3231: date can't be zero or over than 31.\n");                                                  /* date can't be zero or over than 31 */
+            DS3231_DEBUG_PRINT(handle, "ds3231: date can't be zero or over than 31.\n");                                           /* date can't be zero or over than 31 */
             
             return 1;                                                                                                              /* return error */
         }
         if (t->hour > 23)                                                                                                          /* check hour */
         {
-            handle->debug_print("ds3231: hour can't be over than 23.\n");                                                          /* hour can't be over than 23 */
+            DS3231_DEBUG_PRINT(handle, "ds3231: hour can't be over than 23.\n");                                                   /* hour can't be over than 23 */
             
             return 1;                                                                                                              /* return error */
         }
         if (t->minute > 59)                                                                                                        /* check minute */
         {
-            handle->debug_print("ds3231: minute can't be over than 59.\n");                                                        /* minute can't be over than 59 */
+            DS3231_DEBUG_PRINT(handle, "ds3231: minute can't be over than 59.\n");                                                 /* minute can't be over than 59 */
             
             return 1;                                                                                                              /* return error */
         }
     }
     else
     {
-        handle->debug_print("ds3231: format is invalid.\n");                                                                       /* format is invalid */
-        
-        return 1;                                                                                                                  /* return error */
+        DS3231_DEBUG_PRINT(handle, "ds3231: format is invalid.\n");                                                                /* format is invalid */
+        
+        return 1;                                                                                                                  /* return error */
+    }
+    
+    buf[0] = a_ds3231_hex2bcd(t->minute) | (((mode >> 0) & 0x01) << 7);                                                            /* set minute */
+    if (t->format == DS3231_FORMAT_12H)                                                                                            /* if 12H */
+    {
+        buf[1] = (uint8_t)((((mode >> 1) & 0x01) << 7) | (1 << 6) | (t->am_pm << 5) | a_ds3231_hex2bcd(t->hour));                  /* set hour in 12H */
+    }
+    else                                                                                                                           /* if 24H */
+    {
+        buf[1] = (((mode >> 1) & 0x01) << 7) | a_ds3231_hex2bcd(t->hour);                                                          /* set hour in 24H */
+    }
+    if (mode >= (uint8_t)DS3231_ALARM2_MODE_WEEK_HOUR_MINUTE_MATCH)                                                                /* if week */
+    {
+        buf[2] = (((mode >> 2) & 0x01) << 7) | (1 << 6) | a_ds3231_hex2bcd(t->week);                                               /* set data in week */
+    }
+    else                                                                                                                           /* if day */
+    {
+        buf[2] = (((mode >> 2) & 0x01) << 7) | a_ds3231_hex2bcd(t->date);                                                          /* set data in date */
+    }
+    
+    return 0;                                                                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     set the current time
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @param[in] *t pointer to a time structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 set time failed
+ *            - 2 handle or time is NULL
+ *            - 3 handle is not initialized
+ *            - 4 time is invalid
+ * @note      none
+ */
+uint8_t ds3231_set_time(ds3231_handle_t *handle, ds3231_time_t *t)
+{
+    uint8_t res;
+    uint8_t buf[7];
+    
+    if (handle == NULL)                                                                                      /* check handle */
+    {
+        return 2;                                                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                                                 /* check handle initialization */
+    {
+        return 3;                                                                                            /* return error */
+    }
+    if (t == NULL)                                                                                           /* check time */
+    {
+        DS3231_DEBUG_PRINT(handle, "ds3231: time is null.\n");                                               /* time is null */
+        
+        return 2;                                                                                            /* return error */
+    }
+    res = a_ds3231_time_encode(handle, t, (uint8_t *)buf);                                                   /* encode time */
+    if (res != 0)                                                                                            /* check result */
+    {
+        return 4;                                                                                            /* return error */
+    }
+    a_ds3231_lock(handle, DS3231_LOCK_WRITE, DS3231_STATS_API_SET_TIME);                                     /* lock */
+    res = a_ds3231_iic_multiple_write(handle, DS3231_REG_SECOND, (uint8_t *)buf, 7);                         /* write time in one burst */
+    if (res != 0)                                                                                            /* check result */
+    {
+        DS3231_DEBUG_PRINT(handle, "ds3231: write time failed.\n");                                          /* write time failed */
+        a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                                          /* unlock */
+        
+        return 1;                                                                                            /* return error */
+    }
+    a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                                              /* unlock */
+    
+    return 0;                                                                                                /* success return 0 */
+}
+
+/**
+ * @brief      get the current time
+ * @param[in]  *handle pointer to a ds3231 handle structure
+ * @param[out] *t pointer to a time structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 get time failed
+ *             - 2 handle or time is NULL
+ *             - 3 handle is not initialized
+ *             - 4 time register is invalid
+ * @note       none
+ */
+uint8_t ds3231_get_time(ds3231_handle_t *handle, ds3231_time_t *t)
+{
+    uint8_t res;
+    uint8_t buf[7];
+    
+    if (handle == NULL)                                                                   /* check handle */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (handle->inited != 1)                                                              /* check handle initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    if (t == NULL)                                                                        /* check time */
+    {
+        DS3231_DEBUG_PRINT(handle, "ds3231: time is null.\n");                            /* time is null */
+        
+        return 2;                                                                         /* return error */
+    }
+    
+    memset(buf, 0, sizeof(uint8_t) * 7);                                                  /* clear the buffer */
+    a_ds3231_lock(handle, DS3231_LOCK_READ, DS3231_STATS_API_GET_TIME);                   /* lock */
+    res = a_ds3231_iic_multiple_read(handle, DS3231_REG_SECOND, (uint8_t *)buf, 7);       /* multiple_read */
+    if (res != 0)                                                                         /* check result */
+    {
+        DS3231_DEBUG_PRINT(handle, "ds3231: multiple read failed.\n");                    /* multiple read failed */
+        a_ds3231_unlock(handle, DS3231_LOCK_READ);                                        /* unlock */
+        
+        return 1;                                                                         /* return error */
+    }
+    res = a_ds3231_time_decode((uint8_t *)buf, t);                                        /* decode time */
+    if (res != 0)                                                                         /* check result */
+    {
+        DS3231_DEBUG_PRINT(handle, "ds3231: time register is invalid bcd.\n");            /* time register is invalid bcd */
+        a_ds3231_unlock(handle, DS3231_LOCK_READ);                                        /* unlock */
+        
+        return 4;                                                                         /* return error */
+    }
+    a_ds3231_unlock(handle, DS3231_LOCK_READ);                                            /* unlock */
+    
+    return 0;                                                                             /* success return 0 */
+}
+
+/**
+ * @brief     set the alarm1 time
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @param[in] *t pointer to a time structure
+ * @param[in] mode alarm1 interrupt mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 set alarm1 failed
+ *            - 2 handle or time is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ds3231_set_alarm1(ds3231_handle_t *handle, ds3231_time_t *t, ds3231_alarm1_mode_t mode)
+{
+    uint8_t res;
+    uint8_t buf[4];
+    
+    if (handle == NULL)                                                                                                            /* check handle */
+    {
+        return 2;                                                                                                                  /* return error */
+    }
+    if (handle->inited != 1)                                                                                                       /* check handle initialization */
+    {
+        return 3;                                                                                                                  /* return error */
+    }
+    if (t == NULL)                                                                                                                 /* check time */
+    {
+        DS3231_DEBUG_PRINT(handle, "ds3231: time is null.\n");                                                                     /* time is null */
+        
+        return 2;                                                                                                                  /* return error */
+    }
+    
+    res = a_ds3231_alarm1_encode(handle, t, mode, (uint8_t *)buf);                                                                 /* encode alarm1 */
+    if (res != 0)                                                                                                                  /* check result */
+    {
+        return 1;                                                                                                                  /* return error */
+    }
+    a_ds3231_lock(handle, DS3231_LOCK_WRITE, DS3231_STATS_API_SET_ALARM1);                                                         /* lock */
+    res = a_ds3231_iic_multiple_write(handle, DS3231_REG_ALARM1_SECOND, (uint8_t *)buf, 4);                                        /* write alarm1 in one burst */
+    if (res != 0)                                                                                                                  /* check result */
+    {
+        DS3231_DEBUG_PRINT(handle, "ds3231: write alarm1 failed.\n");                                                              /* write alarm1 failed */
+        a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                                                                /* unlock */
+        
+        return 1;                                                                                                                  /* return error */
+    }
+    a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                                                                    /* unlock */
+    
+    return 0;                                                                                                                      /* success return 0 */
+}
+
+/**
+ * @brief      get the alarm1 time
+ * @param[in]  *handle pointer to a ds3231 handle structure
+ * @param[out] *t pointer to a time structure
+ * @param[out] *mode pointer to an alarm1 interrupt mode buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get alarm1 failed
+ *             - 2 handle or time is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds3231_get_alarm1(ds3231_handle_t *handle, ds3231_time_t *t, ds3231_alarm1_mode_t *mode)
+{
+    uint8_t res;
+    uint8_t buf[4];
+    
+    if (handle == NULL)                                                                                                                   /* check handle */
+    {
+        return 2;                                                                                                                         /* return error */
+    }
+    if (handle->inited != 1)                                                                                                              /* check handle initialization */
+    {
+        return 3;                                                                                                                         /* return error */
+    }
+    if (t == NULL)                                                                                                                        /* check time */
+    {
+        DS3231_DEBUG_PRINT(handle, "ds3231: time is null.\n");                                                                            /* time is null */
+        
+        return 2;                                                                                                                         /* return error */
+    }
+    
+    memset(buf, 0, sizeof(uint8_t) * 4);                                                                                                  /* clear the buffer */
+    a_ds3231_lock(handle, DS3231_LOCK_READ, DS3231_STATS_API_GET_ALARM1);                                                                 /* lock */
+    res = a_ds3231_iic_multiple_read(handle, DS3231_REG_ALARM1_SECOND, (uint8_t *)buf, 4);                                                /* multiple_read */
+    if (res != 0)                                                                                                                         /* check result */
+    {
+        DS3231_DEBUG_PRINT(handle, "ds3231: multiple read failed.\n");                                                                    /* multiple read failed */
+        a_ds3231_unlock(handle, DS3231_LOCK_READ);                                                                                        /* unlock */
+        
+        return 1;                                                                                                                         /* return error */
+    }
+    a_ds3231_alarm1_decode((uint8_t *)buf, t, mode);                                                                                      /* decode alarm1 */
+    a_ds3231_unlock(handle, DS3231_LOCK_READ);                                                                                            /* unlock */
+    
+    return 0;                                                                                                                             /* success return 0 */
+}
+
+/**
+ * @brief     set the alarm2 time
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @param[in] *t pointer to a time structure
+ * @param[in] mode alarm2 interrupt mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 set alarm2 failed
+ *            - 2 handle or time is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ds3231_set_alarm2(ds3231_handle_t *handle, ds3231_time_t *t, ds3231_alarm2_mode_t mode)
+{
+    uint8_t res;
+    uint8_t buf[3];
+    
+    if (handle == NULL)                                                                                                            /* check handle */
+    {
+        return 2;                                                                                                                  /* return error */
+    }
+    if (handle->inited != 1)                                                                                                       /* check handle initialization */
+    {
+        return 3;                                                                                                                  /* return error */
+    }
+    if (t == NULL)                                                                                                                 /* check time */
+    {
+        DS3231_DEBUG_PRINT(handle, "ds3231: time is null.\n");                                                                     /* time is null */
+        
+        return 2;                                                                                                                  /* return error */
+    }
+    
+    res = a_ds3231_alarm2_encode(handle, t, mode, (uint8_t *)buf);                                                                 /* encode alarm2 */
+    if (res != 0)                                                                                                                  /* check result */
+    {
+        return 1;                                                                                                                  /* return error */
+    }
+    a_ds3231_lock(handle, DS3231_LOCK_WRITE, DS3231_STATS_API_SET_ALARM2);                                                         /* lock */
+    res = a_ds3231_iic_multiple_write(handle, DS3231_REG_ALARM2_MINUTE, (uint8_t *)buf, 3);                                        /* write alarm2 in one burst */
+    if (res != 0)                                                                                                                  /* check result */
+    {
+        DS3231_DEBUG_PRINT(handle, "ds3231: write alarm2 failed.\n");                                                              /* write alarm2 failed */
+        a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                                                                /* unlock */
+        
+        return 1;                                                                                                                  /* return error */
+    }
+    a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                                                                    /* unlock */
+    
+    return 0;                                                                                                                      /* success return 0 */
+}
+
+/**
+ * @brief      get the alarm2 time
+ * @param[in]  *handle pointer to a ds3231 handle structure
+ * @param[out] *t pointer to a time structure
+ * @param[out] *mode pointer to an alarm2 interrupt mode buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get alarm2 failed
+ *             - 2 handle or time is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds3231_get_alarm2(ds3231_handle_t *handle, ds3231_time_t *t, ds3231_alarm2_mode_t *mode)
+{
+    uint8_t res;
+    uint8_t buf[3];
+    
+    if (handle == NULL)                                                                                                                   /* check handle */
+    {
+        return 2;                                                                                                                         /* return error */
+    }
+    if (handle->inited != 1)                                                                                                              /* check handle initialization */
+    {
+        return 3;                                                                                                                         /* return error */
+    }
+    if (t == NULL)                                                                                                                        /* check time */
+    {
+        DS3231_DEBUG_PRINT(handle, "ds3231: time is null.\n");                                                                            /* time is null */
+        
+        return 2;                                                                                                                         /* return error */
+    }
+    
+    memset(buf, 0, sizeof(uint8_t) * 3);                                                                                                  /* clear the buffer */
+    a_ds3231_lock(handle, DS3231_LOCK_READ, DS3231_STATS_API_GET_ALARM2);                                                                 /* lock */
+    res = a_ds3231_iic_multiple_read(handle, DS3231_REG_ALARM2_MINUTE, (uint8_t *)buf, 3);                                                /* multiple read */
+    if (res != 0)                                                                                                                         /* check result */
+    {
+        DS3231_DEBUG_PRINT(handle, "ds3231: multiple read failed.\n");                                                                    /* multiple read failed */
+        a_ds3231_unlock(handle, DS3231_LOCK_READ);                                                                                        /* unlock */
+        
+        return 1;                                                                                                                         /* return error */
+    }
+    a_ds3231_alarm2_decode((uint8_t *)buf, t, mode);                                                                                      /* decode alarm2 */
+    a_ds3231_unlock(handle, DS3231_LOCK_READ);                                                                                            /* unlock */
+    
+    return 0;                                                                                                                             /* success return 0 */
+}
+
+/**
+ * @brief     set the alarm1 and alarm2 time in one transaction
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @param[in] *t1 pointer to an alarm1 time structure
+ * @param[in] mode1 alarm1 interrupt mode
+ * @param[in] *t2 pointer to an alarm2 time structure
+ * @param[in] mode2 alarm2 interrupt mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 set alarms failed
+ *            - 2 handle or time is NULL
+ *            - 3 handle is not initialized
+ * @note      both alarms are validated before anything is written
+ */
+uint8_t ds3231_set_alarms(ds3231_handle_t *handle, ds3231_time_t *t1, ds3231_alarm1_mode_t mode1, ds3231_time_t *t2, ds3231_alarm2_mode_t mode2)
+{
+    uint8_t res;
+    uint8_t buf[7];
+    
+    if (handle == NULL)                                                                                                            /* check handle */
+    {
+        return 2;                                                                                                                  /* return error */
+    }
+    if (handle->inited != 1)                                                                                                       /* check handle initialization */
+    {
+        return 3;                                                                                                                  /* return error */
+    }
+    if ((t1 == NULL) || (t2 == NULL))                                                                                              /* check time */
+    {
+        DS3231_DEBUG_PRINT(handle, "ds3231: time is null.\n");                                                                     /* time is null */
+        
+        return 2;                                                                                                                  /* return error */
+    }
+    
+    res = a_ds3231_alarm1_encode(handle, t1, mode1, (uint8_t *)&buf[0]);                                                           /* encode alarm1 */
+    if (res != 0)                                                                                                                  /* check result */
+    {
+        return 1;                                                                                                                  /* return error */
+    }
+    res = a_ds3231_alarm2_encode(handle, t2, mode2, (uint8_t *)&buf[4]);                                                           /* encode alarm2 */
+    if (res != 0)                                                                                                                  /* check result */
+    {
+        return 1;                                                                                                                  /* return error */
+    }
+    a_ds3231_lock(handle, DS3231_LOCK_WRITE, DS3231_STATS_API_SET_ALARMS);                                                         /* lock */
+    res = a_ds3231_iic_multiple_write(handle, DS3231_REG_ALARM1_SECOND, (uint8_t *)buf, 7);                                        /* write both alarms in one burst */
+    if (res != 0)                                                                                                                  /* check result */
+    {
+        DS3231_DEBUG_PRINT(handle, "ds3231: write alarms failed.\n");                                                              /* write alarms failed */
+        a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                                                                /* unlock */
+        
+        return 1;                                                                                                                  /* return error */
+    }
+    a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                                                                    /* unlock */
+    
+    return 0;                                                                                                                      /* success return 0 */
+}
+
+/**
+ * @brief     enable or disable the oscillator
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set oscillator failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ds3231_set_oscillator(ds3231_handle_t *handle, ds3231_bool_t enable)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    if (handle == NULL)                                                                      /* check handle */
+    {
+        return 2;                                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                                 /* check handle initialization */
+    {
+        return 3;                                                                            /* return error */
+    }
+    
+    a_ds3231_lock(handle, DS3231_LOCK_WRITE, DS3231_STATS_API_SET_OSCILLATOR);               /* lock */
+    res = a_ds3231_shadow_read(handle, DS3231_REG_CONTROL, (uint8_t *)&prev);                /* read control */
+    if (res != 0)                                                                            /* check result */
+    {
+        DS3231_DEBUG_PRINT(handle, "ds3231: read control failed.\n");                        /* read control failed */
+        a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                          /* unlock */
+        
+        return 1;                                                                            /* return error */
+    }
+    prev &= ~ (1 << 7);                                                                      /* clear config */
+    prev |= (!enable) << 7;                                                                  /* set enable */
+    res = a_ds3231_shadow_write(handle, DS3231_REG_CONTROL, prev);                           /* write control */
+    if (res != 0)                                                                            /* check result */
+    {
+        DS3231_DEBUG_PRINT(handle, "ds3231: write control failed.\n");                       /* write control failed */
+        a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                          /* unlock */
+        
+        return 1;                                                                            /* return error */
+    }
+    a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                              /* unlock */
+    
+    return 0;                                                                                /* success return 0 */
+}
+
+/**
+ * @brief      get the chip oscillator status
+ * @param[in]  *handle pointer to a ds3231 handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get oscillator failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds3231_get_oscillator(ds3231_handle_t *handle, ds3231_bool_t *enable)
+{
+    uint8_t res;
+    uint8_t prev;
+    ds3231_lock_t lock;
+    
+    if (handle == NULL)                                                                      /* check handle */
+    {
+        return 2;                                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                                 /* check handle initialization */
+    {
+        return 3;                                                                            /* return error */
+    }
+    
+    lock = a_ds3231_shadow_lock(handle, DS3231_STATS_API_GET_OSCILLATOR);                    /* lock */
+    res = a_ds3231_shadow_read(handle, DS3231_REG_CONTROL, (uint8_t *)&prev);                /* read control */
+    if (res != 0)                                                                            /* check result */
+    {
+        DS3231_DEBUG_PRINT(handle, "ds3231: read control failed.\n");                        /* read control failed */
+        a_ds3231_unlock(handle, lock);                                                       /* unlock */
+        
+        return 1;                                                                            /* return error */
+    }
+    *enable = (ds3231_bool_t)(!((prev >> 7) & 0x01));                                        /* get enable */
+    a_ds3231_unlock(handle, lock);                                                           /* unlock */
+    
+    return 0;                                                                                /* success return 0 */
+}
+
+/**
+ * @brief     enable or disable the alarm interrupt
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @param[in] alarm alarm number
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set alarm interrupt failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ds3231_set_alarm_interrupt(ds3231_handle_t *handle, ds3231_alarm_t alarm, ds3231_bool_t enable)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    if (handle == NULL)                                                                      /* check handle */
+    {
+        return 2;                                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                                 /* check handle initialization */
+    {
+        return 3;                                                                            /* return error */
+    }
+    
+    a_ds3231_lock(handle, DS3231_LOCK_WRITE, DS3231_STATS_API_SET_ALARM_INTERRUPT);          /* lock */
+    res = a_ds3231_shadow_read(handle, DS3231_REG_CONTROL, (uint8_t *)&prev);                /* read control */
+    if (res != 0)                                                                            /* check result */
+    {
+        DS3231_DEBUG_PRINT(handle, "ds3231: read control failed.\n");                        /* read control failed */
+        a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                          /* unlock */
+        
+        return 1;                                                                            /* return error */
+    }
+    prev &= ~(1 << alarm);                                                                   /* clear config */
+    prev |= enable << alarm;                                                                 /* set enable */
+    res = a_ds3231_shadow_write(handle, DS3231_REG_CONTROL, prev);                           /* write control */
+    if (res != 0)                                                                            /* check result */
+    {
+        DS3231_DEBUG_PRINT(handle, "ds3231: write control failed.\n");                       /* write control failed */
+        a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                          /* unlock */
+        
+        return 1;                                                                            /* return error */
+    }
+    a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                              /* unlock */
+    
+    return 0;                                                                                /* success return 0 */
+}
+
+/**
+ * @brief      get the alarm interrupt status
+ * @param[in]  *handle pointer to a ds3231 handle structure
+ * @param[in]  alarm alarm number
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get alarm interrupt failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds3231_get_alarm_interrupt(ds3231_handle_t *handle, ds3231_alarm_t alarm, ds3231_bool_t *enable)
+{
+    uint8_t res;
+    uint8_t prev;
+    ds3231_lock_t lock;
+    
+    if (handle == NULL)                                                                      /* check handle */
+    {
+        return 2;                                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                                 /* check handle initialization */
+    {
+        return 3;                                                                            /* return error */
+    }
+    
+    lock = a_ds3231_shadow_lock(handle, DS3231_STATS_API_GET_ALARM_INTERRUPT);               /* lock */
+    res = a_ds3231_shadow_read(handle, DS3231_REG_CONTROL, (uint8_t *)&prev);                /* read control */
+    if (res != 0)                                                                            /* check result */
+    {
+        DS3231_DEBUG_PRINT(handle, "ds3231: read control failed.\n");                        /* read control failed */
+        a_ds3231_unlock(handle, lock);                                                       /* unlock */
+        
+        return 1;                                                                            /* return error */
+    }
+    *enable = (ds3231_bool_t)((prev >> alarm) & 0x01);                                       /* get enable */
+    a_ds3231_unlock(handle, lock);                                                           /* unlock */
+    
+    return 0;                                                                                /* success return 0 */
+}
+
+/**
+ * @brief     set the chip pin function
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @param[in] pin pin function
+ * @return    status code
+ *            - 0 success
+ *            - 1 set pin failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ds3231_set_pin(ds3231_handle_t *handle, ds3231_pin_t pin)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    if (handle == NULL)                                                                      /* check handle */
+    {
+        return 2;                                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                                 /* check handle initialization */
+    {
+        return 3;                                                                            /* return error */
+    }
+    
+    a_ds3231_lock(handle, DS3231_LOCK_WRITE, DS3231_STATS_API_SET_PIN);                      /* lock */
+    res = a_ds3231_shadow_read(handle, DS3231_REG_CONTROL, (uint8_t *)&prev);                /* read control */
+    if (res != 0)                                                                            /* check result */
+    {
+        DS3231_DEBUG_PRINT(handle, "ds3231: read control failed.\n");                        /* read control failed */
+        a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                          /* unlock */
+        
+        return 1;                                                                            /* return error */
+    }
+    prev &= ~(1 << 2);                                                                       /* clear config */
+    prev |= pin << 2;                                                                        /* set pin */
+    res = a_ds3231_shadow_write(handle, DS3231_REG_CONTROL, prev);                           /* write control */
+    if (res != 0)                                                                            /* check result */
+    {
+        DS3231_DEBUG_PRINT(handle, "ds3231: write control failed.\n");                       /* write control failed */
+        a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                          /* unlock */
+        
+        return 1;                                                                            /* return error */
+    }
+    a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                              /* unlock */
+    
+    return 0;                                                                                /* success return 0 */
+}
+
+/**
+ * @brief      get the chip pin function
+ * @param[in]  *handle pointer to a ds3231 handle structure
+ * @param[out] *pin pointer to a pin's function buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get pin failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds3231_get_pin(ds3231_handle_t *handle, ds3231_pin_t *pin)
+{
+    uint8_t res;
+    uint8_t prev;
+    ds3231_lock_t lock;
+    
+    if (handle == NULL)                                                                      /* check handle */
+    {
+        return 2;                                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                                 /* check handle initialization */
+    {
+        return 3;                                                                            /* return error */
     }
     
-    res = a_ds3231_iic_write(handle, DS3231_REG_ALARM2_MINUTE, a_ds3231_hex2bcd(t->minute) | (((mode >> 0) & 0x01) << 7));         /* write minute */
-    if (res != 0)                                                                                                                  /* check result */
+    lock = a_ds3231_shadow_lock(handle, DS3231_STATS_API_GET_PIN);                           /* lock */
+    res = a_ds3231_shadow_read(handle, DS3231_REG_CONTROL, (uint8_t *)&prev);                /* read control */
+    if (res != 0)                                                                            /* check result */
     {
-        handle->debug_print("ds3231: write alarm2 minute failed.\n");                                                              /* write alarm2 minute failed */
+        DS3231_DEBUG_PRINT(handle, "ds3231: read control failed.\n");                        /* read control failed */
+        a_ds3231_unlock(handle, lock);                                                       /* unlock */
         
-        return 1;                                                                                                                  /* return error */
+        return 1;                                                                            /* return error */
     }
-    if (t->format == DS3231_FORMAT_12H)                                                                                            /* if 12H */
+    *pin = (ds3231_pin_t)((prev >> 2) & 0x01);                                               /* get pin */
+    a_ds3231_unlock(handle, lock);                                                           /* unlock */
+    
+    return 0;                                                                                /* success return 0 */
+}
+
+/**
+ * @brief     enable or disable the square wave output
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 1 set square wave failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ds3231_set_square_wave(ds3231_handle_t *handle, ds3231_bool_t enable)
+{
+    uint8_t res;
+    uint8_t prev;
+    
+    if (handle == NULL)                                                                      /* check handle */
     {
-        reg = (uint8_t)((((mode >> 1) & 0x01) << 7) | (1 << 6) | (t->am_pm << 5) | a_ds3231_hex2bcd(t->hour));                     /* set hour in 12H */
+        return 2;                                                                            /* return error */
     }
-    else                                                                                                                           /* if 24H */
+    if (handle->inited != 1)                                                                 /* check handle initialization */
     {
-        reg = (((mode >> 1) & 0x01) << 7) | a_ds3231_hex2bcd(t->hour);                                                             /* set hour in 24H */
+        return 3;                                                                            /* return error */
     }
-    res = a_ds3231_iic_write(handle, DS3231_REG_ALARM2_HOUR, reg);                                                                 /* write hour */
-    if (res != 0)                                                                                                                  /* check result */
+    
+    a_ds3231_lock(handle, DS3231_LOCK_WRITE, DS3231_STATS_API_SET_SQUARE_WAVE);              /* lock */
+    res = a_ds3231_shadow_read(handle, DS3231_REG_CONTROL, (uint8_t *)&prev);                /* read control */
+    if (res != 0)                                                                            /* check result */
     {
-        handle->debug_print("ds3231: write alarm2 hour failed.\n");                                                                /* write alarm2 hour failed */
+        DS3231_DEBUG_PRINT(handle, "ds3231: read control failed.\n");                        /* read control failed */
+        a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                          /* unlock */
         
-        return 1;                                                                                                                  /* return error */
-    }
-    if (mode >= (uint8_t)DS3231_ALARM2_MODE_WEEK_HOUR_MINUTE_MATCH)                                                                /* if week */
-    {
-        reg = (((mode >> 2) & 0x01) << 7) | (1 << 6) | a_ds3231_hex2bcd(t->week);                                                  /* set data in week */
-    }
-    else                                                                                                                           /* if day */
-    {
-        reg = (((mode >> 2) & 0x01) << 7) | a_ds3231_hex2bcd(t->date);                                                             /* set data in date */
+        return 1;                                                                            /* return error */
     }
-    res = a_ds3231_iic_write(handle, DS3231_REG_ALARM2_WEEK, reg);                                                                 /* write week */
-    if (res != 0)                                                                                                                  /* check result */
+    prev &= ~(1 << 6);                                                                       /* clear config */
+    prev |= enable << 6;                                                                     /* set enable */
+    res = a_ds3231_shadow_write(handle, DS3231_REG_CONTROL, prev);                           /* write control */
+    if (res != 0)                                                                            /* check result */
     {
-        handle->debug_print("ds3231: write alarm2 week failed.\n");                                                                /* write alarm2 week failed */
+        DS3231_DEBUG_PRINT(handle, "ds3231: write control failed.\n");                       /* write control failed */
+        a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                          /* unlock */
         
-        return 1;                                                                                                                  /* return error */
+        return 1;                                                                            /* return error */
     }
+    a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                              /* unlock */
     
-    return 0;                                                                                                                      /* success return 0 */
+    return 0;                                                                                /* success return 0 */
 }
 
 /**
- * @brief      get the alarm2 time
+ * @brief      get the square wave output status
  * @param[in]  *handle pointer to a ds3231 handle structure
- * @param[out] *t pointer to a time structure
- * @param[out] *mode pointer to an alarm2 interrupt mode buffer
+ * @param[out] *enable pointer to a bool value buffer
  * @return     status code
  *             - 0 success
- *             - 1 get alarm2 failed
- *             - 2 handle or time is NULL
+ *             - 1 get square wave failed
+ *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t ds3231_get_alarm2(ds3231_handle_t *handle, ds3231_time_t *t, ds3231_alarm2_mode_t *mode)
+uint8_t ds3231_get_square_wave(ds3231_handle_t *handle, ds3231_bool_t *enable)
 {
     uint8_t res;
-    uint8_t buf[3];
+    uint8_t prev;
+    ds3231_lock_t lock;
     
-    if (handle == NULL)                                                                                                                   /* check handle */
-    {
-        return 2;                                                                                                                         /* return error */
-    }
-    if (handle->inited != 1)                                                                                                              /* check handle initialization */
+    if (handle == NULL)                                                                      /* check handle */
     {
-        return 3;                                                                                                                         /* return error */
+        return 2;                                                                            /* return error */
     }
-    if (t == NULL)                                                                                                                        /* check time */
+    if (handle->inited != 1)                                                                 /* check handle initialization */
     {
-        handle->debug_print("ds3231: time is null.\n");                                                                                   /* time is null */
-        
-        return 2;                                                                                                                         /* return error */
+        return 3;                                                                            /* return error */
     }
     
-    memset(buf, 0, sizeof(uint8_t) * 3);                                                                                                  /* clear the buffer */
-    res = a_ds3231_iic_multiple_read(handle, DS3231_REG_ALARM2_MINUTE, (uint8_t *)buf, 3);                                                /* multiple read */
-    if (res != 0)                                                                                                                         /* check result */
+    lock = a_ds3231_shadow_lock(handle, DS3231_STATS_API_GET_SQUARE_WAVE);                   /* lock */
+    res = a_ds3231_shadow_read(handle, DS3231_REG_CONTROL, (uint8_t *)&prev);                /* read control */
+    if (res != 0)                                                                            /* check result */
     {
-        handle->debug_print("ds3231: multiple read failed.\n");                                                                           /* multiple read failed */
+        DS3231_DEBUG_PRINT(handle, "ds3231: read control failed.\n");                        /* read control failed */
+        a_ds3231_unlock(handle, lock);                                                       /* unlock */
         
-        return 1;                                                                                                                         /* return error */
-    }
-    t->year = 0;                                                                                                                          /* get year */
-    t->month = 0;                                                                                                                         /* get month */
-    if (((buf[2] >> 6) & 0x01) != 0)                                                                                                      /* if week */
-    {
-        t->week = a_ds3231_bcd2hex(buf[2] & 0x0F);                                                                                        /* get week */
-        t->date = 0;                                                                                                                      /* get data */
-    }
-    else                                                                                                                                  /* if data */
-    {
-        t->week = 0;                                                                                                                      /* get week */
-        t->date = a_ds3231_bcd2hex(buf[2] & 0x3F);                                                                                        /* get data */
-    }
-    t->am_pm = (ds3231_am_pm_t)((buf[1] >> 5) & 0x01);                                                                                    /* get am pm */
-    t->format = (ds3231_format_t)((buf[1] >> 6) & 0x01);                                                                                  /* get format */
-    if (t->format == DS3231_FORMAT_12H)                                                                                                   /* if 12H */
-    {
-        t->hour = a_ds3231_bcd2hex(buf[1]&0x1F);                                                                                          /* get hour */
-    }
-    else                                                                                                                                  /* if 24H */
-    {
-        t->hour = a_ds3231_bcd2hex(buf[1]&0x3F);                                                                                          /* get hour */
+        return 1;                                                                            /* return error */
     }
-    t->minute = a_ds3231_bcd2hex(buf[0] & 0x7F);                                                                                          /* get minute */
-    t->second = 0;                                                                                                                        /* get second */
-    *mode = (ds3231_alarm2_mode_t)(((buf[0]>>7)&0x01)<<0 | ((buf[1]>>7)&0x01)<<1 | ((buf[2]>>7)&0x01)<<2 | ((buf[2]>>6)&0x01)<<4);        /* get mode */
+    *enable = (ds3231_bool_t)((prev >> 6) & 0x01);                                           /* get enable */
+    a_ds3231_unlock(handle, lock);                                                           /* unlock */
     
-    return 0;                                                                                                                             /* success return 0 */
+    return 0;                                                                                /* success return 0 */
 }
 
 /**
- * @brief     enable or disable the oscillator
+ * @brief     set the square wave output frequency
  * @param[in] *handle pointer to a ds3231 handle structure
- * @param[in] enable bool value
+ * @param[in] frequency square wave frequency
  * @return    status code
  *            - 0 success
- *            - 1 set oscillator failed
+ *            - 1 set square wave frequency failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      the frequency is only output when the pin is set to the square wave function
  */
-uint8_t ds3231_set_oscillator(ds3231_handle_t *handle, ds3231_bool_t enable)
+uint8_t ds3231_set_square_wave_frequency(ds3231_handle_t *handle, ds3231_square_wave_frequency_t frequency)
 {
     uint8_t res;
     uint8_t prev;
@@ -867,41 +1892,46 @@ uint8_t ds3231_set_oscillator(ds3231_handle_t *handle, ds3231_bool_t enable)
         return 3;                                                                            /* return error */
     }
     
-    res = a_ds3231_iic_multiple_read(handle, DS3231_REG_CONTROL, (uint8_t *)&prev, 1);       /* multiple read */
+    a_ds3231_lock(handle, DS3231_LOCK_WRITE, DS3231_STATS_API_SET_SQUARE_WAVE_FREQUENCY);    /* lock */
+    res = a_ds3231_shadow_read(handle, DS3231_REG_CONTROL, (uint8_t *)&prev);                /* read control */
     if (res != 0)                                                                            /* check result */
     {
-        handle->debug_print("ds3231: read control failed.\n");                               /* read control failed */
+        DS3231_DEBUG_PRINT(handle, "ds3231: read control failed.\n");                        /* read control failed */
+        a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                          /* unlock */
         
         return 1;                                                                            /* return error */
     }
-    prev &= ~ (1 << 7);                                                                      /* clear config */
-    prev |= (!enable) << 7;                                                                  /* set enable */
-    res = a_ds3231_iic_write(handle, DS3231_REG_CONTROL, prev);                              /* write control */
+    prev &= ~(3 << 3);                                                                       /* clear config */
+    prev |= (frequency & 0x03) << 3;                                                         /* set frequency */
+    res = a_ds3231_shadow_write(handle, DS3231_REG_CONTROL, prev);                           /* write control */
     if (res != 0)                                                                            /* check result */
     {
-        handle->debug_print("ds3231: write control failed.\n");                              /* write control failed */
+        DS3231_DEBUG_PRINT(handle, "ds3231: write control failed.\n");                       /* write control failed */
+        a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                          /* unlock */
         
         return 1;                                                                            /* return error */
     }
+    a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                              /* unlock */
     
     return 0;                                                                                /* success return 0 */
 }
 
 /**
- * @brief      get the chip oscillator status
+ * @brief      get the square wave output frequency
  * @param[in]  *handle pointer to a ds3231 handle structure
- * @param[out] *enable pointer to a bool value buffer
+ * @param[out] *frequency pointer to a square wave frequency buffer
  * @return     status code
  *             - 0 success
- *             - 1 get oscillator failed
+ *             - 1 get square wave frequency failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t ds3231_get_oscillator(ds3231_handle_t *handle, ds3231_bool_t *enable)
+uint8_t ds3231_get_square_wave_frequency(ds3231_handle_t *handle, ds3231_square_wave_frequency_t *frequency)
 {
     uint8_t res;
     uint8_t prev;
+    ds3231_lock_t lock;
     
     if (handle == NULL)                                                                      /* check handle */
     {
@@ -912,35 +1942,235 @@ uint8_t ds3231_get_oscillator(ds3231_handle_t *handle, ds3231_bool_t *enable)
         return 3;                                                                            /* return error */
     }
     
-    res = a_ds3231_iic_multiple_read(handle, DS3231_REG_CONTROL, (uint8_t *)&prev, 1);       /* multiple read */
+    lock = a_ds3231_shadow_lock(handle, DS3231_STATS_API_GET_SQUARE_WAVE_FREQUENCY);         /* lock */
+    res = a_ds3231_shadow_read(handle, DS3231_REG_CONTROL, (uint8_t *)&prev);                /* read control */
     if (res != 0)                                                                            /* check result */
     {
-        handle->debug_print("ds3231: read control failed.\n");                               /* read control failed */
+        DS3231_DEBUG_PRINT(handle, "ds3231: read control failed.\n");                        /* read control failed */
+        a_ds3231_unlock(handle, lock);                                                       /* unlock */
         
         return 1;                                                                            /* return error */
     }
-    *enable = (ds3231_bool_t)(!((prev >> 7) & 0x01));                                        /* get enable */
+    *frequency = (ds3231_square_wave_frequency_t)((prev >> 3) & 0x03);                       /* get frequency */
+    a_ds3231_unlock(handle, lock);                                                           /* unlock */
     
     return 0;                                                                                /* success return 0 */
 }
 
 /**
- * @brief     enable or disable the alarm interrupt
+ * @brief     start a temperature conversion
  * @param[in] *handle pointer to a ds3231 handle structure
- * @param[in] alarm alarm number
- * @param[in] enable bool value
  * @return    status code
  *            - 0 success
- *            - 1 set alarm interrupt failed
+ *            - 1 start temperature conversion failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      returns at once, use ds3231_poll_temperature to get the result
  */
-uint8_t ds3231_set_alarm_interrupt(ds3231_handle_t *handle, ds3231_alarm_t alarm, ds3231_bool_t enable)
+uint8_t ds3231_start_temperature_conversion(ds3231_handle_t *handle)
 {
     uint8_t res;
     uint8_t prev;
     
+    if (handle == NULL)                                                                             /* check handle */
+    {
+        return 2;                                                                                   /* return error */
+    }
+    if (handle->inited != 1)                                                                        /* check handle initialization */
+    {
+        return 3;                                                                                   /* return error */
+    }
+    
+    a_ds3231_lock(handle, DS3231_LOCK_WRITE, DS3231_STATS_API_START_TEMPERATURE_CONVERSION);        /* lock */
+    res = a_ds3231_shadow_read(handle, DS3231_REG_CONTROL, (uint8_t *)&prev);                       /* read control */
+    if (res != 0)                                                                                   /* check result */
+    {
+        DS3231_DEBUG_PRINT(handle, "ds3231: read control failed.\n");                               /* read control failed */
+        a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                                 /* unlock */
+        
+        return 1;                                                                                   /* return error */
+    }
+    prev &= ~(1 << 5);                                                                              /* clear config */
+    prev |= 1 << 5;                                                                                 /* set enable */
+    res = a_ds3231_shadow_write(handle, DS3231_REG_CONTROL, prev);                                  /* write control */
+    if (res != 0)                                                                                   /* check result */
+    {
+        DS3231_DEBUG_PRINT(handle, "ds3231: write control failed.\n");                              /* write control failed */
+        a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                                 /* unlock */
+        
+        return 1;                                                                                   /* return error */
+    }
+    a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                                     /* unlock */
+    
+    return 0;                                                                                       /* success return 0 */
+}
+
+/**
+ * @brief      poll the temperature conversion
+ * @param[in]  *handle pointer to a ds3231 handle structure
+ * @param[out] *raw pointer to a raw temperature buffer
+ * @param[out] *s pointer to a converted temperature buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 poll temperature failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 conversion is busy
+ * @note       control, status and temperature are read in one transaction
+ */
+uint8_t ds3231_poll_temperature(ds3231_handle_t *handle, int16_t *raw, float *s)
+{
+    uint8_t res;
+    uint8_t buf[5];
+    
+    if (handle == NULL)                                                                     /* check handle */
+    {
+        return 2;                                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                                /* check handle initialization */
+    {
+        return 3;                                                                           /* return error */
+    }
+    
+    memset(buf, 0, sizeof(uint8_t) * 5);                                                    /* clear the buffer */
+    a_ds3231_lock(handle, DS3231_LOCK_READ, DS3231_STATS_API_POLL_TEMPERATURE);             /* lock */
+    res = a_ds3231_iic_multiple_read(handle, DS3231_REG_CONTROL, (uint8_t *)buf, 5);        /* read control to temperature */
+    if (res != 0)                                                                           /* check result */
+    {
+        DS3231_DEBUG_PRINT(handle, "ds3231: read temperature failed.\n");                   /* read temperature failed */
+        a_ds3231_unlock(handle, DS3231_LOCK_READ);                                          /* unlock */
+        
+        return 1;                                                                           /* return error */
+    }
+    if ((((buf[0] >> 5) & 0x01) != 0) || (((buf[1] >> 2) & 0x01) != 0))                     /* check conv and busy */
+    {
+        a_ds3231_unlock(handle, DS3231_LOCK_READ);                                          /* unlock */
+        return 4;                                                                           /* return busy */
+    }
+    a_ds3231_temperature_decode((uint8_t *)&buf[3], raw, s);                                /* decode temperature */
+    a_ds3231_unlock(handle, DS3231_LOCK_READ);                                              /* unlock */
+    
+    return 0;                                                                               /* success return 0 */
+}
+
+/**
+ * @brief      get the chip temperature without starting a conversion
+ * @param[in]  *handle pointer to a ds3231 handle structure
+ * @param[out] *raw pointer to a raw temperature buffer
+ * @param[out] *s pointer to a converted temperature buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get temperature failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the chip converts by itself every 64 seconds, so the value is at most 64 seconds old
+ */
+uint8_t ds3231_get_temperature_no_conversion(ds3231_handle_t *handle, int16_t *raw, float *s)
+{
+    uint8_t res;
+    uint8_t buf[2];
+    
+    if (handle == NULL)                                                                             /* check handle */
+    {
+        return 2;                                                                                   /* return error */
+    }
+    if (handle->inited != 1)                                                                        /* check handle initialization */
+    {
+        return 3;                                                                                   /* return error */
+    }
+    
+    memset(buf, 0, sizeof(uint8_t) * 2);                                                            /* clear the buffer */
+    a_ds3231_lock(handle, DS3231_LOCK_READ, DS3231_STATS_API_GET_TEMPERATURE_NO_CONVERSION);        /* lock */
+    res = a_ds3231_iic_multiple_read(handle, DS3231_REG_TEMPERATUREH, (uint8_t *)buf, 2);           /* read temperature */
+    if (res != 0)                                                                                   /* check result */
+    {
+        DS3231_DEBUG_PRINT(handle, "ds3231: read temperature failed.\n");                           /* read temperature failed */
+        a_ds3231_unlock(handle, DS3231_LOCK_READ);                                                  /* unlock */
+        
+        return 1;                                                                                   /* return error */
+    }
+    a_ds3231_temperature_decode((uint8_t *)buf, raw, s);                                            /* decode temperature */
+    a_ds3231_unlock(handle, DS3231_LOCK_READ);                                                      /* unlock */
+    
+    return 0;                                                                                       /* success return 0 */
+}
+
+/**
+ * @brief      get the chip temperature
+ * @param[in]  *handle pointer to a ds3231 handle structure
+ * @param[out] *raw pointer to a raw temperature buffer
+ * @param[out] *s pointer to a converted temperature buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get temperature failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       blocks until the conversion finishes
+ */
+uint8_t ds3231_get_temperature(ds3231_handle_t *handle, int16_t *raw, float *s)
+{
+    uint8_t res;
+    uint32_t times;
+    
+    if (handle == NULL)                                                                     /* check handle */
+    {
+        return 2;                                                                           /* return error */
+    }
+    if (handle->inited != 1)                                                                /* check handle initialization */
+    {
+        return 3;                                                                           /* return error */
+    }
+    
+    res = ds3231_start_temperature_conversion(handle);                                      /* start conversion */
+    if (res != 0)                                                                           /* check result */
+    {
+        return 1;                                                                           /* return error */
+    }
+    times = 500;                                                                            /* set 5s */
+    while (times != 0)                                                                      /* check times */
+    {
+        handle->delay_ms(10);                                                               /* delay 10 ms */
+        res = ds3231_poll_temperature(handle, raw, s);                                      /* poll temperature */
+        if (res == 0)                                                                       /* check result */
+        {
+#if (DS3231_STATS_ENABLE != 0)
+            a_ds3231_stats_conversion(handle, (500 - times + 1) * 10);                      /* count the wait */
+#endif
+            
+            return 0;                                                                       /* success return 0 */
+        }
+        else if (res != 4)                                                                  /* check error */
+        {
+            return 1;                                                                       /* return error */
+        }
+        else
+        {
+            times--;                                                                        /* times-- */
+        }
+    }
+#if (DS3231_STATS_ENABLE != 0)
+    a_ds3231_stats_conversion(handle, 500 * 10);                                            /* count the wait */
+#endif
+    DS3231_DEBUG_PRINT(handle, "ds3231: read timeout.\n");                                  /* read timeout */
+    
+    return 1;                                                                               /* return error */
+}
+
+/**
+ * @brief      get the chip status
+ * @param[in]  *handle pointer to a ds3231 handle structure
+ * @param[out] *status pointer to a chip status buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get status failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds3231_get_status(ds3231_handle_t *handle, uint8_t *status)
+{
+    uint8_t res;
+    
     if (handle == NULL)                                                                      /* check handle */
     {
         return 2;                                                                            /* return error */
@@ -950,323 +2180,430 @@ uint8_t ds3231_set_alarm_interrupt(ds3231_handle_t *handle, ds3231_alarm_t alarm
         return 3;                                                                            /* return error */
     }
     
-    res = a_ds3231_iic_multiple_read(handle, DS3231_REG_CONTROL, (uint8_t *)&prev, 1);       /* multiple_read */
-    if (res != 0)                                                                            /* check result */
-    {
-        handle->debug_print("ds3231: read control failed.\n");                               /* read control failed */
-        
-        return 1;                                                                            /* return error */
-    }
-    prev &= ~(1 << alarm);                                                                   /* clear config */
-    prev |= enable << alarm;                                                                 /* set enable */
-    res = a_ds3231_iic_write(handle, DS3231_REG_CONTROL, prev);                              /* write control */
+    a_ds3231_lock(handle, DS3231_LOCK_READ, DS3231_STATS_API_GET_STATUS);                    /* lock */
+    res = a_ds3231_iic_multiple_read(handle, DS3231_REG_STATUS, (uint8_t *)status, 1);       /* multiple read */
     if (res != 0)                                                                            /* check result */
     {
-        handle->debug_print("ds3231: write control failed.\n");                              /* write control failed */
+        DS3231_DEBUG_PRINT(handle, "ds3231: read status failed.\n");                         /* read status failed */
+        a_ds3231_unlock(handle, DS3231_LOCK_READ);                                           /* unlock */
         
         return 1;                                                                            /* return error */
     }
-    
+    a_ds3231_unlock(handle, DS3231_LOCK_READ);                                               /* unlock */
+
     return 0;                                                                                /* success return 0 */
 }
 
 /**
- * @brief      get the alarm interrupt status
+ * @brief      read all registers in one transaction
  * @param[in]  *handle pointer to a ds3231 handle structure
- * @param[in]  alarm alarm number
- * @param[out] *enable pointer to a bool value buffer
+ * @param[out] *snapshot pointer to a snapshot structure
  * @return     status code
  *             - 0 success
- *             - 1 get alarm interrupt failed
- *             - 2 handle is NULL
+ *             - 1 read snapshot failed
+ *             - 2 handle or snapshot is NULL
  *             - 3 handle is not initialized
- * @note       none
+ *             - 4 time register is invalid
+ * @note       the temperature is the last conversion result, no conversion is started
  */
-uint8_t ds3231_get_alarm_interrupt(ds3231_handle_t *handle, ds3231_alarm_t alarm, ds3231_bool_t *enable)
+uint8_t ds3231_read_snapshot(ds3231_handle_t *handle, ds3231_snapshot_t *snapshot)
 {
     uint8_t res;
-    uint8_t prev;
+    uint8_t buf[19];
     
-    if (handle == NULL)                                                                      /* check handle */
+    if (handle == NULL)                                                                                          /* check handle */
     {
-        return 2;                                                                            /* return error */
+        return 2;                                                                                                /* return error */
     }
-    if (handle->inited != 1)                                                                 /* check handle initialization */
+    if (handle->inited != 1)                                                                                     /* check handle initialization */
     {
-        return 3;                                                                            /* return error */
+        return 3;                                                                                                /* return error */
+    }
+    if (snapshot == NULL)                                                                                        /* check snapshot */
+    {
+        DS3231_DEBUG_PRINT(handle, "ds3231: snapshot is null.\n");                                               /* snapshot is null */
+        
+        return 2;                                                                                                /* return error */
     }
     
-    res = a_ds3231_iic_multiple_read(handle, DS3231_REG_CONTROL, (uint8_t *)&prev, 1);       /* multiple_read */
-    if (res != 0)                                                                            /* check result */
+    memset(buf, 0, sizeof(uint8_t) * 19);                                                                        /* clear the buffer */
+    a_ds3231_lock(handle, DS3231_LOCK_WRITE, DS3231_STATS_API_READ_SNAPSHOT);                                    /* lock */
+    res = a_ds3231_iic_multiple_read(handle, DS3231_REG_SECOND, (uint8_t *)buf, 19);                             /* read all registers */
+    if (res != 0)                                                                                                /* check result */
     {
-        handle->debug_print("ds3231: read control failed.\n");                               /* read control failed */
+        DS3231_DEBUG_PRINT(handle, "ds3231: multiple read failed.\n");                                           /* multiple read failed */
+        a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                                              /* unlock */
         
-        return 1;                                                                            /* return error */
+        return 1;                                                                                                /* return error */
+    }
+    res = a_ds3231_time_decode((uint8_t *)&buf[0], &snapshot->time);                                             /* decode time */
+    a_ds3231_alarm1_decode((uint8_t *)&buf[7], &snapshot->alarm1, &snapshot->alarm1_mode);                       /* decode alarm1 */
+    a_ds3231_alarm2_decode((uint8_t *)&buf[11], &snapshot->alarm2, &snapshot->alarm2_mode);                      /* decode alarm2 */
+    snapshot->control = buf[14];                                                                                 /* get control */
+    snapshot->status = buf[15];                                                                                  /* get status */
+    snapshot->aging_offset = (int8_t)buf[16];                                                                    /* get aging offset */
+    a_ds3231_temperature_decode((uint8_t *)&buf[17], &snapshot->raw_temperature, &snapshot->temperature);        /* decode temperature */
+    handle->control_shadow = buf[14] & (uint8_t)(~(1 << 5));                                                     /* refresh control shadow */
+    handle->status_shadow = buf[15];                                                                             /* refresh status shadow */
+    handle->cache_valid = 1;                                                                                     /* set cache valid */
+    if (res != 0)                                                                                                /* check result */
+    {
+        DS3231_DEBUG_PRINT(handle, "ds3231: time register is invalid bcd.\n");                                   /* time register is invalid bcd */
+        a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                                              /* unlock */
+        
+        return 4;                                                                                                /* return error */
     }
-    *enable = (ds3231_bool_t)((prev >> alarm) & 0x01);                                       /* get enable */
+    a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                                                  /* unlock */
     
-    return 0;                                                                                /* success return 0 */
+    return 0;                                                                                                    /* success return 0 */
 }
 
 /**
- * @brief     set the chip pin function
+ * @brief     set the chip aging offset
  * @param[in] *handle pointer to a ds3231 handle structure
- * @param[in] pin pin function
+ * @param[in] offset time aging offset
  * @return    status code
  *            - 0 success
- *            - 1 set pin failed
+ *            - 1 set aging offset failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
  * @note      none
  */
-uint8_t ds3231_set_pin(ds3231_handle_t *handle, ds3231_pin_t pin)
+uint8_t ds3231_set_aging_offset(ds3231_handle_t *handle, int8_t offset)
 {
     uint8_t res;
-    uint8_t prev;
     
-    if (handle == NULL)                                                                      /* check handle */
-    {
-        return 2;                                                                            /* return error */
-    }
-    if (handle->inited != 1)                                                                 /* check handle initialization */
+    if (handle == NULL)                                                                 /* check handle */
     {
-        return 3;                                                                            /* return error */
+        return 2;                                                                       /* return error */
     }
-    
-    res = a_ds3231_iic_multiple_read(handle, DS3231_REG_CONTROL, (uint8_t *)&prev, 1);       /* multiple_read */
-    if (res != 0)                                                                            /* check result */
+    if (handle->inited != 1)                                                            /* check handle initialization */
     {
-        handle->debug_print("ds3231: read control failed.\n");                               /* read control failed */
-        
-        return 1;                                                                            /* return error */
+        return 3;                                                                       /* return error */
     }
-    prev &= ~(1 << 2);                                                                       /* clear config */
-    prev |= pin << 2;                                                                        /* set pin */
-    res = a_ds3231_iic_write(handle, DS3231_REG_CONTROL, prev);                              /* write control */
-    if (res != 0)                                                                            /* check result */
+
+    a_ds3231_lock(handle, DS3231_LOCK_WRITE, DS3231_STATS_API_SET_AGING_OFFSET);        /* lock */
+    res = a_ds3231_iic_write(handle, DS3231_REG_XTAL, offset);                          /* write offset */
+    if (res != 0)                                                                       /* check result */
     {
-        handle->debug_print("ds3231: write control failed.\n");                              /* write control failed */
+        DS3231_DEBUG_PRINT(handle, "ds3231: write offset failed.\n");                   /* write offset failed */
+        a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                     /* unlock */
         
-        return 1;                                                                            /* return error */
+        return 1;                                                                       /* return error */
     }
+    a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                         /* unlock */
     
-    return 0;                                                                                /* success return 0 */
+    return 0;                                                                           /* success return 0 */
 }
 
 /**
- * @brief      get the chip pin function
+ * @brief      get the chip aging offset
  * @param[in]  *handle pointer to a ds3231 handle structure
- * @param[out] *pin pointer to a pin's function buffer
+ * @param[out] *offset pointer to a time aging offset buffer
  * @return     status code
  *             - 0 success
- *             - 1 get pin failed
+ *             - 1 get aging offset failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
  * @note       none
  */
-uint8_t ds3231_get_pin(ds3231_handle_t *handle, ds3231_pin_t *pin)
+uint8_t ds3231_get_aging_offset(ds3231_handle_t *handle, int8_t *offset)
 {
     uint8_t res;
-    uint8_t prev;
     
-    if (handle == NULL)                                                                      /* check handle */
+    if (handle == NULL)                                                                    /* check handle */
     {
-        return 2;                                                                            /* return error */
+        return 2;                                                                          /* return error */
     }
-    if (handle->inited != 1)                                                                 /* check handle initialization */
+    if (handle->inited != 1)                                                               /* check handle initialization */
     {
-        return 3;                                                                            /* return error */
+        return 3;                                                                          /* return error */
     }
-    
-    res = a_ds3231_iic_multiple_read(handle, DS3231_REG_CONTROL, (uint8_t *)&prev, 1);       /* multiple_read */
-    if (res != 0)                                                                            /* check result */
+
+    a_ds3231_lock(handle, DS3231_LOCK_READ, DS3231_STATS_API_GET_AGING_OFFSET);            /* lock */
+    res = a_ds3231_iic_multiple_read(handle, DS3231_REG_XTAL, (uint8_t *)offset, 1);       /* read offset */
+    if (res != 0)                                                                          /* check result */
     {
-        handle->debug_print("ds3231: read control failed.\n");                               /* read control failed */
+        DS3231_DEBUG_PRINT(handle, "ds3231: read offset failed.\n");                       /* read offset failed */
+        a_ds3231_unlock(handle, DS3231_LOCK_READ);                                         /* unlock */
         
-        return 1;                                                                            /* return error */
+        return 1;                                                                          /* return error */
     }
-    *pin = (ds3231_pin_t)((prev >> 2) & 0x01);                                               /* get pin */
+    a_ds3231_unlock(handle, DS3231_LOCK_READ);                                             /* unlock */
     
-    return 0;                                                                                /* success return 0 */
+    return 0;                                                                              /* success return 0 */
 }
 
 /**
- * @brief     enable or disable the square wave output
- * @param[in] *handle pointer to a ds3231 handle structure
- * @param[in] enable bool value
- * @return    status code
- *            - 0 success
- *            - 1 set square wave failed
- *            - 2 handle is NULL
- *            - 3 handle is not initialized
- * @note      none
+ * @brief      convert a aging offset value to a register raw data
+ * @param[in]  *handle pointer to a ds3231 handle structure
+ * @param[in]  offset converted aging offset value
+ * @param[out] *reg pointer to a register raw buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
  */
-uint8_t ds3231_set_square_wave(ds3231_handle_t *handle, ds3231_bool_t enable)
+uint8_t ds3231_aging_offset_convert_to_register(ds3231_handle_t *handle, float offset, int8_t *reg)
 {
-    uint8_t res;
-    uint8_t prev;
-    
-    if (handle == NULL)                                                                      /* check handle */
+    if (handle == NULL)                     /* check handle */
     {
-        return 2;                                                                            /* return error */
+        return 2;                           /* return error */
     }
-    if (handle->inited != 1)                                                                 /* check handle initialization */
+    if (handle->inited != 1)                /* check handle initialization */
     {
-        return 3;                                                                            /* return error */
+        return 3;                           /* return error */
     }
     
-    res = a_ds3231_iic_multiple_read(handle, DS3231_REG_CONTROL, (uint8_t *)&prev, 1);       /* multiple_read */
-    if (res != 0)                                                                            /* check result */
+    *reg = (int8_t)(offset / 0.12f);        /* convert real data to register data */
+    
+    return 0;                               /* success return 0 */
+}
+
+/**
+ * @brief      convert a register raw data to a converted aging offset data
+ * @param[in]  *handle pointer to a ds3231 handle structure
+ * @param[in]  reg register raw data
+ * @param[out] *offset pointer to a converted aging offset buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds3231_aging_offset_convert_to_data(ds3231_handle_t *handle, int8_t reg, float *offset)
+{
+    if (handle == NULL)                    /* check handle */
     {
-        handle->debug_print("ds3231: read control failed.\n");                               /* read control failed */
-        
-        return 1;                                                                            /* return error */
+        return 2;                          /* return error */
     }
-    prev &= ~(1 << 6);                                                                       /* clear config */
-    prev |= enable << 6;                                                                     /* set enable */
-    res = a_ds3231_iic_write(handle, DS3231_REG_CONTROL, prev);                              /* write control */
-    if (res != 0)                                                                            /* check result */
+    if (handle->inited != 1)               /* check handle initialization */
     {
-        handle->debug_print("ds3231: write control failed.\n");                              /* write control failed */
-        
-        return 1;                                                                            /* return error */
+        return 3;                          /* return error */
     }
     
-    return 0;                                                                                /* success return 0 */
+    *offset = (float)(reg) * 0.12f;        /* convert raw data to real data */
+    
+    return 0;                              /* success return 0 */
 }
 
 /**
- * @brief      get the square wave output status
+ * @brief      convert a time structure to the 7 bytes time register image
  * @param[in]  *handle pointer to a ds3231 handle structure
- * @param[out] *enable pointer to a bool value buffer
+ * @param[in]  *t pointer to a time structure
+ * @param[out] *reg pointer to a 7 bytes register buffer
  * @return     status code
  *             - 0 success
- *             - 1 get square wave failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- * @note       none
+ *             - 4 time is invalid
+ * @note       the image can be written to register 0x00 with ds3231_set_reg
  */
-uint8_t ds3231_get_square_wave(ds3231_handle_t *handle, ds3231_bool_t *enable)
+uint8_t ds3231_time_convert_to_register(ds3231_handle_t *handle, ds3231_time_t *t, uint8_t *reg)
 {
-    uint8_t res;
-    uint8_t prev;
-    
-    if (handle == NULL)                                                                      /* check handle */
+    if (handle == NULL)                                               /* check handle */
     {
-        return 2;                                                                            /* return error */
+        return 2;                                                     /* return error */
     }
-    if (handle->inited != 1)                                                                 /* check handle initialization */
+    if (handle->inited != 1)                                          /* check handle initialization */
     {
-        return 3;                                                                            /* return error */
+        return 3;                                                     /* return error */
     }
     
-    res = a_ds3231_iic_multiple_read(handle, DS3231_REG_CONTROL, (uint8_t *)&prev, 1);       /* multiple_read */
-    if (res != 0)                                                                            /* check result */
+    if (a_ds3231_time_encode(handle, t, reg) != 0)                    /* encode time */
     {
-        handle->debug_print("ds3231: read control failed.\n");                               /* read control failed */
-        
-        return 1;                                                                            /* return error */
+        return 4;                                                     /* return error */
     }
-    *enable = (ds3231_bool_t)((prev >> 6) & 0x01);                                           /* get enable */
     
-    return 0;                                                                                /* success return 0 */
+    return 0;                                                         /* success return 0 */
 }
 
 /**
- * @brief      get the chip temperature
+ * @brief      convert the 7 bytes time register image to a time structure
  * @param[in]  *handle pointer to a ds3231 handle structure
- * @param[out] *raw pointer to a raw temperature buffer
- * @param[out] *s pointer to a converted temperature buffer
+ * @param[in]  *reg pointer to a 7 bytes register buffer
+ * @param[out] *t pointer to a time structure
  * @return     status code
  *             - 0 success
- *             - 1 get temperature failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
+ *             - 4 register image holds an invalid bcd value
  * @note       none
  */
-uint8_t ds3231_get_temperature(ds3231_handle_t *handle, int16_t *raw, float *s)
+uint8_t ds3231_time_convert_to_data(ds3231_handle_t *handle, uint8_t *reg, ds3231_time_t *t)
 {
-    uint8_t res;
-    uint8_t prev;
-    uint32_t times;
-    uint8_t buf[2];
-    
-    if (handle == NULL)                                                                         /* check handle */
+    if (handle == NULL)                                               /* check handle */
+    {
+        return 2;                                                     /* return error */
+    }
+    if (handle->inited != 1)                                          /* check handle initialization */
     {
-        return 2;                                                                               /* return error */
+        return 3;                                                     /* return error */
     }
-    if (handle->inited != 1)                                                                    /* check handle initialization */
+    
+    if (a_ds3231_time_decode(reg, t) != 0)                            /* decode time */
     {
-        return 3;                                                                               /* return error */
+        return 4;                                                     /* return error */
     }
     
-    memset(buf, 0, sizeof(uint8_t) * 2);                                                        /* clear the buffer */
-    res = a_ds3231_iic_multiple_read(handle, DS3231_REG_CONTROL, (uint8_t *)&prev, 1);          /* multiple read */
-    if (res != 0)                                                                               /* check result */
+    return 0;                                                         /* success return 0 */
+}
+
+/**
+ * @brief      convert a time structure to a unix timestamp
+ * @param[in]  *handle pointer to a ds3231 handle structure
+ * @param[in]  *t pointer to a time structure
+ * @param[in]  utc_offset utc offset of the time structure in seconds
+ * @param[out] *timestamp pointer to a unix timestamp buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle or time is NULL
+ *             - 3 handle is not initialized
+ *             - 4 time is invalid
+ * @note       proleptic gregorian calendar, the week field is ignored
+ */
+uint8_t ds3231_time_to_unix(ds3231_handle_t *handle, ds3231_time_t *t, int32_t utc_offset, int64_t *timestamp)
+{
+    uint32_t y;
+    uint32_t m;
+    uint32_t hour;
+    uint32_t doy;
+    uint32_t days;
+    
+    if (handle == NULL)                                                                                          /* check handle */
+    {
+        return 2;                                                                                                /* return error */
+    }
+    if (handle->inited != 1)                                                                                     /* check handle initialization */
+    {
+        return 3;                                                                                                /* return error */
+    }
+    if ((t == NULL) || (timestamp == NULL))                                                                      /* check time */
     {
-        handle->debug_print("ds3231: read control failed.\n");                                  /* read control failed */
+        DS3231_DEBUG_PRINT(handle, "ds3231: time is null.\n");                                                   /* time is null */
         
-        return 1;                                                                               /* return error */
+        return 2;                                                                                                /* return error */
     }
-    prev &= ~(1 << 5);                                                                          /* clear config */
-    prev |= 1 << 5;                                                                             /* set enable */
-    res = a_ds3231_iic_write(handle, DS3231_REG_CONTROL, prev);                                 /* write control */
-    if (res != 0)                                                                               /* check result */
+    if ((t->year < 2000) || (t->year > 2199) || (t->month == 0) || (t->month > 12) ||                            /* check time */
+        (t->date == 0) || (t->date > 31) || (t->minute > 59) || (t->second > 59))
     {
-        handle->debug_print("ds3231: write control failed.\n");                                 /* write control failed */
+        DS3231_DEBUG_PRINT(handle, "ds3231: time is invalid.\n");                                                /* time is invalid */
         
-        return 1;                                                                               /* return error */
+        return 4;                                                                                                /* return error */
     }
-    times = 500;                                                                                /* set 5s */
-    while (times != 0)                                                                          /* check times */
+    if (t->format == DS3231_FORMAT_12H)                                                                          /* if 12H */
     {
-        handle->delay_ms(10);                                                                   /* delay 10 ms */
-        res = a_ds3231_iic_multiple_read(handle, DS3231_REG_STATUS, (uint8_t *)&prev, 1);       /* read status */
-        if (res != 0)                                                                           /* check result */
+        if ((t->hour == 0) || (t->hour > 12))                                                                    /* check hour */
         {
-            handle->debug_print("ds3231: read status failed.\n");                               /* read status failed */
+            DS3231_DEBUG_PRINT(handle, "ds3231: time is invalid.\n");                                            /* time is invalid */
             
-            return 1;                                                                           /* return error */
+            return 4;                                                                                            /* return error */
         }
-        if (((prev >> 2) & 0x01) == 0)                                                          /* check result */
+        hour = (uint32_t)(t->hour % 12) + (uint32_t)(t->am_pm) * 12;                                             /* convert to 24H */
+    }
+    else                                                                                                         /* if 24H */
+    {
+        if (t->hour > 23)                                                                                        /* check hour */
         {
-            break;                                                                              /* break */
+            DS3231_DEBUG_PRINT(handle, "ds3231: time is invalid.\n");                                            /* time is invalid */
+            
+            return 4;                                                                                            /* return error */
         }
-        times--;                                                                                /* times-- */
+        hour = t->hour;                                                                                          /* get hour */
+    }
+    
+    y = (uint32_t)t->year - (t->month <= 2);                                                                     /* years start in march */
+    m = (t->month > 2) ? ((uint32_t)t->month - 3) : ((uint32_t)t->month + 9);                                    /* months since march */
+    doy = (153 * m + 2) / 5 + t->date - 1;                                                                       /* day of the year */
+    days = (y - 1600) * 365 + (y - 1600) / 4 - (y - 1600) / 100 + (y - 1600) / 400 + doy;                        /* days since 1600-03-01 */
+    *timestamp = ((int64_t)days - 135080) * 86400 + (int64_t)(hour * 3600 + t->minute * 60 + t->second) -        /* 1600-03-01 is day -135080 */
+                 (int64_t)utc_offset;
+    
+    return 0;                                                                                                    /* success return 0 */
+}
+
+/**
+ * @brief      convert a unix timestamp to a time structure
+ * @param[in]  *handle pointer to a ds3231 handle structure
+ * @param[in]  timestamp unix timestamp
+ * @param[in]  utc_offset utc offset of the time structure in seconds
+ * @param[out] *t pointer to a time structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle or time is NULL
+ *             - 3 handle is not initialized
+ *             - 4 timestamp is out of the 2000 - 2199 range
+ * @note       the time structure is filled in 24H format, monday is week 1 and sunday is week 7
+ */
+uint8_t ds3231_unix_to_time(ds3231_handle_t *handle, int64_t timestamp, int32_t utc_offset, ds3231_time_t *t)
+{
+    int64_t local;
+    uint32_t days;
+    uint32_t secs;
+    uint32_t era;
+    uint32_t doe;
+    uint32_t yoe;
+    uint32_t doy;
+    uint32_t mp;
+    
+    if (handle == NULL)                                                                             /* check handle */
+    {
+        return 2;                                                                                   /* return error */
     }
-    if (times == 0)                                                                             /* if zero */
+    if (handle->inited != 1)                                                                        /* check handle initialization */
     {
-        handle->debug_print("ds3231: read timeout.\n");                                         /* read timeout */
-        
-        return 1;                                                                               /* return error */
+        return 3;                                                                                   /* return error */
     }
-    res = a_ds3231_iic_multiple_read(handle, DS3231_REG_TEMPERATUREH, (uint8_t *)buf, 2);       /* read temperature */
-    if (res != 0)                                                                               /* check result */
+    if (t == NULL)                                                                                  /* check time */
     {
-        handle->debug_print("ds3231: read temperature failed.\n");                              /* read temperature failed */
+        DS3231_DEBUG_PRINT(handle, "ds3231: time is null.\n");                                      /* time is null */
         
-        return 1;                                                                               /* return error */
+        return 2;                                                                                   /* return error */
     }
-    *raw = (int16_t)(((uint16_t)buf[0]) << 8) | buf[1];                                         /* set raw temperature */
-    *s = (float)((int8_t)(buf[0])) + (float)(buf[1] >> 6) * 0.25f;                              /* set converted temperature */
     
-    return 0;                                                                                   /* success return 0 */
+    local = timestamp + utc_offset;                                                                 /* get local time */
+    if ((local < 946684800LL) || (local >= 7258118400LL))                                           /* check 2000-01-01 - 2200-01-01 */
+    {
+        DS3231_DEBUG_PRINT(handle, "ds3231: timestamp is out of range.\n");                         /* timestamp is out of range */
+        
+        return 4;                                                                                   /* return error */
+    }
+    local -= 946684800LL;                                                                           /* seconds since 2000-01-01 */
+    days = (uint32_t)(local / 86400);                                                               /* get days */
+    secs = (uint32_t)(local - (int64_t)days * 86400);                                               /* get seconds of the day */
+    days += 146037;                                                                                 /* days since 1600-03-01 */
+    era = days / 146097;                                                                            /* 400 years era */
+    doe = days - era * 146097;                                                                      /* day of the era */
+    yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;                                    /* year of the era */
+    doy = doe - (365 * yoe + yoe / 4 - yoe / 100);                                                  /* day of the year from march */
+    mp = (5 * doy + 2) / 153;                                                                       /* month from march */
+    t->date = (uint8_t)(doy - (153 * mp + 2) / 5 + 1);                                              /* get date */
+    t->month = (uint8_t)((mp < 10) ? (mp + 3) : (mp - 9));                                          /* get month */
+    t->year = (uint16_t)(1600 + era * 400 + yoe + (t->month <= 2));                                 /* get year */
+    t->week = (uint8_t)((days + 2) % 7 + 1);                                                        /* 1600-03-01 is wednesday */
+    t->hour = (uint8_t)(secs / 3600);                                                               /* get hour */
+    t->minute = (uint8_t)((secs % 3600) / 60);                                                      /* get minute */
+    t->second = (uint8_t)(secs % 60);                                                               /* get second */
+    t->format = DS3231_FORMAT_24H;                                                                  /* set 24H */
+    t->am_pm = DS3231_AM;                                                                           /* set am */
+    
+    return 0;                                                                                       /* success return 0 */
 }
 
 /**
- * @brief      get the chip status
- * @param[in]  *handle pointer to a ds3231 handle structure
- * @param[out] *status pointer to a chip status buffer
- * @return     status code
- *             - 0 success
- *             - 1 get status failed
- *             - 2 handle is NULL
- *             - 3 handle is not initialized
- * @note       none
+ * @brief     irq handler
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      none
  */
-uint8_t ds3231_get_status(ds3231_handle_t *handle, uint8_t *status)
+uint8_t ds3231_irq_handler(ds3231_handle_t *handle)
 {
-    uint8_t res;
+    uint8_t res, prev;
     
     if (handle == NULL)                                                                      /* check handle */
     {
@@ -1277,187 +2614,296 @@ uint8_t ds3231_get_status(ds3231_handle_t *handle, uint8_t *status)
         return 3;                                                                            /* return error */
     }
     
-    res = a_ds3231_iic_multiple_read(handle, DS3231_REG_STATUS, (uint8_t *)status, 1);       /* multiple read */
+    a_ds3231_lock(handle, DS3231_LOCK_READ, DS3231_STATS_API_IRQ_HANDLER);                   /* lock */
+#if (DS3231_STATS_ENABLE != 0)
+    handle->stats.irq++;                                                                     /* count the irq */
+#endif
+    res = a_ds3231_iic_multiple_read(handle, DS3231_REG_STATUS, (uint8_t *)&prev, 1);        /* multiple read */
+    a_ds3231_unlock(handle, DS3231_LOCK_READ);                                               /* unlock before the callbacks */
     if (res != 0)                                                                            /* check result */
     {
-        handle->debug_print("ds3231: read status failed.\n");                                /* read status failed */
+        DS3231_DEBUG_PRINT(handle, "ds3231: read status failed.\n");                         /* read status failed */
         
         return 1;                                                                            /* return error */
+    }                                                                                        /* if oscillator stop */
+    if ((prev & DS3231_STATUS_ALARM_2) != 0)                                                 /* if alarm 2 */
+    {
+        a_ds3231_receive_callback(handle, DS3231_STATUS_ALARM_2);                            /* run callback */
     }
-
+    if ((prev & DS3231_STATUS_ALARM_1) != 0)                                                 /* if alarm 1 */
+    {
+        a_ds3231_receive_callback(handle, DS3231_STATUS_ALARM_1);                            /* run callback */
+    }
+    
     return 0;                                                                                /* success return 0 */
 }
 
 /**
- * @brief     set the chip aging offset
+ * @brief     irq handler that clears the alarm flags and queues the events
  * @param[in] *handle pointer to a ds3231 handle structure
- * @param[in] offset time aging offset
+ * @param[in] timestamp user timestamp stored in the events
  * @return    status code
  *            - 0 success
- *            - 1 set aging offset failed
+ *            - 1 run failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ * @note      only the observed flags are cleared in one write and no callback is run,
+ *            it is the single producer of the event queue
  */
-uint8_t ds3231_set_aging_offset(ds3231_handle_t *handle, int8_t offset)
+uint8_t ds3231_irq_event_handler(ds3231_handle_t *handle, uint64_t timestamp)
 {
     uint8_t res;
+    uint8_t prev;
+    uint8_t observed;
+    uint8_t i;
+    uint32_t head;
+    
+    if (handle == NULL)                                                                            /* check handle */
+    {
+        return 2;                                                                                  /* return error */
+    }
+    if (handle->inited != 1)                                                                       /* check handle initialization */
+    {
+        return 3;                                                                                  /* return error */
+    }
     
-    if (handle == NULL)                                               /* check handle */
+    a_ds3231_lock(handle, DS3231_LOCK_WRITE, DS3231_STATS_API_IRQ_EVENT_HANDLER);                  /* lock */
+#if (DS3231_STATS_ENABLE != 0)
+    handle->stats.irq++;                                                                           /* count the irq */
+#endif
+    res = a_ds3231_iic_multiple_read(handle, DS3231_REG_STATUS, (uint8_t *)&prev, 1);              /* read status */
+    if (res != 0)                                                                                  /* check result */
     {
-        return 2;                                                     /* return error */
+        DS3231_DEBUG_PRINT(handle, "ds3231: read status failed.\n");                               /* read status failed */
+        a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                                /* unlock */
+        
+        return 1;                                                                                  /* return error */
     }
-    if (handle->inited != 1)                                          /* check handle initialization */
+    observed = prev & (DS3231_STATUS_ALARM_1 | DS3231_STATUS_ALARM_2);                             /* get the alarm flags */
+    if (observed == 0)                                                                             /* check the flags */
     {
-        return 3;                                                     /* return error */
+        a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                                /* unlock */
+        
+        return 0;                                                                                  /* success return 0 */
     }
-
-    res = a_ds3231_iic_write(handle, DS3231_REG_XTAL, offset);        /* write offset */
-    if (res != 0)                                                     /* check result */
+    prev |= DS3231_STATUS_ALARM_1 | DS3231_STATUS_ALARM_2;                                         /* writing 1 keeps a flag that fired after the read */
+    prev &= (uint8_t)(~observed);                                                                  /* clear the observed flags */
+    res = a_ds3231_shadow_write(handle, DS3231_REG_STATUS, prev);                                  /* write status */
+    a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                                    /* unlock */
+    if (res != 0)                                                                                  /* check result */
     {
-        handle->debug_print("ds3231: write offset failed.\n");        /* write offset failed */
+        DS3231_DEBUG_PRINT(handle, "ds3231: write status failed.\n");                              /* write status failed */
         
-        return 1;                                                     /* return error */
+        return 1;                                                                                  /* return error */
     }
     
-    return 0;                                                         /* success return 0 */
+    head = handle->event_head;                                                                     /* get head */
+    for (i = 0; i < 2; i++)                                                                        /* alarm 1 and alarm 2 */
+    {
+        if ((observed & (1 << i)) == 0)                                                            /* check the flag */
+        {
+            continue;                                                                              /* skip */
+        }
+        if ((head - handle->event_tail) >= DS3231_EVENT_QUEUE_SIZE)                                /* check the queue */
+        {
+            handle->event_dropped++;                                                               /* drop the event */
+            
+            continue;                                                                              /* skip */
+        }
+        handle->event_queue[head & (DS3231_EVENT_QUEUE_SIZE - 1)].timestamp = timestamp;           /* set timestamp */
+        handle->event_queue[head & (DS3231_EVENT_QUEUE_SIZE - 1)].type = (uint8_t)(1 << i);        /* set type */
+        head++;                                                                                    /* next slot */
+        DS3231_MEMORY_BARRIER();                                                                   /* publish the slot before the head */
+        handle->event_head = head;                                                                 /* set head */
+    }
+    
+    return 0;                                                                                      /* success return 0 */
 }
 
 /**
- * @brief      get the chip aging offset
+ * @brief      get the queued alarm events
  * @param[in]  *handle pointer to a ds3231 handle structure
- * @param[out] *offset pointer to a time aging offset buffer
+ * @param[out] *events pointer to an event buffer
+ * @param[in]  len event buffer length
+ * @param[out] *count pointer to a read event count buffer
  * @return     status code
  *             - 0 success
- *             - 1 get aging offset failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- * @note       none
+ * @note       it is the single consumer of the event queue and takes no lock
  */
-uint8_t ds3231_get_aging_offset(ds3231_handle_t *handle, int8_t *offset)
+uint8_t ds3231_get_events(ds3231_handle_t *handle, ds3231_event_t *events, uint32_t len, uint32_t *count)
 {
-    uint8_t res;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t n;
     
-    if (handle == NULL)                                                                    /* check handle */
+    if (handle == NULL)                                                                      /* check handle */
     {
-        return 2;                                                                          /* return error */
+        return 2;                                                                            /* return error */
     }
-    if (handle->inited != 1)                                                               /* check handle initialization */
+    if (handle->inited != 1)                                                                 /* check handle initialization */
     {
-        return 3;                                                                          /* return error */
+        return 3;                                                                            /* return error */
     }
-
-    res = a_ds3231_iic_multiple_read(handle, DS3231_REG_XTAL, (uint8_t *)offset, 1);       /* read offset */
-    if (res != 0)                                                                          /* check result */
+    
+    head = handle->event_head;                                                               /* get head */
+    DS3231_MEMORY_BARRIER();                                                                 /* read the slots after the head */
+    tail = handle->event_tail;                                                               /* get tail */
+    n = 0;                                                                                   /* init 0 */
+    while ((tail != head) && (n < len))                                                      /* copy the events */
     {
-        handle->debug_print("ds3231: read offset failed.\n");                              /* read offset failed */
-        
-        return 1;                                                                          /* return error */
+        events[n] = handle->event_queue[tail & (DS3231_EVENT_QUEUE_SIZE - 1)];               /* copy event */
+        tail++;                                                                              /* next slot */
+        n++;                                                                                 /* count++ */
     }
+    DS3231_MEMORY_BARRIER();                                                                 /* finish reading before freeing the slots */
+    handle->event_tail = tail;                                                               /* set tail */
+    *count = n;                                                                              /* set count */
     
-    return 0;                                                                              /* success return 0 */
+    return 0;                                                                                /* success return 0 */
 }
 
 /**
- * @brief      convert a aging offset value to a register raw data
+ * @brief      get the number of dropped alarm events
  * @param[in]  *handle pointer to a ds3231 handle structure
- * @param[in]  offset converted aging offset value
- * @param[out] *reg pointer to a register raw buffer
+ * @param[out] *dropped pointer to a dropped event count buffer
  * @return     status code
  *             - 0 success
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- * @note       none
+ * @note       events are dropped when the queue is full
  */
-uint8_t ds3231_aging_offset_convert_to_register(ds3231_handle_t *handle, float offset, int8_t *reg)
+uint8_t ds3231_get_dropped_events(ds3231_handle_t *handle, uint32_t *dropped)
 {
-    if (handle == NULL)                     /* check handle */
+    if (handle == NULL)                                  /* check handle */
     {
-        return 2;                           /* return error */
+        return 2;                                        /* return error */
     }
-    if (handle->inited != 1)                /* check handle initialization */
+    if (handle->inited != 1)                             /* check handle initialization */
     {
-        return 3;                           /* return error */
+        return 3;                                        /* return error */
     }
     
-    *reg = (int8_t)(offset / 0.12f);        /* convert real data to register data */
+    *dropped = handle->event_dropped;                    /* get dropped events */
     
-    return 0;                               /* success return 0 */
+    return 0;                                            /* success return 0 */
 }
 
 /**
- * @brief      convert a register raw data to a converted aging offset data
+ * @brief      get the bus counters and latency histograms
  * @param[in]  *handle pointer to a ds3231 handle structure
- * @param[in]  reg register raw data
- * @param[out] *offset pointer to a converted aging offset buffer
+ * @param[out] *stats pointer to a stats structure
  * @return     status code
  *             - 0 success
- *             - 2 handle is NULL
+ *             - 2 handle or stats is NULL
  *             - 3 handle is not initialized
- * @note       none
+ *             - 4 stats are not compiled in
+ * @note       the counters are kept when DS3231_STATS_ENABLE is not 0,
+ *             every api takes the write lock in this build
  */
-uint8_t ds3231_aging_offset_convert_to_data(ds3231_handle_t *handle, int8_t reg, float *offset)
+uint8_t ds3231_get_stats(ds3231_handle_t *handle, ds3231_stats_t *stats)
 {
-    if (handle == NULL)                    /* check handle */
+    if (handle == NULL)                                                    /* check handle */
     {
-        return 2;                          /* return error */
+        return 2;                                                          /* return error */
     }
-    if (handle->inited != 1)               /* check handle initialization */
+    if (handle->inited != 1)                                               /* check handle initialization */
     {
-        return 3;                          /* return error */
+        return 3;                                                          /* return error */
+    }
+    if (stats == NULL)                                                     /* check stats */
+    {
+        return 2;                                                          /* return error */
     }
     
-    *offset = (float)(reg) * 0.12f;        /* convert raw data to real data */
+#if (DS3231_STATS_ENABLE != 0)
+    a_ds3231_lock(handle, DS3231_LOCK_WRITE, DS3231_STATS_API_NONE);       /* lock */
+    memcpy(stats, &handle->stats, sizeof(ds3231_stats_t));                 /* copy the stats */
+    a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                            /* unlock */
     
-    return 0;                              /* success return 0 */
+    return 0;                                                              /* success return 0 */
+#else
+    DS3231_DEBUG_PRINT(handle, "ds3231: stats are not compiled in.\n");    /* stats are not compiled in */
+    
+    return 4;                                                              /* return error */
+#endif
 }
 
 /**
- * @brief     irq handler
+ * @brief     clear the bus counters and latency histograms
  * @param[in] *handle pointer to a ds3231 handle structure
  * @return    status code
  *            - 0 success
- *            - 1 run failed
  *            - 2 handle is NULL
  *            - 3 handle is not initialized
- * @note      none
+ *            - 4 stats are not compiled in
+ * @note      ds3231_init clears them too
  */
-uint8_t ds3231_irq_handler(ds3231_handle_t *handle)
+uint8_t ds3231_reset_stats(ds3231_handle_t *handle)
 {
-    uint8_t res, prev;
-    
-    if (handle == NULL)                                                                      /* check handle */
+    if (handle == NULL)                                                    /* check handle */
     {
-        return 2;                                                                            /* return error */
+        return 2;                                                          /* return error */
     }
-    if (handle->inited != 1)                                                                 /* check handle initialization */
+    if (handle->inited != 1)                                               /* check handle initialization */
     {
-        return 3;                                                                            /* return error */
+        return 3;                                                          /* return error */
     }
     
-    res = a_ds3231_iic_multiple_read(handle, DS3231_REG_STATUS, (uint8_t *)&prev, 1);        /* multiple read */
-    if (res != 0)                                                                            /* check result */
-    {
-        handle->debug_print("ds3231: read status failed.\n");                                /* read status failed */
-        
-        return 1;                                                                            /* return error */
-    }                                                                                        /* if oscillator stop */
-    if ((prev & DS3231_STATUS_ALARM_2) != 0)                                                 /* if alarm 2 */
+#if (DS3231_STATS_ENABLE != 0)
+    a_ds3231_lock(handle, DS3231_LOCK_WRITE, DS3231_STATS_API_NONE);       /* lock */
+    memset(&handle->stats, 0, sizeof(ds3231_stats_t));                     /* clear the stats */
+    a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                            /* unlock */
+    
+    return 0;                                                              /* success return 0 */
+#else
+    DS3231_DEBUG_PRINT(handle, "ds3231: stats are not compiled in.\n");    /* stats are not compiled in */
+    
+    return 4;                                                              /* return error */
+#endif
+}
+
+/**
+ * @brief     set the iic address
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @param[in] addr iic write address
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      call it before ds3231_init, 0 means the default 0xD0 address
+ */
+uint8_t ds3231_set_addr(ds3231_handle_t *handle, uint8_t addr)
+{
+    if (handle == NULL)              /* check handle */
     {
-        if (handle->receive_callback != NULL)                                                /* if receive callback */
-        {
-            handle->receive_callback(DS3231_STATUS_ALARM_2);                                 /* run callback */
-        }
+        return 2;                    /* return error */
     }
-    if ((prev & DS3231_STATUS_ALARM_1) != 0)                                                 /* if alarm 1 */
+    
+    handle->iic_addr = addr;         /* set address */
+    
+    return 0;                        /* success return 0 */
+}
+
+/**
+ * @brief      get the iic address
+ * @param[in]  *handle pointer to a ds3231 handle structure
+ * @param[out] *addr pointer to an iic write address buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t ds3231_get_addr(ds3231_handle_t *handle, uint8_t *addr)
+{
+    if (handle == NULL)                                                         /* check handle */
     {
-        if (handle->receive_callback != NULL)                                                /* if receive callback */
-        {
-            handle->receive_callback(DS3231_STATUS_ALARM_1);                                 /* run callback */
-        }
+        return 2;                                                               /* return error */
     }
     
-    return 0;                                                                                /* success return 0 */
+    *addr = (handle->iic_addr != 0) ? handle->iic_addr : DS3231_ADDRESS;        /* get address */
+    
+    return 0;                                                                   /* success return 0 */
 }
 
 /**
@@ -1474,76 +2920,98 @@ uint8_t ds3231_init(ds3231_handle_t *handle)
 {
     uint8_t res;
     uint8_t prev;
+    uint8_t buf[2];
     
     if (handle == NULL)                                                                      /* check handle */
     {
         return 2;                                                                            /* return error */
     }
+#if (DS3231_DEBUG_PRINT_ENABLE != 0)
     if (handle->debug_print == NULL)                                                         /* check debug_print */
     {
         return 3;                                                                            /* return error */
     }
-    if (handle->iic_init == NULL)                                                            /* check iic_init */
+#endif
+    if ((handle->iic_init == NULL) && (handle->iic_init_ctx == NULL))                        /* check iic_init */
     {
-        handle->debug_print("ds3231: iic_init is null.\n");                                  /* iic_init is null */
+        DS3231_DEBUG_PRINT(handle, "ds3231: iic_init is null.\n");                           /* iic_init is null */
        
         return 3;                                                                            /* return error */
     }
-    if (handle->iic_deinit == NULL)                                                          /* check iic_deinit */
+    if ((handle->iic_deinit == NULL) && (handle->iic_deinit_ctx == NULL))                    /* check iic_deinit */
     {
-        handle->debug_print("ds3231: iic_deinit is null.\n");                                /* iic_deinit is null */
+        DS3231_DEBUG_PRINT(handle, "ds3231: iic_deinit is null.\n");                         /* iic_deinit is null */
        
         return 3;                                                                            /* return error */
     }
-    if (handle->iic_write == NULL)                                                           /* check iic_write */
+    if ((handle->iic_write == NULL) && (handle->iic_write_ctx == NULL))                      /* check iic_write */
     {
-        handle->debug_print("ds3231: iic_write is null.\n");                                 /* iic_write is null */
+        DS3231_DEBUG_PRINT(handle, "ds3231: iic_write is null.\n");                          /* iic_write is null */
        
         return 3;                                                                            /* return error */
     }
-    if (handle->iic_read == NULL)                                                            /* check iic_read */
+    if ((handle->iic_read == NULL) && (handle->iic_read_ctx == NULL))                        /* check iic_read */
     {
-        handle->debug_print("ds3231: iic_read is null.\n");                                  /* iic_read is null */
+        DS3231_DEBUG_PRINT(handle, "ds3231: iic_read is null.\n");                           /* iic_read is null */
        
         return 3;                                                                            /* return error */
     }
     if (handle->delay_ms == NULL)                                                            /* check delay_ms */
     {
-        handle->debug_print("ds3231: delay_ms is null.\n");                                  /* delay_ms is null */
+        DS3231_DEBUG_PRINT(handle, "ds3231: delay_ms is null.\n");                           /* delay_ms is null */
        
         return 3;                                                                            /* return error */
     }
-    if (handle->receive_callback == NULL)                                                    /* check receive_callback */
+    if ((handle->receive_callback == NULL) && (handle->receive_callback_ctx == NULL))        /* check receive_callback */
     {
-        handle->debug_print("ds3231: receive_callback is null.\n");                          /* receive_callback is null */
+        DS3231_DEBUG_PRINT(handle, "ds3231: receive_callback is null.\n");                   /* receive_callback is null */
        
         return 3;                                                                            /* return error */
     }
     
-    if (handle->iic_init() != 0)                                                             /* iic init */
+    if (handle->iic_addr == 0)                                                               /* check the address */
+    {
+        handle->iic_addr = DS3231_ADDRESS;                                                   /* set the default address */
+    }
+    a_ds3231_lock(handle, DS3231_LOCK_WRITE, DS3231_STATS_API_INIT);                         /* lock */
+#if (DS3231_STATS_ENABLE != 0)
+    memset(&handle->stats, 0, sizeof(ds3231_stats_t));                                       /* clear the stats */
+#endif
+    if (a_ds3231_iic_init(handle) != 0)                                                      /* iic init */
     {
-        handle->debug_print("ds3231: iic init failed.\n");                                   /* iic init failed */
+        DS3231_DEBUG_PRINT(handle, "ds3231: iic init failed.\n");                            /* iic init failed */
+        a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                          /* unlock */
        
         return 1;                                                                            /* return error */
     }
-    res = a_ds3231_iic_multiple_read(handle, DS3231_REG_STATUS, (uint8_t *)&prev, 1);        /* multiple_read */
+    res = a_ds3231_iic_multiple_read(handle, DS3231_REG_CONTROL, (uint8_t *)buf, 2);         /* read control and status */
     if (res != 0)                                                                            /* check result */
     {
-        handle->debug_print("ds3231: read status failed.\n");                                /* read status failed */
-        (void)handle->iic_deinit();                                                          /* iic deinit */
+        DS3231_DEBUG_PRINT(handle, "ds3231: read status failed.\n");                         /* read status failed */
+        (void)a_ds3231_iic_deinit(handle);                                                   /* iic deinit */
+        a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                          /* unlock */
         
         return 1;                                                                            /* return error */
     }
+    handle->control_shadow = buf[0];                                                         /* set control shadow */
+    handle->status_shadow = buf[1];                                                          /* set status shadow */
+    handle->cache_valid = 1;                                                                 /* set cache valid */
+    prev = buf[1];                                                                           /* get status */
     prev &= ~(1 << 7);                                                                       /* clear config */
-    res = a_ds3231_iic_write(handle, DS3231_REG_STATUS, prev);                               /* write status */
+    res = a_ds3231_shadow_write(handle, DS3231_REG_STATUS, prev);                            /* write status */
     if (res != 0)                                                                            /* check result */
     {
-        handle->debug_print("ds3231: write status failed.\n");                               /* write status failed */
-        (void)handle->iic_deinit();                                                          /* iic deinit */
+        DS3231_DEBUG_PRINT(handle, "ds3231: write status failed.\n");                        /* write status failed */
+        (void)a_ds3231_iic_deinit(handle);                                                   /* iic deinit */
+        a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                          /* unlock */
         
         return 1;                                                                            /* return error */
     }
+    handle->event_head = 0;                                                                  /* clear event head */
+    handle->event_tail = 0;                                                                  /* clear event tail */
+    handle->event_dropped = 0;                                                               /* clear dropped events */
     handle->inited = 1;                                                                      /* flag finish initialization */
+    a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                              /* unlock */
     
     return 0;                                                                                /* success return 0 */
 }
@@ -1560,24 +3028,28 @@ uint8_t ds3231_init(ds3231_handle_t *handle)
  */
 uint8_t ds3231_deinit(ds3231_handle_t *handle)
 {
-    if (handle == NULL)                                             /* check handle */
+    if (handle == NULL)                                                       /* check handle */
     {
-        return 2;                                                   /* return error */
+        return 2;                                                             /* return error */
     }
-    if (handle->inited != 1)                                        /* check handle initialization */
+    if (handle->inited != 1)                                                  /* check handle initialization */
     {
-        return 3;                                                   /* return error */
+        return 3;                                                             /* return error */
     }
     
-    if (handle->iic_deinit() != 0)                                  /* iic deinit */
+    a_ds3231_lock(handle, DS3231_LOCK_WRITE, DS3231_STATS_API_DEINIT);        /* lock */
+    if (a_ds3231_iic_deinit(handle) != 0)                                     /* iic deinit */
     {
-        handle->debug_print("ds3231: iic deinit failed.\n");        /* iic deinit failed */
+        DS3231_DEBUG_PRINT(handle, "ds3231: iic deinit failed.\n");           /* iic deinit failed */
+        a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                           /* unlock */
        
-        return 1;                                                   /* return error */
+        return 1;                                                             /* return error */
     }
-    handle->inited = 0;                                             /* flag close */
+    handle->cache_valid = 0;                                                  /* invalidate the cache */
+    handle->inited = 0;                                                       /* flag close */
+    a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                               /* unlock */
     
-    return 0;                                                       /* success return 0 */
+    return 0;                                                                 /* success return 0 */
 }
 
 /**
@@ -1605,21 +3077,25 @@ uint8_t ds3231_alarm_clear(ds3231_handle_t *handle, ds3231_alarm_t alarm)
         return 3;                                                                            /* return error */
     }
     
+    a_ds3231_lock(handle, DS3231_LOCK_WRITE, DS3231_STATS_API_ALARM_CLEAR);                  /* lock */
     res = a_ds3231_iic_multiple_read(handle, DS3231_REG_STATUS, (uint8_t *)&prev, 1);        /* multiple_read  */
     if (res != 0)                                                                            /* check result */
     {
-        handle->debug_print("ds3231: read status failed.\n");                                /* read status failed */
+        DS3231_DEBUG_PRINT(handle, "ds3231: read status failed.\n");                         /* read status failed */
+        a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                          /* unlock */
         
         return 1;                                                                            /* return error */
     }
     prev &= ~(1 << alarm);                                                                   /* clear config */
-    res = a_ds3231_iic_write(handle, DS3231_REG_STATUS, prev);                               /* write status */
+    res = a_ds3231_shadow_write(handle, DS3231_REG_STATUS, prev);                            /* write status */
     if (res != 0)                                                                            /* check result */
     {
-        handle->debug_print("ds3231: write status failed.\n");                               /* write status failed */
+        DS3231_DEBUG_PRINT(handle, "ds3231: write status failed.\n");                        /* write status failed */
+        a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                          /* unlock */
         
         return 1;                                                                            /* return error */
     }
+    a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                              /* unlock */
     
     return 0;                                                                                /* success return 0 */
 }
@@ -1649,22 +3125,26 @@ uint8_t ds3231_set_32khz_output(ds3231_handle_t *handle, ds3231_bool_t enable)
         return 3;                                                                            /* return error */
     }
     
+    a_ds3231_lock(handle, DS3231_LOCK_WRITE, DS3231_STATS_API_SET_32KHZ_OUTPUT);             /* lock */
     res = a_ds3231_iic_multiple_read(handle, DS3231_REG_STATUS, (uint8_t *)&prev, 1);        /* multiple read */
     if (res != 0)                                                                            /* check result */
     {
-        handle->debug_print("ds3231: read status failed.\n");                                /* read status failed */
+        DS3231_DEBUG_PRINT(handle, "ds3231: read status failed.\n");                         /* read status failed */
+        a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                          /* unlock */
         
         return 1;                                                                            /* return error */
     }
     prev &= ~(1 << 3);                                                                       /* clear config */
     prev |= enable << 3;                                                                     /* set enable */
-    res = a_ds3231_iic_write(handle, DS3231_REG_STATUS, prev);                               /* write status */
+    res = a_ds3231_shadow_write(handle, DS3231_REG_STATUS, prev);                            /* write status */
     if (res != 0)                                                                            /* check result */
     {
-        handle->debug_print("ds3231: write status failed.\n");                               /* write status failed */
+        DS3231_DEBUG_PRINT(handle, "ds3231: write status failed.\n");                        /* write status failed */
+        a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                          /* unlock */
         
         return 1;                                                                            /* return error */
     }
+    a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                              /* unlock */
     
     return 0;                                                                                /* success return 0 */
 }
@@ -1684,6 +3164,7 @@ uint8_t ds3231_get_32khz_output(ds3231_handle_t *handle, ds3231_bool_t *enable)
 {
     uint8_t res;
     uint8_t prev;
+    ds3231_lock_t lock;
     
     if (handle == NULL)                                                                      /* check handle */
     {
@@ -1694,18 +3175,106 @@ uint8_t ds3231_get_32khz_output(ds3231_handle_t *handle, ds3231_bool_t *enable)
         return 3;                                                                            /* return error */
     }
     
-    res = a_ds3231_iic_multiple_read(handle, DS3231_REG_STATUS, (uint8_t *)&prev, 1);        /* multiple read */
+    lock = a_ds3231_shadow_lock(handle, DS3231_STATS_API_GET_32KHZ_OUTPUT);                  /* lock */
+    res = a_ds3231_shadow_read(handle, DS3231_REG_STATUS, (uint8_t *)&prev);                 /* read status */
     if (res != 0)                                                                            /* check result */
     {
-        handle->debug_print("ds3231: read status failed.\n");                                /* read status failed */
+        DS3231_DEBUG_PRINT(handle, "ds3231: read status failed.\n");                         /* read status failed */
+        a_ds3231_unlock(handle, lock);                                                       /* unlock */
         
         return 1;                                                                            /* return error */
     }
     *enable = (ds3231_bool_t)((prev >> 3) & 0x01);                                           /* get enable */
+    a_ds3231_unlock(handle, lock);                                                           /* unlock */
     
     return 0;                                                                                /* success return 0 */
 }
 
+/**
+ * @brief     enable or disable the register shadow cache
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      when enabled, control getters and the 32khz output getter are served from ram and
+ *            control setters become a single write, volatile status flags are always read from the chip
+ */
+uint8_t ds3231_set_register_cache(ds3231_handle_t *handle, ds3231_bool_t enable)
+{
+    if (handle == NULL)                                                                  /* check handle */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if (handle->inited != 1)                                                             /* check handle initialization */
+    {
+        return 3;                                                                        /* return error */
+    }
+    
+    a_ds3231_lock(handle, DS3231_LOCK_WRITE, DS3231_STATS_API_SET_REGISTER_CACHE);       /* lock */
+    handle->cache_enable = (uint8_t)enable;                                              /* set cache enable */
+    a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                          /* unlock */
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief      get the register shadow cache status
+ * @param[in]  *handle pointer to a ds3231 handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds3231_get_register_cache(ds3231_handle_t *handle, ds3231_bool_t *enable)
+{
+    if (handle == NULL)                                                                  /* check handle */
+    {
+        return 2;                                                                        /* return error */
+    }
+    if (handle->inited != 1)                                                             /* check handle initialization */
+    {
+        return 3;                                                                        /* return error */
+    }
+    
+    a_ds3231_lock(handle, DS3231_LOCK_READ, DS3231_STATS_API_GET_REGISTER_CACHE);        /* lock */
+    *enable = (ds3231_bool_t)(handle->cache_enable);                                     /* get cache enable */
+    a_ds3231_unlock(handle, DS3231_LOCK_READ);                                           /* unlock */
+    
+    return 0;                                                                            /* success return 0 */
+}
+
+/**
+ * @brief     invalidate the register shadow cache
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the next cached access reloads the control and status registers from the chip,
+ *            call it after anything else on the bus may have changed them
+ */
+uint8_t ds3231_invalidate_register_cache(ds3231_handle_t *handle)
+{
+    if (handle == NULL)                                                                          /* check handle */
+    {
+        return 2;                                                                                /* return error */
+    }
+    if (handle->inited != 1)                                                                     /* check handle initialization */
+    {
+        return 3;                                                                                /* return error */
+    }
+    
+    a_ds3231_lock(handle, DS3231_LOCK_WRITE, DS3231_STATS_API_INVALIDATE_REGISTER_CACHE);        /* lock */
+    handle->cache_valid = 0;                                                                     /* invalidate the cache */
+    a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                                  /* unlock */
+    
+    return 0;                                                                                    /* success return 0 */
+}
+
 /**
  * @brief     set the chip register
  * @param[in] *handle pointer to a ds3231 handle structure
@@ -1721,22 +3290,26 @@ uint8_t ds3231_get_32khz_output(ds3231_handle_t *handle, ds3231_bool_t *enable)
  */
 uint8_t ds3231_set_reg(ds3231_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
 {
-    if (handle == NULL)                                               /* check handle */
+    if (handle == NULL)                                                        /* check handle */
     {
-        return 2;                                                     /* return error */
+        return 2;                                                              /* return error */
     }
-    if (handle->inited != 1)                                          /* check handle initialization */
+    if (handle->inited != 1)                                                   /* check handle initialization */
     {
-        return 3;                                                     /* return error */
+        return 3;                                                              /* return error */
     }
     
-    if (handle->iic_write(DS3231_ADDRESS, reg, buf, len) != 0)        /* write data */
+    a_ds3231_lock(handle, DS3231_LOCK_WRITE, DS3231_STATS_API_SET_REG);        /* lock */
+    handle->cache_valid = 0;                                                   /* invalidate the cache */
+    if (a_ds3231_iic_multiple_write(handle, reg, buf, len) != 0)               /* write data */
     {
-        return 1;                                                     /* return error */
+        a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                            /* unlock */
+        return 1;                                                              /* return error */
     }
     else
     {
-        return 0;                                                     /* success return 0 */
+        a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                            /* unlock */
+        return 0;                                                              /* success return 0 */
     }
 }
 
@@ -1755,23 +3328,154 @@ uint8_t ds3231_set_reg(ds3231_handle_t *handle, uint8_t reg, uint8_t *buf, uint1
  */
 uint8_t ds3231_get_reg(ds3231_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len)
 {
-    if (handle == NULL)                                              /* check handle */
+    if (handle == NULL)                                                       /* check handle */
     {
-        return 2;                                                    /* return error */
+        return 2;                                                             /* return error */
     }
-    if (handle->inited != 1)                                         /* check handle initialization */
+    if (handle->inited != 1)                                                  /* check handle initialization */
     {
-        return 3;                                                    /* return error */
+        return 3;                                                             /* return error */
     }
     
-    if (handle->iic_read(DS3231_ADDRESS, reg, buf, len) != 0)        /* read data */
+    a_ds3231_lock(handle, DS3231_LOCK_READ, DS3231_STATS_API_GET_REG);        /* lock */
+    if (a_ds3231_iic_multiple_read(handle, reg, buf, len) != 0)               /* read data */
     {
-        return 1;                                                    /* return error */
+        a_ds3231_unlock(handle, DS3231_LOCK_READ);                            /* unlock */
+        return 1;                                                             /* return error */
     }
     else
     {
-        return 0;                                                    /* success return 0 */
+        a_ds3231_unlock(handle, DS3231_LOCK_READ);                            /* unlock */
+        return 0;                                                             /* success return 0 */
+    }
+}
+
+/**
+ * @brief     initialize a transaction
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @param[in] *transaction pointer to a transaction structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle or transaction is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ds3231_transaction_init(ds3231_handle_t *handle, ds3231_transaction_t *transaction)
+{
+    if (handle == NULL)                                                      /* check handle */
+    {
+        return 2;                                                            /* return error */
+    }
+    if (handle->inited != 1)                                                 /* check handle initialization */
+    {
+        return 3;                                                            /* return error */
+    }
+    if (transaction == NULL)                                                 /* check transaction */
+    {
+        DS3231_DEBUG_PRINT(handle, "ds3231: transaction is null.\n");        /* transaction is null */
+        
+        return 2;                                                            /* return error */
+    }
+    
+    transaction->num = 0;                                                    /* clear number */
+    transaction->cost = 0;                                                   /* clear cost */
+    
+    return 0;                                                                /* success return 0 */
+}
+
+/**
+ * @brief      queue a register read in a transaction
+ * @param[in]  *handle pointer to a ds3231 handle structure
+ * @param[in]  *transaction pointer to a transaction structure
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data buffer length
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle, transaction or buf is NULL
+ *             - 3 handle is not initialized
+ *             - 4 transaction is full
+ * @note       a read takes two i2c messages, buf is filled by ds3231_transaction_submit
+ */
+uint8_t ds3231_transaction_add_read(ds3231_handle_t *handle, ds3231_transaction_t *transaction, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return a_ds3231_transaction_add(handle, transaction, reg, 1, buf, len);        /* add a read */
+}
+
+/**
+ * @brief     queue a register write in a transaction
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @param[in] *transaction pointer to a transaction structure
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle, transaction or buf is NULL
+ *            - 3 handle is not initialized
+ *            - 4 transaction is full
+ * @note      buf must stay valid until ds3231_transaction_submit returns
+ */
+uint8_t ds3231_transaction_add_write(ds3231_handle_t *handle, ds3231_transaction_t *transaction, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    return a_ds3231_transaction_add(handle, transaction, reg, 0, buf, len);        /* add a write */
+}
+
+/**
+ * @brief     submit a transaction
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @param[in] *transaction pointer to a transaction structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ *            - 2 handle or transaction is NULL
+ *            - 3 handle is not initialized
+ * @note      all accesses are run in order as one iic_transfer call when it is linked,
+ *            otherwise one by one, the transaction is kept and can be submitted again
+ */
+uint8_t ds3231_transaction_submit(ds3231_handle_t *handle, ds3231_transaction_t *transaction)
+{
+    uint8_t i;
+    
+    if (handle == NULL)                                                                   /* check handle */
+    {
+        return 2;                                                                         /* return error */
+    }
+    if (handle->inited != 1)                                                              /* check handle initialization */
+    {
+        return 3;                                                                         /* return error */
+    }
+    if (transaction == NULL)                                                              /* check transaction */
+    {
+        DS3231_DEBUG_PRINT(handle, "ds3231: transaction is null.\n");                     /* transaction is null */
+        
+        return 2;                                                                         /* return error */
+    }
+    if (transaction->num == 0)                                                            /* check number */
+    {
+        return 0;                                                                         /* nothing to do */
+    }
+    
+    a_ds3231_lock(handle, DS3231_LOCK_WRITE, DS3231_STATS_API_TRANSACTION_SUBMIT);        /* lock */
+    for (i = 0; i < transaction->num; i++)                                                /* check all accesses */
+    {
+        if (transaction->msg[i].read == 0)                                                /* check the direction */
+        {
+            handle->cache_valid = 0;                                                      /* invalidate the cache */
+            
+            break;                                                                        /* break */
+        }
+    }
+    if (a_ds3231_iic_transfer(handle, transaction->msg, transaction->num) != 0)           /* transfer */
+    {
+        a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                       /* unlock */
+        DS3231_DEBUG_PRINT(handle, "ds3231: transfer failed.\n");                         /* transfer failed */
+        
+        return 1;                                                                         /* return error */
     }
+    a_ds3231_unlock(handle, DS3231_LOCK_WRITE);                                           /* unlock */
+    
+    return 0;                                                                             /* success return 0 */
 }
 
 /**
@@ -93,6 +93,72 @@ typedef enum
     DS3231_PIN_INTERRUPT   = 0x01,        /**< interrupt pin */
 } ds3231_pin_t;
 
+/**
+ * @brief ds3231 square wave frequency enumeration definition
+ */
+typedef enum
+{
+    DS3231_SQUARE_WAVE_FREQUENCY_1HZ    = 0x00,        /**< 1Hz */
+    DS3231_SQUARE_WAVE_FREQUENCY_1024HZ = 0x01,        /**< 1.024kHz */
+    DS3231_SQUARE_WAVE_FREQUENCY_4096HZ = 0x02,        /**< 4.096kHz */
+    DS3231_SQUARE_WAVE_FREQUENCY_8192HZ = 0x03,        /**< 8.192kHz */
+} ds3231_square_wave_frequency_t;
+
+/**
+ * @brief ds3231 lock type enumeration definition
+ */
+typedef enum
+{
+    DS3231_LOCK_READ  = 0x00,        /**< shared lock, only reads the chip */
+    DS3231_LOCK_WRITE = 0x01,        /**< exclusive lock, writes the chip or the handle */
+} ds3231_lock_t;
+
+/**
+ * @brief ds3231 stats api enumeration definition
+ */
+typedef enum
+{
+    DS3231_STATS_API_NONE                          = 0x00,        /**< not sampled, bus access outside a listed api */
+    DS3231_STATS_API_SET_TIME                      = 0x01,        /**< ds3231_set_time */
+    DS3231_STATS_API_GET_TIME                      = 0x02,        /**< ds3231_get_time */
+    DS3231_STATS_API_SET_ALARM1                    = 0x03,        /**< ds3231_set_alarm1 */
+    DS3231_STATS_API_GET_ALARM1                    = 0x04,        /**< ds3231_get_alarm1 */
+    DS3231_STATS_API_SET_ALARM2                    = 0x05,        /**< ds3231_set_alarm2 */
+    DS3231_STATS_API_GET_ALARM2                    = 0x06,        /**< ds3231_get_alarm2 */
+    DS3231_STATS_API_SET_OSCILLATOR                = 0x07,        /**< ds3231_set_oscillator */
+    DS3231_STATS_API_GET_OSCILLATOR                = 0x08,        /**< ds3231_get_oscillator */
+    DS3231_STATS_API_SET_ALARMS                    = 0x09,        /**< ds3231_set_alarms */
+    DS3231_STATS_API_SET_ALARM_INTERRUPT           = 0x0A,        /**< ds3231_set_alarm_interrupt */
+    DS3231_STATS_API_GET_ALARM_INTERRUPT           = 0x0B,        /**< ds3231_get_alarm_interrupt */
+    DS3231_STATS_API_SET_PIN                       = 0x0C,        /**< ds3231_set_pin */
+    DS3231_STATS_API_GET_PIN                       = 0x0D,        /**< ds3231_get_pin */
+    DS3231_STATS_API_SET_SQUARE_WAVE               = 0x0E,        /**< ds3231_set_square_wave */
+    DS3231_STATS_API_GET_SQUARE_WAVE               = 0x0F,        /**< ds3231_get_square_wave */
+    DS3231_STATS_API_SET_SQUARE_WAVE_FREQUENCY     = 0x10,        /**< ds3231_set_square_wave_frequency */
+    DS3231_STATS_API_GET_SQUARE_WAVE_FREQUENCY     = 0x11,        /**< ds3231_get_square_wave_frequency */
+    DS3231_STATS_API_START_TEMPERATURE_CONVERSION  = 0x12,        /**< ds3231_start_temperature_conversion */
+    DS3231_STATS_API_POLL_TEMPERATURE              = 0x13,        /**< ds3231_poll_temperature */
+    DS3231_STATS_API_GET_TEMPERATURE_NO_CONVERSION = 0x14,        /**< ds3231_get_temperature_no_conversion */
+    DS3231_STATS_API_GET_STATUS                    = 0x15,        /**< ds3231_get_status */
+    DS3231_STATS_API_READ_SNAPSHOT                 = 0x16,        /**< ds3231_read_snapshot */
+    DS3231_STATS_API_SET_AGING_OFFSET              = 0x17,        /**< ds3231_set_aging_offset */
+    DS3231_STATS_API_GET_AGING_OFFSET              = 0x18,        /**< ds3231_get_aging_offset */
+    DS3231_STATS_API_IRQ_HANDLER                   = 0x19,        /**< ds3231_irq_handler */
+    DS3231_STATS_API_IRQ_EVENT_HANDLER             = 0x1A,        /**< ds3231_irq_event_handler */
+    DS3231_STATS_API_INIT                          = 0x1B,        /**< ds3231_init */
+    DS3231_STATS_API_DEINIT                        = 0x1C,        /**< ds3231_deinit */
+    DS3231_STATS_API_ALARM_CLEAR                   = 0x1D,        /**< ds3231_alarm_clear */
+    DS3231_STATS_API_SET_32KHZ_OUTPUT              = 0x1E,        /**< ds3231_set_32khz_output */
+    DS3231_STATS_API_GET_32KHZ_OUTPUT              = 0x1F,        /**< ds3231_get_32khz_output */
+    DS3231_STATS_API_SET_REGISTER_CACHE            = 0x20,        /**< ds3231_set_register_cache */
+    DS3231_STATS_API_GET_REGISTER_CACHE            = 0x21,        /**< ds3231_get_register_cache */
+    DS3231_STATS_API_INVALIDATE_REGISTER_CACHE     = 0x22,        /**< ds3231_invalidate_register_cache */
+    DS3231_STATS_API_SET_REG                       = 0x23,        /**< ds3231_set_reg */
+    DS3231_STATS_API_GET_REG                       = 0x24,        /**< ds3231_get_reg */
+    DS3231_STATS_API_TRANSACTION_SUBMIT            = 0x25,        /**< ds3231_transaction_submit */
+    DS3231_STATS_API_NUM                           = 0x26,        /**< api number */
+} ds3231_stats_api_t;
+
 /**
  * @brief ds3231 format enumeration definition
  */
@@ -170,6 +236,102 @@ typedef struct ds3231_time_s
     ds3231_am_pm_t am_pm;          /**< am pm */
 } ds3231_time_t;
 
+/**
+ * @brief ds3231 register snapshot structure definition
+ */
+typedef struct ds3231_snapshot_s
+{
+    ds3231_time_t time;                          /**< current time */
+    ds3231_time_t alarm1;                        /**< alarm1 time */
+    ds3231_alarm1_mode_t alarm1_mode;            /**< alarm1 interrupt mode */
+    ds3231_time_t alarm2;                        /**< alarm2 time */
+    ds3231_alarm2_mode_t alarm2_mode;            /**< alarm2 interrupt mode */
+    uint8_t control;                             /**< control register */
+    uint8_t status;                              /**< status register */
+    int8_t aging_offset;                         /**< aging offset register */
+    int16_t raw_temperature;                     /**< raw temperature */
+    float temperature;                           /**< converted temperature */
+} ds3231_snapshot_t;
+
+/**
+ * @brief ds3231 event queue size definition
+ */
+#ifndef DS3231_EVENT_QUEUE_SIZE
+    #define DS3231_EVENT_QUEUE_SIZE        16        /**< queued events, must be a power of two */
+#endif
+
+/**
+ * @brief ds3231 debug print definition
+ */
+#ifndef DS3231_DEBUG_PRINT_ENABLE
+    #define DS3231_DEBUG_PRINT_ENABLE        1        /**< 0 compiles the driver messages and their strings out */
+#endif
+
+/**
+ * @brief ds3231 stats definition
+ */
+#ifndef DS3231_STATS_ENABLE
+    #define DS3231_STATS_ENABLE        0        /**< 1 compiles the bus counters and latency histograms in */
+#endif
+
+/**
+ * @brief ds3231 stats histogram size definition
+ */
+#define DS3231_STATS_HISTOGRAM_SIZE        16        /**< log2 latency buckets */
+
+/**
+ * @brief ds3231 stats structure definition
+ */
+typedef struct ds3231_stats_s
+{
+    uint32_t iic_read;                                                              /**< iic read calls */
+    uint32_t iic_write;                                                             /**< iic write calls */
+    uint32_t iic_transfer;                                                          /**< iic transfer calls */
+    uint32_t read_bytes;                                                            /**< read data bytes */
+    uint32_t write_bytes;                                                           /**< written data bytes */
+    uint32_t irq;                                                                   /**< irq handler calls */
+    uint32_t conversion;                                                            /**< blocking temperature conversions */
+    uint32_t conversion_wait_ms;                                                    /**< time waited for the conversions in ms */
+    uint32_t call[DS3231_STATS_API_NUM];                                            /**< calls of each api */
+    uint32_t failed[DS3231_STATS_API_NUM];                                          /**< failed iic calls of each api */
+    uint32_t latency[DS3231_STATS_API_NUM][DS3231_STATS_HISTOGRAM_SIZE];            /**< latency histogram of each api, bucket n counts 2^n to 2^(n+1) - 1 us */
+} ds3231_stats_t;
+
+/**
+ * @brief ds3231 event structure definition
+ */
+typedef struct ds3231_event_s
+{
+    uint64_t timestamp;        /**< timestamp passed to the irq event handler */
+    uint8_t type;              /**< DS3231_STATUS_ALARM_1 or DS3231_STATUS_ALARM_2 */
+} ds3231_event_t;
+
+/**
+ * @brief ds3231 transaction max messages definition
+ */
+#define DS3231_TRANSACTION_MAX_MSG        42        /**< i2c messages in one transaction */
+
+/**
+ * @brief ds3231 iic message structure definition
+ */
+typedef struct ds3231_iic_msg_s
+{
+    uint8_t reg;         /**< register address */
+    uint8_t read;        /**< 1 for a read and 0 for a write */
+    uint8_t *buf;        /**< data buffer */
+    uint16_t len;        /**< data buffer length */
+} ds3231_iic_msg_t;
+
+/**
+ * @brief ds3231 transaction structure definition
+ */
+typedef struct ds3231_transaction_s
+{
+    ds3231_iic_msg_t msg[DS3231_TRANSACTION_MAX_MSG];        /**< queued register accesses */
+    uint8_t num;                                             /**< queued register accesses number */
+    uint8_t cost;                                            /**< i2c messages on the bus, a read takes two */
+} ds3231_transaction_t;
+
 /**
  * @brief ds3231 handle structure definition
  */
@@ -182,7 +344,36 @@ typedef struct ds3231_handle_s
     void (*debug_print)(const char *const fmt, ...);                                    /**< point to a debug_print function address */
     void (*receive_callback)(uint8_t type);                                             /**< point to a receive_callback function address */
     void (*delay_ms)(uint32_t ms);                                                      /**< point to a delay_ms function address */
+    uint8_t (*iic_init_ctx)(void *ctx);                                                 /**< point to an iic_init_ctx function address */
+    uint8_t (*iic_deinit_ctx)(void *ctx);                                               /**< point to an iic_deinit_ctx function address */
+    uint8_t (*iic_write_ctx)(void *ctx, uint8_t addr, uint8_t reg,
+                             uint8_t *buf, uint16_t len);                               /**< point to an iic_write_ctx function address */
+    uint8_t (*iic_read_ctx)(void *ctx, uint8_t addr, uint8_t reg,
+                            uint8_t *buf, uint16_t len);                                /**< point to an iic_read_ctx function address */
+    void (*receive_callback_ctx)(void *ctx, uint8_t type);                              /**< point to a receive_callback_ctx function address */
+    uint8_t (*iic_transfer)(uint8_t addr, ds3231_iic_msg_t *msg, uint8_t num);          /**< point to an iic_transfer function address */
+    uint8_t (*iic_transfer_ctx)(void *ctx, uint8_t addr,
+                                ds3231_iic_msg_t *msg, uint8_t num);                    /**< point to an iic_transfer_ctx function address */
+    void *user_ctx;                                                                     /**< user context passed to the ctx functions */
+    void (*lock)(void *ctx, ds3231_lock_t type);                                        /**< point to a lock function address */
+    void (*unlock)(void *ctx, ds3231_lock_t type);                                      /**< point to an unlock function address */
+    void *lock_ctx;                                                                     /**< lock context passed to the lock functions */
+    uint64_t (*timestamp_us)(void);                                                     /**< point to a timestamp_us function address */
+    ds3231_event_t event_queue[DS3231_EVENT_QUEUE_SIZE];                                /**< alarm event queue */
+    volatile uint32_t event_head;                                                       /**< event queue head, written by the irq side */
+    volatile uint32_t event_tail;                                                       /**< event queue tail, written by the consumer */
+    volatile uint32_t event_dropped;                                                    /**< events dropped on a full queue */
+    uint8_t iic_addr;                                                                   /**< iic device address */
     uint8_t inited;                                                                     /**< inited flag */
+    uint8_t cache_enable;                                                               /**< register cache enable flag */
+    uint8_t cache_valid;                                                                /**< register cache valid flag */
+    uint8_t control_shadow;                                                             /**< control register shadow */
+    uint8_t status_shadow;                                                              /**< status register shadow */
+#if (DS3231_STATS_ENABLE != 0)
+    ds3231_stats_t stats;                                                               /**< bus counters and latency histograms */
+    ds3231_stats_api_t stats_api;                                                       /**< api holding the lock */
+    uint64_t stats_start;                                                               /**< lock timestamp in us */
+#endif
 } ds3231_handle_t;
 
 /**
@@ -264,7 +455,7 @@ typedef struct ds3231_info_s
  * @brief     link debug_print function
  * @param[in] HANDLE pointer to a ds3231 handle structure
  * @param[in] FUC pointer to a debug_print function address
- * @note      none
+ * @note      it may be NULL when DS3231_DEBUG_PRINT_ENABLE is 0
  */
 #define DRIVER_DS3231_LINK_DEBUG_PRINT(HANDLE, FUC)       (HANDLE)->debug_print = FUC
 
@@ -276,6 +467,102 @@ typedef struct ds3231_info_s
  */
 #define DRIVER_DS3231_LINK_RECEIVE_CALLBACK(HANDLE, FUC)  (HANDLE)->receive_callback = FUC
 
+/**
+ * @brief     link iic_init_ctx function
+ * @param[in] HANDLE pointer to a ds3231 handle structure
+ * @param[in] FUC pointer to an iic_init_ctx function address
+ * @note      it is used instead of iic_init when linked
+ */
+#define DRIVER_DS3231_LINK_IIC_INIT_CTX(HANDLE, FUC)          (HANDLE)->iic_init_ctx = FUC
+
+/**
+ * @brief     link iic_deinit_ctx function
+ * @param[in] HANDLE pointer to a ds3231 handle structure
+ * @param[in] FUC pointer to an iic_deinit_ctx function address
+ * @note      it is used instead of iic_deinit when linked
+ */
+#define DRIVER_DS3231_LINK_IIC_DEINIT_CTX(HANDLE, FUC)        (HANDLE)->iic_deinit_ctx = FUC
+
+/**
+ * @brief     link iic_read_ctx function
+ * @param[in] HANDLE pointer to a ds3231 handle structure
+ * @param[in] FUC pointer to an iic_read_ctx function address
+ * @note      it is used instead of iic_read when linked
+ */
+#define DRIVER_DS3231_LINK_IIC_READ_CTX(HANDLE, FUC)          (HANDLE)->iic_read_ctx = FUC
+
+/**
+ * @brief     link iic_write_ctx function
+ * @param[in] HANDLE pointer to a ds3231 handle structure
+ * @param[in] FUC pointer to an iic_write_ctx function address
+ * @note      it is used instead of iic_write when linked
+ */
+#define DRIVER_DS3231_LINK_IIC_WRITE_CTX(HANDLE, FUC)         (HANDLE)->iic_write_ctx = FUC
+
+/**
+ * @brief     link receive_callback_ctx function
+ * @param[in] HANDLE pointer to a ds3231 handle structure
+ * @param[in] FUC pointer to a receive_callback_ctx function address
+ * @note      it is used instead of receive_callback when linked
+ */
+#define DRIVER_DS3231_LINK_RECEIVE_CALLBACK_CTX(HANDLE, FUC)  (HANDLE)->receive_callback_ctx = FUC
+
+/**
+ * @brief     link iic_transfer function
+ * @param[in] HANDLE pointer to a ds3231 handle structure
+ * @param[in] FUC pointer to an iic_transfer function address
+ * @note      NULL means the transaction is run with iic_read and iic_write
+ */
+#define DRIVER_DS3231_LINK_IIC_TRANSFER(HANDLE, FUC)          (HANDLE)->iic_transfer = FUC
+
+/**
+ * @brief     link iic_transfer_ctx function
+ * @param[in] HANDLE pointer to a ds3231 handle structure
+ * @param[in] FUC pointer to an iic_transfer_ctx function address
+ * @note      it is used instead of iic_transfer when linked
+ */
+#define DRIVER_DS3231_LINK_IIC_TRANSFER_CTX(HANDLE, FUC)      (HANDLE)->iic_transfer_ctx = FUC
+
+/**
+ * @brief     link the user context
+ * @param[in] HANDLE pointer to a ds3231 handle structure
+ * @param[in] CTX pointer to a user context
+ * @note      it is passed to every ctx function
+ */
+#define DRIVER_DS3231_LINK_USER_CTX(HANDLE, CTX)              (HANDLE)->user_ctx = CTX
+
+/**
+ * @brief     link lock function
+ * @param[in] HANDLE pointer to a ds3231 handle structure
+ * @param[in] FUC pointer to a lock function address
+ * @note      NULL means no locking
+ */
+#define DRIVER_DS3231_LINK_LOCK(HANDLE, FUC)                  (HANDLE)->lock = FUC
+
+/**
+ * @brief     link unlock function
+ * @param[in] HANDLE pointer to a ds3231 handle structure
+ * @param[in] FUC pointer to an unlock function address
+ * @note      NULL means no locking
+ */
+#define DRIVER_DS3231_LINK_UNLOCK(HANDLE, FUC)                (HANDLE)->unlock = FUC
+
+/**
+ * @brief     link the lock context
+ * @param[in] HANDLE pointer to a ds3231 handle structure
+ * @param[in] CTX pointer to a lock context
+ * @note      it is passed to the lock and unlock functions
+ */
+#define DRIVER_DS3231_LINK_LOCK_CTX(HANDLE, CTX)              (HANDLE)->lock_ctx = CTX
+
+/**
+ * @brief     link timestamp_us function
+ * @param[in] HANDLE pointer to a ds3231 handle structure
+ * @param[in] FUC pointer to a timestamp_us function address
+ * @note      NULL means no latency histograms, it is only used with DS3231_STATS_ENABLE
+ */
+#define DRIVER_DS3231_LINK_TIMESTAMP_US(HANDLE, FUC)          (HANDLE)->timestamp_us = FUC
+
 /**
  * @}
  */
@@ -297,6 +584,28 @@ typedef struct ds3231_info_s
  */
 uint8_t ds3231_info(ds3231_info_t *info);
 
+/**
+ * @brief     set the iic address
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @param[in] addr iic write address
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ * @note      call it before ds3231_init, 0 means the default 0xD0 address
+ */
+uint8_t ds3231_set_addr(ds3231_handle_t *handle, uint8_t addr);
+
+/**
+ * @brief      get the iic address
+ * @param[in]  *handle pointer to a ds3231 handle structure
+ * @param[out] *addr pointer to an iic write address buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ * @note       none
+ */
+uint8_t ds3231_get_addr(ds3231_handle_t *handle, uint8_t *addr);
+
 /**
  * @brief     initialize the chip
  * @param[in] *handle pointer to a ds3231 handle structure
@@ -333,6 +642,72 @@ uint8_t ds3231_deinit(ds3231_handle_t *handle);
  */
 uint8_t ds3231_irq_handler(ds3231_handle_t *handle);
 
+/**
+ * @brief     irq handler that clears the alarm flags and queues the events
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @param[in] timestamp user timestamp stored in the events
+ * @return    status code
+ *            - 0 success
+ *            - 1 run failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      only the observed flags are cleared in one write and no callback is run,
+ *            it is the single producer of the event queue
+ */
+uint8_t ds3231_irq_event_handler(ds3231_handle_t *handle, uint64_t timestamp);
+
+/**
+ * @brief      get the queued alarm events
+ * @param[in]  *handle pointer to a ds3231 handle structure
+ * @param[out] *events pointer to an event buffer
+ * @param[in]  len event buffer length
+ * @param[out] *count pointer to a read event count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       it is the single consumer of the event queue and takes no lock
+ */
+uint8_t ds3231_get_events(ds3231_handle_t *handle, ds3231_event_t *events, uint32_t len, uint32_t *count);
+
+/**
+ * @brief      get the number of dropped alarm events
+ * @param[in]  *handle pointer to a ds3231 handle structure
+ * @param[out] *dropped pointer to a dropped event count buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       events are dropped when the queue is full
+ */
+uint8_t ds3231_get_dropped_events(ds3231_handle_t *handle, uint32_t *dropped);
+
+/**
+ * @brief      get the bus counters and latency histograms
+ * @param[in]  *handle pointer to a ds3231 handle structure
+ * @param[out] *stats pointer to a stats structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle or stats is NULL
+ *             - 3 handle is not initialized
+ *             - 4 stats are not compiled in
+ * @note       the counters are kept when DS3231_STATS_ENABLE is not 0,
+ *             every api takes the write lock in this build
+ */
+uint8_t ds3231_get_stats(ds3231_handle_t *handle, ds3231_stats_t *stats);
+
+/**
+ * @brief     clear the bus counters and latency histograms
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ *            - 4 stats are not compiled in
+ * @note      ds3231_init clears them too
+ */
+uint8_t ds3231_reset_stats(ds3231_handle_t *handle);
+
 /**
  * @brief     set the current time
  * @param[in] *handle pointer to a ds3231 handle structure
@@ -356,6 +731,7 @@ uint8_t ds3231_set_time(ds3231_handle_t *handle, ds3231_time_t *t);
  *             - 1 get time failed
  *             - 2 handle or time is NULL
  *             - 3 handle is not initialized
+ *             - 4 time register is invalid
  * @note       none
  */
 uint8_t ds3231_get_time(ds3231_handle_t *handle, ds3231_time_t *t);
@@ -399,6 +775,20 @@ uint8_t ds3231_get_oscillator(ds3231_handle_t *handle, ds3231_bool_t *enable);
  */
 uint8_t ds3231_get_status(ds3231_handle_t *handle, uint8_t *status);
 
+/**
+ * @brief      read all registers in one transaction
+ * @param[in]  *handle pointer to a ds3231 handle structure
+ * @param[out] *snapshot pointer to a snapshot structure
+ * @return     status code
+ *             - 0 success
+ *             - 1 read snapshot failed
+ *             - 2 handle or snapshot is NULL
+ *             - 3 handle is not initialized
+ *             - 4 time register is invalid
+ * @note       the temperature is the last conversion result, no conversion is started
+ */
+uint8_t ds3231_read_snapshot(ds3231_handle_t *handle, ds3231_snapshot_t *snapshot);
+
 /**
  * @}
  */
@@ -462,6 +852,32 @@ uint8_t ds3231_set_square_wave(ds3231_handle_t *handle, ds3231_bool_t enable);
  */
 uint8_t ds3231_get_square_wave(ds3231_handle_t *handle, ds3231_bool_t *enable);
 
+/**
+ * @brief     set the square wave output frequency
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @param[in] frequency square wave frequency
+ * @return    status code
+ *            - 0 success
+ *            - 1 set square wave frequency failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the frequency is only output when the pin is set to the square wave function
+ */
+uint8_t ds3231_set_square_wave_frequency(ds3231_handle_t *handle, ds3231_square_wave_frequency_t frequency);
+
+/**
+ * @brief      get the square wave output frequency
+ * @param[in]  *handle pointer to a ds3231 handle structure
+ * @param[out] *frequency pointer to a square wave frequency buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get square wave frequency failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds3231_get_square_wave_frequency(ds3231_handle_t *handle, ds3231_square_wave_frequency_t *frequency);
+
 /**
  * @brief     enable or disable the 32KHz output
  * @param[in] *handle pointer to a ds3231 handle structure
@@ -488,6 +904,43 @@ uint8_t ds3231_set_32khz_output(ds3231_handle_t *handle, ds3231_bool_t enable);
  */
 uint8_t ds3231_get_32khz_output(ds3231_handle_t *handle, ds3231_bool_t *enable);
 
+/**
+ * @brief     enable or disable the register shadow cache
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @param[in] enable bool value
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      when enabled, control getters and the 32khz output getter are served from ram and
+ *            control setters become a single write, volatile status flags are always read from the chip
+ */
+uint8_t ds3231_set_register_cache(ds3231_handle_t *handle, ds3231_bool_t enable);
+
+/**
+ * @brief      get the register shadow cache status
+ * @param[in]  *handle pointer to a ds3231 handle structure
+ * @param[out] *enable pointer to a bool value buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       none
+ */
+uint8_t ds3231_get_register_cache(ds3231_handle_t *handle, ds3231_bool_t *enable);
+
+/**
+ * @brief     invalidate the register shadow cache
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      the next cached access reloads the control and status registers from the chip,
+ *            call it after anything else on the bus may have changed them
+ */
+uint8_t ds3231_invalidate_register_cache(ds3231_handle_t *handle);
+
 /**
  * @brief      get the chip temperature
  * @param[in]  *handle pointer to a ds3231 handle structure
@@ -498,10 +951,51 @@ uint8_t ds3231_get_32khz_output(ds3231_handle_t *handle, ds3231_bool_t *enable);
  *             - 1 get temperature failed
  *             - 2 handle is NULL
  *             - 3 handle is not initialized
- * @note       none
+ * @note       blocks until the conversion finishes
  */
 uint8_t ds3231_get_temperature(ds3231_handle_t *handle, int16_t *raw, float *s);
 
+/**
+ * @brief     start a temperature conversion
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 start temperature conversion failed
+ *            - 2 handle is NULL
+ *            - 3 handle is not initialized
+ * @note      returns at once, use ds3231_poll_temperature to get the result
+ */
+uint8_t ds3231_start_temperature_conversion(ds3231_handle_t *handle);
+
+/**
+ * @brief      poll the temperature conversion
+ * @param[in]  *handle pointer to a ds3231 handle structure
+ * @param[out] *raw pointer to a raw temperature buffer
+ * @param[out] *s pointer to a converted temperature buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 poll temperature failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 conversion is busy
+ * @note       control, status and temperature are read in one transaction
+ */
+uint8_t ds3231_poll_temperature(ds3231_handle_t *handle, int16_t *raw, float *s);
+
+/**
+ * @brief      get the chip temperature without starting a conversion
+ * @param[in]  *handle pointer to a ds3231 handle structure
+ * @param[out] *raw pointer to a raw temperature buffer
+ * @param[out] *s pointer to a converted temperature buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 get temperature failed
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ * @note       the chip converts by itself every 64 seconds, so the value is at most 64 seconds old
+ */
+uint8_t ds3231_get_temperature_no_conversion(ds3231_handle_t *handle, int16_t *raw, float *s);
+
 /**
  * @brief     set the chip aging offset
  * @param[in] *handle pointer to a ds3231 handle structure
@@ -554,6 +1048,64 @@ uint8_t ds3231_aging_offset_convert_to_register(ds3231_handle_t *handle, float o
  */
 uint8_t ds3231_aging_offset_convert_to_data(ds3231_handle_t *handle, int8_t reg, float *offset);
 
+/**
+ * @brief      convert a time structure to the 7 bytes time register image
+ * @param[in]  *handle pointer to a ds3231 handle structure
+ * @param[in]  *t pointer to a time structure
+ * @param[out] *reg pointer to a 7 bytes register buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 time is invalid
+ * @note       the image can be written to register 0x00 with ds3231_set_reg
+ */
+uint8_t ds3231_time_convert_to_register(ds3231_handle_t *handle, ds3231_time_t *t, uint8_t *reg);
+
+/**
+ * @brief      convert the 7 bytes time register image to a time structure
+ * @param[in]  *handle pointer to a ds3231 handle structure
+ * @param[in]  *reg pointer to a 7 bytes register buffer
+ * @param[out] *t pointer to a time structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle is NULL
+ *             - 3 handle is not initialized
+ *             - 4 register image holds an invalid bcd value
+ * @note       none
+ */
+uint8_t ds3231_time_convert_to_data(ds3231_handle_t *handle, uint8_t *reg, ds3231_time_t *t);
+
+/**
+ * @brief      convert a time structure to a unix timestamp
+ * @param[in]  *handle pointer to a ds3231 handle structure
+ * @param[in]  *t pointer to a time structure
+ * @param[in]  utc_offset utc offset of the time structure in seconds
+ * @param[out] *timestamp pointer to a unix timestamp buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle or time is NULL
+ *             - 3 handle is not initialized
+ *             - 4 time is invalid
+ * @note       proleptic gregorian calendar, the week field is ignored
+ */
+uint8_t ds3231_time_to_unix(ds3231_handle_t *handle, ds3231_time_t *t, int32_t utc_offset, int64_t *timestamp);
+
+/**
+ * @brief      convert a unix timestamp to a time structure
+ * @param[in]  *handle pointer to a ds3231 handle structure
+ * @param[in]  timestamp unix timestamp
+ * @param[in]  utc_offset utc offset of the time structure in seconds
+ * @param[out] *t pointer to a time structure
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle or time is NULL
+ *             - 3 handle is not initialized
+ *             - 4 timestamp is out of the 2000 - 2199 range
+ * @note       the time structure is filled in 24H format, monday is week 1 and sunday is week 7
+ */
+uint8_t ds3231_unix_to_time(ds3231_handle_t *handle, int64_t timestamp, int32_t utc_offset, ds3231_time_t *t);
+
 /**
  * @}
  */
@@ -649,6 +1201,22 @@ uint8_t ds3231_set_alarm2(ds3231_handle_t *handle, ds3231_time_t *t, ds3231_alar
  */
 uint8_t ds3231_get_alarm2(ds3231_handle_t *handle, ds3231_time_t *t, ds3231_alarm2_mode_t *mode);
 
+/**
+ * @brief     set the alarm1 and alarm2 time in one transaction
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @param[in] *t1 pointer to an alarm1 time structure
+ * @param[in] mode1 alarm1 interrupt mode
+ * @param[in] *t2 pointer to an alarm2 time structure
+ * @param[in] mode2 alarm2 interrupt mode
+ * @return    status code
+ *            - 0 success
+ *            - 1 set alarms failed
+ *            - 2 handle or time is NULL
+ *            - 3 handle is not initialized
+ * @note      both alarms are validated before anything is written
+ */
+uint8_t ds3231_set_alarms(ds3231_handle_t *handle, ds3231_time_t *t1, ds3231_alarm1_mode_t mode1, ds3231_time_t *t2, ds3231_alarm2_mode_t mode2);
+
 /**
  * @brief     clear the alarm flag
  * @param[in] *handle pointer to a ds3231 handle structure
@@ -703,6 +1271,64 @@ uint8_t ds3231_set_reg(ds3231_handle_t *handle, uint8_t reg, uint8_t *buf, uint1
  */
 uint8_t ds3231_get_reg(ds3231_handle_t *handle, uint8_t reg, uint8_t *buf, uint16_t len);
 
+/**
+ * @brief     initialize a transaction
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @param[in] *transaction pointer to a transaction structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle or transaction is NULL
+ *            - 3 handle is not initialized
+ * @note      none
+ */
+uint8_t ds3231_transaction_init(ds3231_handle_t *handle, ds3231_transaction_t *transaction);
+
+/**
+ * @brief      queue a register read in a transaction
+ * @param[in]  *handle pointer to a ds3231 handle structure
+ * @param[in]  *transaction pointer to a transaction structure
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len data buffer length
+ * @return     status code
+ *             - 0 success
+ *             - 2 handle, transaction or buf is NULL
+ *             - 3 handle is not initialized
+ *             - 4 transaction is full
+ * @note       a read takes two i2c messages, buf is filled by ds3231_transaction_submit
+ */
+uint8_t ds3231_transaction_add_read(ds3231_handle_t *handle, ds3231_transaction_t *transaction, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     queue a register write in a transaction
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @param[in] *transaction pointer to a transaction structure
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len data buffer length
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle, transaction or buf is NULL
+ *            - 3 handle is not initialized
+ *            - 4 transaction is full
+ * @note      buf must stay valid until ds3231_transaction_submit returns
+ */
+uint8_t ds3231_transaction_add_write(ds3231_handle_t *handle, ds3231_transaction_t *transaction, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     submit a transaction
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @param[in] *transaction pointer to a transaction structure
+ * @return    status code
+ *            - 0 success
+ *            - 1 transfer failed
+ *            - 2 handle or transaction is NULL
+ *            - 3 handle is not initialized
+ * @note      all accesses are run in order as one iic_transfer call when it is linked,
+ *            otherwise one by one, the transaction is kept and can be submitted again
+ */
+uint8_t ds3231_transaction_submit(ds3231_handle_t *handle, ds3231_transaction_t *transaction);
+
 /**
  * @}
  */
@@ -36,6 +36,7 @@
  */
 
 #include "driver_ds3231_alarm_test.h"
+#include "driver_ds3231_simulator.h"
 #include <stdlib.h>
 
 static ds3231_handle_t gs_handle;        /**< ds3231 handle */
@@ -53,6 +54,8 @@ uint8_t ds3231_alarm_test(void)
     int8_t reg;
     uint8_t times;
     uint8_t status;
+    uint32_t count;
+    ds3231_event_t event;
     ds3231_info_t info;
     ds3231_time_t time_in;
     
@@ -66,6 +69,9 @@ uint8_t ds3231_alarm_test(void)
     DRIVER_DS3231_LINK_DEBUG_PRINT(&gs_handle, ds3231_interface_debug_print);
     DRIVER_DS3231_LINK_RECEIVE_CALLBACK(&gs_handle, ds3231_interface_receive_callback);
     
+    /* run on the simulated device when it is enabled */
+    (void)ds3231_simulator_link(&gs_handle);
+    
     /* get ds3231 info */
     res = ds3231_info(&info);
     if (res != 0)
@@ -220,7 +226,7 @@ uint8_t ds3231_alarm_test(void)
         
         return 1;
     }
-    ds3231_interface_delay_ms(2000);
+    gs_handle.delay_ms(2000);
     res = ds3231_get_status(&gs_handle, (uint8_t *)&status);
     if (res != 0)
     {
@@ -241,6 +247,35 @@ uint8_t ds3231_alarm_test(void)
         return 1;
     }
     
+    /* queue the alarm1 event */
+    res = ds3231_irq_event_handler(&gs_handle, 1);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: irq event handler failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds3231_get_status(&gs_handle, (uint8_t *)&status);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: get status failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds3231_interface_debug_print("ds3231: check alarm1 flag clear %s.\n", ((status & DS3231_STATUS_ALARM_1) == 0) ? "ok" : "error");
+    res = ds3231_get_events(&gs_handle, &event, 1, &count);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: get events failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds3231_interface_debug_print("ds3231: check alarm1 event %s.\n",
+                                 ((count == 1) && (event.type == DS3231_STATUS_ALARM_1) && (event.timestamp == 1)) ? "ok" : "error");
+    
     /* disable alarm1 */
     res = ds3231_set_alarm_interrupt(&gs_handle, DS3231_ALARM_1, DS3231_BOOL_FALSE);
     if (res != 0)
@@ -271,7 +306,7 @@ uint8_t ds3231_alarm_test(void)
     times = 61;
     while (times != 0)
     {
-        ds3231_interface_delay_ms(1000);
+        gs_handle.delay_ms(1000);
         times--;
         ds3231_interface_debug_print("ds3231: time left %ds.\n", times);
     }
@@ -0,0 +1,380 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds3231_calendar_test.c
+ * @brief     driver ds3231 calendar test source file
+ * @version   2.0.0
+ * @author    Shifeng Li
+ * @date      2021-03-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2021/03/15  <td>2.0      <td>Shifeng Li  <td>format the code
+ * <tr><td>2020/11/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds3231_calendar_test.h"
+#include "driver_ds3231_simulator.h"
+
+/**
+ * @brief calendar test case structure definition
+ */
+typedef struct ds3231_calendar_case_s
+{
+    const char *name;          /**< case name */
+    ds3231_time_t start;       /**< time before the step */
+    ds3231_time_t expect;      /**< time one second later */
+} ds3231_calendar_case_t;
+
+static ds3231_handle_t gs_handle;        /**< ds3231 handle */
+
+/**
+ * @brief calendar test cases
+ */
+static const ds3231_calendar_case_t gs_cases[] =
+{
+    {"leap day",                   {2024, 2, 3, 28, 23, 59, 59, DS3231_FORMAT_24H, DS3231_AM}, {2024, 2, 4, 29, 0, 0, 0, DS3231_FORMAT_24H, DS3231_AM}},
+    {"leap year february end",     {2024, 2, 4, 29, 23, 59, 59, DS3231_FORMAT_24H, DS3231_AM}, {2024, 3, 5, 1, 0, 0, 0, DS3231_FORMAT_24H, DS3231_AM}},
+    {"common year february end",   {2023, 2, 2, 28, 23, 59, 59, DS3231_FORMAT_24H, DS3231_AM}, {2023, 3, 3, 1, 0, 0, 0, DS3231_FORMAT_24H, DS3231_AM}},
+    {"year end",                   {2024, 12, 2, 31, 23, 59, 59, DS3231_FORMAT_24H, DS3231_AM}, {2025, 1, 3, 1, 0, 0, 0, DS3231_FORMAT_24H, DS3231_AM}},
+    {"century rollover",           {2099, 12, 4, 31, 23, 59, 59, DS3231_FORMAT_24H, DS3231_AM}, {2100, 1, 5, 1, 0, 0, 0, DS3231_FORMAT_24H, DS3231_AM}},
+    {"week rollover",              {2024, 6, 7, 9, 23, 59, 59, DS3231_FORMAT_24H, DS3231_AM}, {2024, 6, 1, 10, 0, 0, 0, DS3231_FORMAT_24H, DS3231_AM}},
+    {"12h am to pm",               {2024, 6, 1, 10, 11, 59, 59, DS3231_FORMAT_12H, DS3231_AM}, {2024, 6, 1, 10, 12, 0, 0, DS3231_FORMAT_12H, DS3231_PM}},
+    {"12h noon to one",            {2024, 6, 1, 10, 12, 59, 59, DS3231_FORMAT_12H, DS3231_PM}, {2024, 6, 1, 10, 1, 0, 0, DS3231_FORMAT_12H, DS3231_PM}},
+    {"12h pm to am",               {2024, 6, 1, 10, 11, 59, 59, DS3231_FORMAT_12H, DS3231_PM}, {2024, 6, 2, 11, 12, 0, 0, DS3231_FORMAT_12H, DS3231_AM}},
+    {"12h midnight to one",        {2024, 6, 2, 11, 12, 59, 59, DS3231_FORMAT_12H, DS3231_AM}, {2024, 6, 2, 11, 1, 0, 0, DS3231_FORMAT_12H, DS3231_AM}},
+};
+
+/**
+ * @brief     compare two times
+ * @param[in] *a pointer to a time structure
+ * @param[in] *b pointer to a time structure
+ * @return    status code
+ *            - 0 same time
+ *            - 1 different time
+ * @note      am pm is only compared in the 12h format
+ */
+static uint8_t a_ds3231_calendar_compare(const ds3231_time_t *a, const ds3231_time_t *b)
+{
+    if ((a->year != b->year) || (a->month != b->month) || (a->week != b->week) ||
+        (a->date != b->date) || (a->hour != b->hour) || (a->minute != b->minute) ||
+        (a->second != b->second) || (a->format != b->format))
+    {
+        return 1;
+    }
+    if ((a->format == DS3231_FORMAT_12H) && (a->am_pm != b->am_pm))
+    {
+        return 1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      step through a week in hours and count the alarm flags
+ * @param[in]  alarm alarm number
+ * @param[out] *count pointer to a flag count buffer
+ * @param[out] *t pointer to a time structure read after the last flag
+ * @return     status code
+ *             - 0 success
+ *             - 1 run failed
+ * @note       none
+ */
+static uint8_t a_ds3231_calendar_run_week(ds3231_alarm_t alarm, uint32_t *count, ds3231_time_t *t)
+{
+    uint8_t res;
+    uint8_t status;
+    uint8_t mask;
+    uint16_t i;
+    
+    mask = (alarm == DS3231_ALARM_1) ? DS3231_STATUS_ALARM_1 : DS3231_STATUS_ALARM_2;
+    *count = 0;
+    for (i = 0; i < 7 * 24; i++)
+    {
+        /* one hour later */
+        gs_handle.delay_ms(3600 * 1000);
+        res = ds3231_get_status(&gs_handle, (uint8_t *)&status);
+        if (res != 0)
+        {
+            ds3231_interface_debug_print("ds3231: get status failed.\n");
+            
+            return 1;
+        }
+        if ((status & mask) != 0)
+        {
+            (*count)++;
+            res = ds3231_get_time(&gs_handle, t);
+            if (res != 0)
+            {
+                ds3231_interface_debug_print("ds3231: get time failed.\n");
+                
+                return 1;
+            }
+            res = ds3231_alarm_clear(&gs_handle, alarm);
+            if (res != 0)
+            {
+                ds3231_interface_debug_print("ds3231: alarm clear failed.\n");
+                
+                return 1;
+            }
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  calendar test
+ * @return status code
+ *         - 0 success
+ *         - 1 test failed
+ * @note   the weekly alarm check delays a whole week, so run it on a simulated clock
+ */
+uint8_t ds3231_calendar_test(void)
+{
+    uint8_t res;
+    uint32_t i;
+    uint32_t count;
+    ds3231_info_t info;
+    ds3231_time_t time_in;
+    ds3231_time_t time_out;
+    ds3231_time_t time_alarm;
+    ds3231_time_t time_expect;
+    
+    /* link functions */
+    DRIVER_DS3231_LINK_INIT(&gs_handle, ds3231_handle_t);
+    DRIVER_DS3231_LINK_IIC_INIT(&gs_handle, ds3231_interface_iic_init);
+    DRIVER_DS3231_LINK_IIC_DEINIT(&gs_handle, ds3231_interface_iic_deinit);
+    DRIVER_DS3231_LINK_IIC_READ(&gs_handle, ds3231_interface_iic_read);
+    DRIVER_DS3231_LINK_IIC_WRITE(&gs_handle, ds3231_interface_iic_write);
+    DRIVER_DS3231_LINK_DELAY_MS(&gs_handle, ds3231_interface_delay_ms);
+    DRIVER_DS3231_LINK_DEBUG_PRINT(&gs_handle, ds3231_interface_debug_print);
+    DRIVER_DS3231_LINK_RECEIVE_CALLBACK(&gs_handle, ds3231_interface_receive_callback);
+    
+    /* run on the simulated device when it is enabled */
+    (void)ds3231_simulator_link(&gs_handle);
+    
+    /* get ds3231 info */
+    res = ds3231_info(&info);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: get info failed.\n");
+       
+        return 1;
+    }
+    else
+    {
+        /* print ds3231 info */
+        ds3231_interface_debug_print("ds3231: chip is %s.\n", info.chip_name);
+        ds3231_interface_debug_print("ds3231: manufacturer is %s.\n", info.manufacturer_name);
+        ds3231_interface_debug_print("ds3231: interface is %s.\n", info.interface);
+        ds3231_interface_debug_print("ds3231: driver version is %d.%d.\n", info.driver_version / 1000, (info.driver_version % 1000) / 100);
+        ds3231_interface_debug_print("ds3231: min supply voltage is %0.1fV.\n", info.supply_voltage_min_v);
+        ds3231_interface_debug_print("ds3231: max supply voltage is %0.1fV.\n", info.supply_voltage_max_v);
+        ds3231_interface_debug_print("ds3231: max current is %0.2fmA.\n", info.max_current_ma);
+        ds3231_interface_debug_print("ds3231: max temperature is %0.1fC.\n", info.temperature_max);
+        ds3231_interface_debug_print("ds3231: min temperature is %0.1fC.\n", info.temperature_min);
+    }
+    
+    /* start calendar test */
+    ds3231_interface_debug_print("ds3231: start calendar test.\n");
+    
+    /* init ds3231 */
+    res = ds3231_init(&gs_handle);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: init failed.\n");
+        
+        return 1;
+    }
+    
+    /* set oscillator */
+    res = ds3231_set_oscillator(&gs_handle, DS3231_BOOL_TRUE);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: set oscillator failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* calendar boundaries */
+    ds3231_interface_debug_print("ds3231: calendar boundary test.\n");
+    for (i = 0; i < sizeof(gs_cases) / sizeof(gs_cases[0]); i++)
+    {
+        time_in = gs_cases[i].start;
+        res = ds3231_set_time(&gs_handle, &time_in);
+        if (res != 0)
+        {
+            ds3231_interface_debug_print("ds3231: set time failed.\n");
+            (void)ds3231_deinit(&gs_handle);
+            
+            return 1;
+        }
+        gs_handle.delay_ms(1000);
+        res = ds3231_get_time(&gs_handle, &time_out);
+        if (res != 0)
+        {
+            ds3231_interface_debug_print("ds3231: get time failed.\n");
+            (void)ds3231_deinit(&gs_handle);
+            
+            return 1;
+        }
+        if (a_ds3231_calendar_compare(&time_out, &gs_cases[i].expect) != 0)
+        {
+            ds3231_interface_debug_print("ds3231: check %s error, time is %04d-%02d-%02d %02d:%02d:%02d %d.\n", gs_cases[i].name,
+                                         time_out.year, time_out.month, time_out.date,
+                                         time_out.hour, time_out.minute, time_out.second, time_out.week
+                                        );
+            (void)ds3231_deinit(&gs_handle);
+            
+            return 1;
+        }
+        ds3231_interface_debug_print("ds3231: check %s ok.\n", gs_cases[i].name);
+    }
+    
+    /* alarm1 once a week in the 24h format */
+    ds3231_interface_debug_print("ds3231: alarm1 weekly match test.\n");
+    time_in.format = DS3231_FORMAT_24H;
+    time_in.am_pm = DS3231_AM;
+    time_in.year = 2024;
+    time_in.month = 1;
+    time_in.date = 1;
+    time_in.week = 1;
+    time_in.hour = 0;
+    time_in.minute = 0;
+    time_in.second = 0;
+    res = ds3231_set_time(&gs_handle, &time_in);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: set time failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    time_alarm = time_in;
+    time_alarm.week = 4;
+    time_alarm.hour = 13;
+    time_alarm.minute = 30;
+    time_alarm.second = 15;
+    res = ds3231_set_alarm1(&gs_handle, &time_alarm, DS3231_ALARM1_MODE_WEEK_HOUR_MINUTE_SECOND_MATCH);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: set alarm1 failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds3231_alarm_clear(&gs_handle, DS3231_ALARM_1);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: alarm clear failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = a_ds3231_calendar_run_week(DS3231_ALARM_1, &count, &time_out);
+    if (res != 0)
+    {
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* the flag is seen at the first full hour after the match */
+    time_expect = time_in;
+    time_expect.date = 4;
+    time_expect.week = 4;
+    time_expect.hour = 14;
+    if ((count != 1) || (a_ds3231_calendar_compare(&time_out, &time_expect) != 0))
+    {
+        ds3231_interface_debug_print("ds3231: check alarm1 weekly match error, %d flags.\n", count);
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds3231_interface_debug_print("ds3231: check alarm1 weekly match ok.\n");
+    
+    /* alarm2 once a week in the 12h format */
+    ds3231_interface_debug_print("ds3231: alarm2 weekly match test.\n");
+    time_in.format = DS3231_FORMAT_12H;
+    time_in.am_pm = DS3231_AM;
+    time_in.hour = 12;
+    res = ds3231_set_time(&gs_handle, &time_in);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: set time failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    time_alarm = time_in;
+    time_alarm.week = 7;
+    time_alarm.am_pm = DS3231_PM;
+    time_alarm.hour = 11;
+    time_alarm.minute = 45;
+    res = ds3231_set_alarm2(&gs_handle, &time_alarm, DS3231_ALARM2_MODE_WEEK_HOUR_MINUTE_MATCH);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: set alarm2 failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds3231_alarm_clear(&gs_handle, DS3231_ALARM_2);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: alarm clear failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = a_ds3231_calendar_run_week(DS3231_ALARM_2, &count, &time_out);
+    if (res != 0)
+    {
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* the match at the end of the week is seen after the week rolls over */
+    time_expect = time_in;
+    time_expect.date = 8;
+    time_expect.week = 1;
+    if ((count != 1) || (a_ds3231_calendar_compare(&time_out, &time_expect) != 0))
+    {
+        ds3231_interface_debug_print("ds3231: check alarm2 weekly match error, %d flags.\n", count);
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds3231_interface_debug_print("ds3231: check alarm2 weekly match ok.\n");
+    
+    /* finish calendar test */
+    ds3231_interface_debug_print("ds3231: finish calendar test.\n");
+    (void)ds3231_deinit(&gs_handle);
+    
+    return 0;
+}
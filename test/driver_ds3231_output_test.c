@@ -36,6 +36,7 @@
  */
  
 #include "driver_ds3231_output_test.h"
+#include "driver_ds3231_simulator.h"
 #include <stdlib.h>
 
 static ds3231_handle_t gs_handle;        /**< ds3231 handle */
@@ -65,6 +66,9 @@ uint8_t ds3231_output_test(uint32_t times)
     DRIVER_DS3231_LINK_DEBUG_PRINT(&gs_handle, ds3231_interface_debug_print);
     DRIVER_DS3231_LINK_RECEIVE_CALLBACK(&gs_handle, ds3231_interface_receive_callback);
     
+    /* run on the simulated device when it is enabled */
+    (void)ds3231_simulator_link(&gs_handle);
+    
     /* get ds3231 info */
     res = ds3231_info(&info);
     if (res != 0)
@@ -191,7 +195,7 @@ uint8_t ds3231_output_test(uint32_t times)
     }
     for (i = 0; i < times; i++)
     {
-        ds3231_interface_delay_ms(1000);
+        gs_handle.delay_ms(1000);
         ds3231_interface_debug_print("ds3231: run %ds.\n", i+1);
     }
     
@@ -218,7 +222,7 @@ uint8_t ds3231_output_test(uint32_t times)
     }
     for (i = 0; i < times; i++)
     {
-        ds3231_interface_delay_ms(1000);
+        gs_handle.delay_ms(1000);
         ds3231_interface_debug_print("ds3231: run %ds.\n", i+1);
     }
     
@@ -36,6 +36,7 @@
  */
 
 #include "driver_ds3231_readwrite_test.h"
+#include "driver_ds3231_simulator.h"
 #include <stdlib.h>
 
 static ds3231_handle_t gs_handle;        /**< ds3231 handle */
@@ -53,6 +54,7 @@ uint8_t ds3231_readwrite_test(uint32_t times)
     uint8_t res;
     int8_t reg;
     uint32_t i;
+    uint32_t polls;
     int16_t raw;
     float s;
     ds3231_info_t info;
@@ -68,6 +70,9 @@ uint8_t ds3231_readwrite_test(uint32_t times)
     DRIVER_DS3231_LINK_DEBUG_PRINT(&gs_handle, ds3231_interface_debug_print);
     DRIVER_DS3231_LINK_RECEIVE_CALLBACK(&gs_handle, ds3231_interface_receive_callback);
     
+    /* run on the simulated device when it is enabled */
+    (void)ds3231_simulator_link(&gs_handle);
+    
     /* get ds3231 info */
     res = ds3231_info(&info);
     if (res != 0)
@@ -210,7 +215,7 @@ uint8_t ds3231_readwrite_test(uint32_t times)
     }
     for (i = 0; i < times; i++)
     {
-        ds3231_interface_delay_ms(1000);
+        gs_handle.delay_ms(1000);
         res = ds3231_get_time(&gs_handle, &time_out);
         if (res != 0)
         {
@@ -249,7 +254,7 @@ uint8_t ds3231_readwrite_test(uint32_t times)
     }
     for (i = 0; i < times; i++)
     {
-        ds3231_interface_delay_ms(1000);
+        gs_handle.delay_ms(1000);
         res = ds3231_get_time(&gs_handle, &time_out);
         if (res != 0)
         {
@@ -266,7 +271,7 @@ uint8_t ds3231_readwrite_test(uint32_t times)
     ds3231_interface_debug_print("ds3231: read temperature.\n");
     for (i = 0; i < times; i++)
     {
-        ds3231_interface_delay_ms(1000);
+        gs_handle.delay_ms(1000);
         res = ds3231_get_temperature(&gs_handle, (int16_t *)&raw, (float *)&s);
         if (res != 0)
         {
@@ -277,6 +282,55 @@ uint8_t ds3231_readwrite_test(uint32_t times)
         }
         ds3231_interface_debug_print("ds3231: temperature is %0.2f.\n", s);
     }
+    ds3231_interface_debug_print("ds3231: read temperature in non-blocking mode.\n");
+    for (i = 0; i < times; i++)
+    {
+        gs_handle.delay_ms(1000);
+        res = ds3231_start_temperature_conversion(&gs_handle);
+        if (res != 0)
+        {
+            ds3231_interface_debug_print("ds3231: start temperature conversion failed.\n");
+            (void)ds3231_deinit(&gs_handle);
+            
+            return 1;
+        }
+        polls = 0;
+        while (1)
+        {
+            gs_handle.delay_ms(10);
+            res = ds3231_poll_temperature(&gs_handle, (int16_t *)&raw, (float *)&s);
+            if (res == 0)
+            {
+                break;
+            }
+            else if ((res != 4) || (polls > 500))
+            {
+                ds3231_interface_debug_print("ds3231: poll temperature failed.\n");
+                (void)ds3231_deinit(&gs_handle);
+                
+                return 1;
+            }
+            else
+            {
+                polls++;
+            }
+        }
+        ds3231_interface_debug_print("ds3231: temperature is %0.2f after %d polls.\n", s, polls);
+    }
+    ds3231_interface_debug_print("ds3231: read temperature without conversion.\n");
+    for (i = 0; i < times; i++)
+    {
+        gs_handle.delay_ms(1000);
+        res = ds3231_get_temperature_no_conversion(&gs_handle, (int16_t *)&raw, (float *)&s);
+        if (res != 0)
+        {
+            ds3231_interface_debug_print("ds3231: get temperature failed.\n");
+            (void)ds3231_deinit(&gs_handle);
+            
+            return 1;
+        }
+        ds3231_interface_debug_print("ds3231: temperature is %0.2f.\n", s);
+    }
     
     /* finish readwrite test */
     ds3231_interface_debug_print("ds3231: finish readwrite test.\n");
@@ -36,9 +36,11 @@
  */
 
 #include "driver_ds3231_register_test.h"
+#include "driver_ds3231_simulator.h"
 #include <stdlib.h>
 
 static ds3231_handle_t gs_handle;        /**< ds3231 handle */
+static ds3231_stats_t gs_stats;          /**< ds3231 stats */
 
 /**
  * @brief  register test
@@ -55,10 +57,18 @@ uint8_t ds3231_register_test(void)
     float o, o_check;
     ds3231_info_t info;
     ds3231_time_t time_in, time_out;
+    ds3231_time_t time_in2, time_out2;
     ds3231_alarm1_mode_t mode1;
     ds3231_alarm2_mode_t mode2;
     ds3231_bool_t enable;
     ds3231_pin_t pin;
+    ds3231_square_wave_frequency_t frequency;
+    ds3231_snapshot_t snapshot;
+    uint8_t image[7];
+    int64_t timestamp, timestamp_check;
+    uint8_t addr;
+    uint8_t i;
+    ds3231_transaction_t transaction;
     
     /* link functions */
     DRIVER_DS3231_LINK_INIT(&gs_handle, ds3231_handle_t);
@@ -70,6 +80,10 @@ uint8_t ds3231_register_test(void)
     DRIVER_DS3231_LINK_DEBUG_PRINT(&gs_handle, ds3231_interface_debug_print);
     DRIVER_DS3231_LINK_RECEIVE_CALLBACK(&gs_handle, ds3231_interface_receive_callback);
     
+    /* run on the simulated device when it is enabled */
+    (void)ds3231_simulator_link(&gs_handle);
+    DRIVER_DS3231_LINK_TIMESTAMP_US(&gs_handle, ds3231_interface_timestamp_us);
+    
     /* get ds3231 info */
     res = ds3231_info(&info);
     if (res != 0)
@@ -95,6 +109,37 @@ uint8_t ds3231_register_test(void)
     /* start register test */
     ds3231_interface_debug_print("ds3231: start register test.\n");
     
+    /* ds3231_set_addr/ds3231_get_addr test */
+    ds3231_interface_debug_print("ds3231: ds3231_set_addr/ds3231_get_addr test.\n");
+    
+    /* default address */
+    res = ds3231_get_addr(&gs_handle, &addr);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: get addr failed.\n");
+        
+        return 1;
+    }
+    ds3231_interface_debug_print("ds3231: check default addr %s.\n", (addr == 0xD0)?"ok":"error");
+    
+    /* set address */
+    res = ds3231_set_addr(&gs_handle, 0xD0);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: set addr failed.\n");
+        
+        return 1;
+    }
+    ds3231_interface_debug_print("ds3231: set addr 0x%02X.\n", 0xD0);
+    res = ds3231_get_addr(&gs_handle, &addr);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: get addr failed.\n");
+        
+        return 1;
+    }
+    ds3231_interface_debug_print("ds3231: check addr %s.\n", (addr == 0xD0)?"ok":"error");
+    
     /* init ds3231 */
     res = ds3231_init(&gs_handle);
     if (res != 0)
@@ -673,6 +718,67 @@ uint8_t ds3231_register_test(void)
     }
     ds3231_interface_debug_print("ds3231: check alarm2 time %s.\n", (mode2 == DS3231_ALARM2_MODE_WEEK_HOUR_MINUTE_MATCH)?"ok":"error");
     
+    /* ds3231_set_alarms test */
+    ds3231_interface_debug_print("ds3231: ds3231_set_alarms test.\n");
+    
+    time_in.format = DS3231_FORMAT_24H;
+    time_in.am_pm = DS3231_AM;
+    time_in.year = 0;
+    time_in.month = 0;
+    time_in.week = rand() % 7 + 1;
+    time_in.date = rand() % 20 + 1;
+    time_in.hour = rand() % 24;
+    time_in.minute = rand() % 60;
+    time_in.second = rand() % 60;
+    time_in2.format = DS3231_FORMAT_24H;
+    time_in2.am_pm = DS3231_AM;
+    time_in2.year = 0;
+    time_in2.month = 0;
+    time_in2.week = rand() % 7 + 1;
+    time_in2.date = rand() % 20 + 1;
+    time_in2.hour = rand() % 24;
+    time_in2.minute = rand() % 60;
+    time_in2.second = 0;
+    ds3231_interface_debug_print("ds3231: set alarm1 time %04d-%02d-%02d %02d:%02d:%02d %d.\n",
+                                 time_in.year, time_in.month, time_in.date,
+                                 time_in.hour, time_in.minute, time_in.second, time_in.week
+                                );
+    ds3231_interface_debug_print("ds3231: set alarm2 time %04d-%02d-%02d %02d:%02d:%02d %d.\n",
+                                 time_in2.year, time_in2.month, time_in2.date,
+                                 time_in2.hour, time_in2.minute, time_in2.second, time_in2.week
+                                );
+    res = ds3231_set_alarms(&gs_handle, &time_in, DS3231_ALARM1_MODE_DATE_HOUR_MINUTE_SECOND_MATCH,
+                            &time_in2, DS3231_ALARM2_MODE_WEEK_HOUR_MINUTE_MATCH);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: set alarms failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds3231_get_alarm1(&gs_handle, &time_out, &mode1);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: get alarm1 failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds3231_interface_debug_print("ds3231: check alarm1 time %s.\n", ((time_in.date == time_out.date) && (time_in.hour == time_out.hour) &&
+                                 (time_in.minute == time_out.minute) && (time_in.second == time_out.second) &&
+                                 (mode1 == DS3231_ALARM1_MODE_DATE_HOUR_MINUTE_SECOND_MATCH))?"ok":"error");
+    res = ds3231_get_alarm2(&gs_handle, &time_out2, &mode2);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: get alarm2 failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds3231_interface_debug_print("ds3231: check alarm2 time %s.\n", ((time_in2.week == time_out2.week) && (time_in2.hour == time_out2.hour) &&
+                                 (time_in2.minute == time_out2.minute) &&
+                                 (mode2 == DS3231_ALARM2_MODE_WEEK_HOUR_MINUTE_MATCH))?"ok":"error");
+    
     /* ds3231_set_oscillator/ds3231_get_oscillator test */
     ds3231_interface_debug_print("ds3231: ds3231_set_oscillator/ds3231_get_oscillator test.\n");
     
@@ -885,6 +991,89 @@ uint8_t ds3231_register_test(void)
     }
     ds3231_interface_debug_print("ds3231: check bool %s.\n", (enable == DS3231_BOOL_FALSE)?"ok":"error");
     
+    /* ds3231_set_square_wave_frequency/ds3231_get_square_wave_frequency */
+    ds3231_interface_debug_print("ds3231: ds3231_set_square_wave_frequency/ds3231_get_square_wave_frequency test.\n");
+    
+    /* 1hz */
+    res = ds3231_set_square_wave_frequency(&gs_handle, DS3231_SQUARE_WAVE_FREQUENCY_1HZ);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: set square wave frequency failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds3231_interface_debug_print("ds3231: set 1hz.\n");
+    res = ds3231_get_square_wave_frequency(&gs_handle, &frequency);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: get square wave frequency failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds3231_interface_debug_print("ds3231: check frequency %s.\n", (frequency == DS3231_SQUARE_WAVE_FREQUENCY_1HZ)?"ok":"error");
+    
+    /* 1024hz */
+    res = ds3231_set_square_wave_frequency(&gs_handle, DS3231_SQUARE_WAVE_FREQUENCY_1024HZ);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: set square wave frequency failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds3231_interface_debug_print("ds3231: set 1024hz.\n");
+    res = ds3231_get_square_wave_frequency(&gs_handle, &frequency);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: get square wave frequency failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds3231_interface_debug_print("ds3231: check frequency %s.\n", (frequency == DS3231_SQUARE_WAVE_FREQUENCY_1024HZ)?"ok":"error");
+    
+    /* 4096hz */
+    res = ds3231_set_square_wave_frequency(&gs_handle, DS3231_SQUARE_WAVE_FREQUENCY_4096HZ);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: set square wave frequency failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds3231_interface_debug_print("ds3231: set 4096hz.\n");
+    res = ds3231_get_square_wave_frequency(&gs_handle, &frequency);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: get square wave frequency failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds3231_interface_debug_print("ds3231: check frequency %s.\n", (frequency == DS3231_SQUARE_WAVE_FREQUENCY_4096HZ)?"ok":"error");
+    
+    /* 8192hz */
+    res = ds3231_set_square_wave_frequency(&gs_handle, DS3231_SQUARE_WAVE_FREQUENCY_8192HZ);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: set square wave frequency failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds3231_interface_debug_print("ds3231: set 8192hz.\n");
+    res = ds3231_get_square_wave_frequency(&gs_handle, &frequency);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: get square wave frequency failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds3231_interface_debug_print("ds3231: check frequency %s.\n", (frequency == DS3231_SQUARE_WAVE_FREQUENCY_8192HZ)?"ok":"error");
+    
     /* ds3231_set_32khz_output/ds3231_get_32khz_output */
     ds3231_interface_debug_print("ds3231: ds3231_set_32khz_output/ds3231_get_32khz_output test.\n");
     
@@ -928,6 +1117,94 @@ uint8_t ds3231_register_test(void)
     }
     ds3231_interface_debug_print("ds3231: check bool %s.\n", (enable == DS3231_BOOL_FALSE)?"ok":"error");
     
+    /* ds3231_set_register_cache/ds3231_get_register_cache */
+    ds3231_interface_debug_print("ds3231: ds3231_set_register_cache/ds3231_get_register_cache test.\n");
+    
+    /* enable */
+    res = ds3231_set_register_cache(&gs_handle, DS3231_BOOL_TRUE);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: set register cache failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds3231_interface_debug_print("ds3231: enable.\n");
+    res = ds3231_get_register_cache(&gs_handle, &enable);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: get register cache failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds3231_interface_debug_print("ds3231: check bool %s.\n", (enable == DS3231_BOOL_TRUE)?"ok":"error");
+    
+    /* cached square wave */
+    res = ds3231_set_square_wave(&gs_handle, DS3231_BOOL_TRUE);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: set square wave failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds3231_invalidate_register_cache(&gs_handle);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: invalidate register cache failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds3231_interface_debug_print("ds3231: invalidate register cache.\n");
+    res = ds3231_get_square_wave(&gs_handle, &enable);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: get square wave failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds3231_interface_debug_print("ds3231: check cached square wave %s.\n", (enable == DS3231_BOOL_TRUE)?"ok":"error");
+    res = ds3231_set_square_wave(&gs_handle, DS3231_BOOL_FALSE);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: set square wave failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    
+    /* disable */
+    res = ds3231_set_register_cache(&gs_handle, DS3231_BOOL_FALSE);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: set register cache failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds3231_interface_debug_print("ds3231: disable.\n");
+    res = ds3231_get_register_cache(&gs_handle, &enable);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: get register cache failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds3231_interface_debug_print("ds3231: check bool %s.\n", (enable == DS3231_BOOL_FALSE)?"ok":"error");
+    res = ds3231_get_square_wave(&gs_handle, &enable);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: get square wave failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds3231_interface_debug_print("ds3231: check uncached square wave %s.\n", (enable == DS3231_BOOL_FALSE)?"ok":"error");
+    
     /* ds3231_set_aging_offset/ds3231_get_aging_offset */
     ds3231_interface_debug_print("ds3231: ds3231_set_aging_offset/ds3231_get_aging_offset test.\n");
     offset = -(rand() % 128);
@@ -962,6 +1239,132 @@ uint8_t ds3231_register_test(void)
     }
     ds3231_interface_debug_print("ds3231: check status 0x%02X.\n", status);
     
+    /* ds3231_read_snapshot test */
+    ds3231_interface_debug_print("ds3231: ds3231_read_snapshot test.\n");
+    res = ds3231_read_snapshot(&gs_handle, &snapshot);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: read snapshot failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds3231_interface_debug_print("ds3231: snapshot time is %04d-%02d-%02d %02d:%02d:%02d %d.\n",
+                                 snapshot.time.year, snapshot.time.month, snapshot.time.date,
+                                 snapshot.time.hour, snapshot.time.minute, snapshot.time.second, snapshot.time.week
+                                );
+    ds3231_interface_debug_print("ds3231: snapshot control 0x%02X status 0x%02X temperature %0.2fC.\n",
+                                 snapshot.control, snapshot.status, snapshot.temperature);
+    ds3231_interface_debug_print("ds3231: check snapshot aging offset %s.\n", (snapshot.aging_offset == offset)?"ok":"error");
+    ds3231_interface_debug_print("ds3231: check snapshot alarm2 mode %s.\n",
+                                 (snapshot.alarm2_mode == DS3231_ALARM2_MODE_WEEK_HOUR_MINUTE_MATCH)?"ok":"error");
+    
+    /* ds3231_transaction_init/ds3231_transaction_add_read/ds3231_transaction_add_write/ds3231_transaction_submit test */
+    ds3231_interface_debug_print("ds3231: ds3231_transaction_init/ds3231_transaction_add_read/ds3231_transaction_add_write/ds3231_transaction_submit test.\n");
+    res = ds3231_transaction_init(&gs_handle, &transaction);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: transaction init failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    offset = (int8_t)(rand() % 128);
+    offset_check = 0;
+    
+    /* write the aging offset, read it back and read the status */
+    res = ds3231_transaction_add_write(&gs_handle, &transaction, 0x10, (uint8_t *)&offset, 1);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: transaction add write failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds3231_transaction_add_read(&gs_handle, &transaction, 0x10, (uint8_t *)&offset_check, 1);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: transaction add read failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds3231_transaction_add_read(&gs_handle, &transaction, 0x0F, (uint8_t *)&status, 1);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: transaction add read failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    res = ds3231_transaction_submit(&gs_handle, &transaction);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: transaction submit failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds3231_interface_debug_print("ds3231: set offset %d.\n", offset);
+    ds3231_interface_debug_print("ds3231: check transaction offset %s.\n", (offset_check == offset)?"ok":"error");
+    ds3231_interface_debug_print("ds3231: check transaction status 0x%02X.\n", status);
+    
+    /* fill the transaction */
+    res = ds3231_transaction_init(&gs_handle, &transaction);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: transaction init failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    for (i = 0; i < DS3231_TRANSACTION_MAX_MSG; i++)
+    {
+        if (ds3231_transaction_add_read(&gs_handle, &transaction, 0x0F, (uint8_t *)&status, 1) != 0)
+        {
+            break;
+        }
+    }
+    ds3231_interface_debug_print("ds3231: check transaction limit %s.\n", (i == DS3231_TRANSACTION_MAX_MSG / 2)?"ok":"error");
+    
+    /* ds3231_get_stats/ds3231_reset_stats test */
+    ds3231_interface_debug_print("ds3231: ds3231_get_stats/ds3231_reset_stats test.\n");
+    res = ds3231_reset_stats(&gs_handle);
+    if (res == 4)
+    {
+        ds3231_interface_debug_print("ds3231: skip stats check.\n");
+    }
+    else if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: reset stats failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    else
+    {
+        res = ds3231_get_time(&gs_handle, &time_out);
+        if (res != 0)
+        {
+            ds3231_interface_debug_print("ds3231: get time failed.\n");
+            (void)ds3231_deinit(&gs_handle);
+            
+            return 1;
+        }
+        res = ds3231_get_stats(&gs_handle, &gs_stats);
+        if (res != 0)
+        {
+            ds3231_interface_debug_print("ds3231: get stats failed.\n");
+            (void)ds3231_deinit(&gs_handle);
+            
+            return 1;
+        }
+        ds3231_interface_debug_print("ds3231: iic read %d bytes in %d calls.\n", gs_stats.read_bytes, gs_stats.iic_read);
+        ds3231_interface_debug_print("ds3231: check stats %s.\n",
+                                     ((gs_stats.call[DS3231_STATS_API_GET_TIME] == 1) && (gs_stats.iic_read == 1) &&
+                                      (gs_stats.read_bytes == 7) && (gs_stats.iic_write == 0))?"ok":"error");
+    }
+    
     /* ds3231_aging_offset_convert_to_register/ds3231_aging_offset_convert_to_data test */
     ds3231_interface_debug_print("ds3231: ds3231_aging_offset_convert_to_register/ds3231_aging_offset_convert_to_data test.\n");
     o = (float)(rand() % 100) /100.0f;
@@ -985,6 +1388,83 @@ uint8_t ds3231_register_test(void)
     ds3231_interface_debug_print("ds3231: offset is %0.3f.\n", o);
     ds3231_interface_debug_print("ds3231: convert offset is %0.3f.\n", o_check);
     
+    /* ds3231_time_convert_to_register/ds3231_time_convert_to_data test */
+    ds3231_interface_debug_print("ds3231: ds3231_time_convert_to_register/ds3231_time_convert_to_data test.\n");
+    time_in.format = DS3231_FORMAT_12H;
+    time_in.am_pm = DS3231_PM;
+    time_in.year = rand() % 200 + 2000;
+    time_in.month = rand() % 12 + 1;
+    time_in.date = rand() % 20 + 1;
+    time_in.week = rand() % 7 + 1;
+    time_in.hour = rand() % 12 + 1;
+    time_in.minute = rand() % 60;
+    time_in.second = rand() % 60;
+    res = ds3231_time_convert_to_register(&gs_handle, &time_in, (uint8_t *)image);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: time convert to register failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds3231_interface_debug_print("ds3231: image is %02X %02X %02X %02X %02X %02X %02X.\n",
+                                 image[0], image[1], image[2], image[3], image[4], image[5], image[6]);
+    res = ds3231_time_convert_to_data(&gs_handle, (uint8_t *)image, &time_out);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: time convert to data failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds3231_interface_debug_print("ds3231: check time %s.\n", (memcmp(&time_in, &time_out, sizeof(ds3231_time_t)) == 0)?"ok":"error");
+    image[0] = 0x5A;
+    res = ds3231_time_convert_to_data(&gs_handle, (uint8_t *)image, &time_out);
+    ds3231_interface_debug_print("ds3231: check invalid bcd %s.\n", (res == 4)?"ok":"error");
+    
+    /* ds3231_time_to_unix/ds3231_unix_to_time test */
+    ds3231_interface_debug_print("ds3231: ds3231_time_to_unix/ds3231_unix_to_time test.\n");
+    time_in.format = DS3231_FORMAT_24H;
+    time_in.am_pm = DS3231_AM;
+    time_in.year = 2100;
+    time_in.month = 3;
+    time_in.date = 1;
+    time_in.week = 1;
+    time_in.hour = 0;
+    time_in.minute = 0;
+    time_in.second = 0;
+    res = ds3231_time_to_unix(&gs_handle, &time_in, 0, (int64_t *)&timestamp);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: time to unix failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds3231_interface_debug_print("ds3231: check 2100-03-01 timestamp %s.\n", (timestamp == 4107542400LL)?"ok":"error");
+    timestamp = 946684800LL + (int64_t)(rand() % 0x7FFF) * 86400 + rand() % 86400;
+    res = ds3231_unix_to_time(&gs_handle, timestamp, 8 * 3600, &time_out);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: unix to time failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds3231_interface_debug_print("ds3231: time is %04d-%02d-%02d %02d:%02d:%02d %d.\n",
+                                 time_out.year, time_out.month, time_out.date,
+                                 time_out.hour, time_out.minute, time_out.second, time_out.week
+                                );
+    res = ds3231_time_to_unix(&gs_handle, &time_out, 8 * 3600, (int64_t *)&timestamp_check);
+    if (res != 0)
+    {
+        ds3231_interface_debug_print("ds3231: time to unix failed.\n");
+        (void)ds3231_deinit(&gs_handle);
+        
+        return 1;
+    }
+    ds3231_interface_debug_print("ds3231: check timestamp %s.\n", (timestamp == timestamp_check)?"ok":"error");
+    
     /* finish register test */
     ds3231_interface_debug_print("ds3231: finish register test.\n");
     (void)ds3231_deinit(&gs_handle);
@@ -0,0 +1,667 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds3231_simulator.c
+ * @brief     driver ds3231 simulator source file
+ * @version   2.0.0
+ * @author    Shifeng Li
+ * @date      2021-03-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2021/03/15  <td>2.0      <td>Shifeng Li  <td>format the code
+ * <tr><td>2020/11/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#include "driver_ds3231_simulator.h"
+#include <string.h>
+
+/**
+ * @brief simulator register definition
+ */
+#define SIMULATOR_REG_NUM            0x13        /**< register number */
+#define SIMULATOR_REG_SECOND         0x00        /**< second register */
+#define SIMULATOR_REG_HOUR           0x02        /**< hour register */
+#define SIMULATOR_REG_WEEK           0x03        /**< week register */
+#define SIMULATOR_REG_DATE           0x04        /**< date register */
+#define SIMULATOR_REG_MONTH          0x05        /**< month register */
+#define SIMULATOR_REG_YEAR           0x06        /**< year register */
+#define SIMULATOR_REG_ALARM1         0x07        /**< alarm1 second register */
+#define SIMULATOR_REG_ALARM2         0x0B        /**< alarm2 minute register */
+#define SIMULATOR_REG_CONTROL        0x0E        /**< control register */
+#define SIMULATOR_REG_STATUS         0x0F        /**< status register */
+#define SIMULATOR_REG_TEMPERATURE    0x11        /**< temperature high register */
+
+/**
+ * @brief simulator bit definition
+ */
+#define SIMULATOR_BIT_CONV           (1 << 5)    /**< control conversion bit */
+#define SIMULATOR_BIT_INTCN          (1 << 2)    /**< control interrupt bit */
+#define SIMULATOR_BIT_OSF            (1 << 7)    /**< status oscillator stop bit */
+#define SIMULATOR_BIT_EN32KHZ        (1 << 3)    /**< status 32khz output bit */
+#define SIMULATOR_BIT_BSY            (1 << 2)    /**< status busy bit */
+#define SIMULATOR_BIT_FLAGS          0x03        /**< status alarm flag bits */
+
+/**
+ * @brief simulator device structure definition
+ */
+typedef struct ds3231_simulator_s
+{
+    uint8_t reg[SIMULATOR_REG_NUM];        /**< register map */
+    uint32_t subsecond;                    /**< position inside the current second in us */
+    uint32_t conversion;                   /**< remaining conversion time in us, 0 when idle */
+    uint32_t auto_conversion;              /**< seconds until the next automatic conversion */
+    uint64_t clock;                        /**< virtual clock in us */
+    int16_t temperature;                   /**< die temperature in 0.25 degrees */
+    uint8_t powered;                       /**< power on flag */
+} ds3231_simulator_t;
+
+static ds3231_simulator_t gs_simulator;        /**< simulated device */
+static uint8_t gs_enable = 0;                  /**< 1 links the handles to the simulated device */
+
+/**
+ * @brief register write mask, 0 bits always read back as 0
+ */
+static const uint8_t gs_mask[SIMULATOR_REG_NUM] =
+{
+    0x7F, 0x7F, 0x7F, 0x07, 0x3F, 0x9F, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF,
+    0xFF, 0x8B, 0xFF, 0xFF, 0xC0,
+};
+
+/**
+ * @brief     convert a bcd value to a decimal value
+ * @param[in] val bcd value
+ * @return    decimal value
+ * @note      none
+ */
+static uint8_t a_ds3231_simulator_bcd2dec(uint8_t val)
+{
+    return (uint8_t)((val >> 4) * 10 + (val & 0x0F));
+}
+
+/**
+ * @brief     convert a decimal value to a bcd value
+ * @param[in] val decimal value
+ * @return    bcd value
+ * @note      none
+ */
+static uint8_t a_ds3231_simulator_dec2bcd(uint8_t val)
+{
+    return (uint8_t)(((val / 10) << 4) | (val % 10));
+}
+
+/**
+ * @brief     convert an hour register to the 24h format
+ * @param[in] val hour register value
+ * @return    hour in 0 - 23
+ * @note      works for the time and the alarm hour registers
+ */
+static uint8_t a_ds3231_simulator_hour24(uint8_t val)
+{
+    uint8_t hour;
+    
+    /* 12h format */
+    if ((val & (1 << 6)) != 0)
+    {
+        hour = a_ds3231_simulator_bcd2dec(val & 0x1F) % 12;
+        
+        return (uint8_t)(((val & (1 << 5)) != 0) ? (hour + 12) : hour);
+    }
+    
+    return a_ds3231_simulator_bcd2dec(val & 0x3F);
+}
+
+/**
+ * @brief start a temperature conversion
+ * @note  a running conversion is not restarted
+ */
+static void a_ds3231_simulator_start_conversion(void)
+{
+    if (gs_simulator.conversion == 0)
+    {
+        gs_simulator.conversion = DS3231_SIMULATOR_CONVERSION_US;
+        gs_simulator.reg[SIMULATOR_REG_STATUS] |= SIMULATOR_BIT_BSY;
+    }
+}
+
+/**
+ * @brief finish a temperature conversion
+ * @note  none
+ */
+static void a_ds3231_simulator_finish_conversion(void)
+{
+    /* the msb is the signed integer part and the lsb keeps two fraction bits */
+    gs_simulator.reg[SIMULATOR_REG_TEMPERATURE] = (uint8_t)((gs_simulator.temperature >> 2) & 0xFF);
+    gs_simulator.reg[SIMULATOR_REG_TEMPERATURE + 1] = (uint8_t)((gs_simulator.temperature & 0x03) << 6);
+    
+    /* conv and bsy clear together */
+    gs_simulator.reg[SIMULATOR_REG_CONTROL] &= (uint8_t)(~SIMULATOR_BIT_CONV);
+    gs_simulator.reg[SIMULATOR_REG_STATUS] &= (uint8_t)(~SIMULATOR_BIT_BSY);
+}
+
+/**
+ * @brief step the calendar by one day
+ * @note  like the device, every year divisible by 4 is a leap year
+ */
+static void a_ds3231_simulator_next_day(void)
+{
+    const uint8_t days[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    uint8_t *reg = gs_simulator.reg;
+    uint8_t century;
+    uint8_t date;
+    uint8_t month;
+    uint8_t year;
+    uint8_t max;
+    
+    /* week runs 1 - 7 */
+    reg[SIMULATOR_REG_WEEK] = (uint8_t)((reg[SIMULATOR_REG_WEEK] % 7) + 1);
+    
+    /* get the date */
+    century = reg[SIMULATOR_REG_MONTH] & (1 << 7);
+    date = (uint8_t)(a_ds3231_simulator_bcd2dec(reg[SIMULATOR_REG_DATE]) + 1);
+    month = a_ds3231_simulator_bcd2dec(reg[SIMULATOR_REG_MONTH] & 0x1F);
+    year = a_ds3231_simulator_bcd2dec(reg[SIMULATOR_REG_YEAR]);
+    max = ((month >= 1) && (month <= 12)) ? days[month - 1] : 31;
+    if ((month == 2) && ((year % 4) == 0))
+    {
+        max = 29;
+    }
+    
+    /* carry into the month and the year */
+    if (date > max)
+    {
+        date = 1;
+        month++;
+        if (month > 12)
+        {
+            month = 1;
+            year++;
+            if (year > 99)
+            {
+                /* the century bit toggles when the year overflows */
+                year = 0;
+                century ^= (1 << 7);
+            }
+        }
+    }
+    reg[SIMULATOR_REG_DATE] = a_ds3231_simulator_dec2bcd(date);
+    reg[SIMULATOR_REG_MONTH] = (uint8_t)(century | a_ds3231_simulator_dec2bcd(month));
+    reg[SIMULATOR_REG_YEAR] = a_ds3231_simulator_dec2bcd(year);
+}
+
+/**
+ * @brief step the clock by one hour
+ * @note  in the 12h format the date steps at 11 pm to 12 am
+ */
+static void a_ds3231_simulator_next_hour(void)
+{
+    uint8_t *reg = gs_simulator.reg;
+    uint8_t hour;
+    uint8_t pm;
+    
+    /* 12h format */
+    if ((reg[SIMULATOR_REG_HOUR] & (1 << 6)) != 0)
+    {
+        hour = a_ds3231_simulator_bcd2dec(reg[SIMULATOR_REG_HOUR] & 0x1F);
+        pm = (uint8_t)((reg[SIMULATOR_REG_HOUR] >> 5) & 0x01);
+        if (hour == 11)
+        {
+            hour = 12;
+            pm ^= 1;
+        }
+        else if (hour >= 12)
+        {
+            hour = 1;
+        }
+        else
+        {
+            hour++;
+        }
+        reg[SIMULATOR_REG_HOUR] = (uint8_t)((1 << 6) | (pm << 5) | a_ds3231_simulator_dec2bcd(hour));
+        if ((hour == 12) && (pm == 0))
+        {
+            a_ds3231_simulator_next_day();
+        }
+    }
+    else
+    {
+        hour = (uint8_t)(a_ds3231_simulator_bcd2dec(reg[SIMULATOR_REG_HOUR] & 0x3F) + 1);
+        reg[SIMULATOR_REG_HOUR] = a_ds3231_simulator_dec2bcd(hour % 24);
+        if (hour >= 24)
+        {
+            a_ds3231_simulator_next_day();
+        }
+    }
+}
+
+/**
+ * @brief check both alarms against the current time
+ * @note  a set mask bit makes its register match any value
+ */
+static void a_ds3231_simulator_match_alarm(void)
+{
+    uint8_t *reg = gs_simulator.reg;
+    uint8_t *alarm;
+    uint8_t day;
+    
+    /* alarm1 matches seconds, minutes, hours and the day or date */
+    alarm = &reg[SIMULATOR_REG_ALARM1];
+    day = ((alarm[3] & (1 << 6)) != 0) ? ((alarm[3] & 0x0F) == reg[SIMULATOR_REG_WEEK]) :
+                                         ((alarm[3] & 0x3F) == reg[SIMULATOR_REG_DATE]);
+    if ((((alarm[0] & (1 << 7)) != 0) || ((alarm[0] & 0x7F) == reg[0])) &&
+        (((alarm[1] & (1 << 7)) != 0) || ((alarm[1] & 0x7F) == reg[1])) &&
+        (((alarm[2] & (1 << 7)) != 0) || (a_ds3231_simulator_hour24(alarm[2]) == a_ds3231_simulator_hour24(reg[2]))) &&
+        (((alarm[3] & (1 << 7)) != 0) || (day != 0)))
+    {
+        reg[SIMULATOR_REG_STATUS] |= (1 << 0);
+    }
+    
+    /* alarm2 has no seconds register and only fires at 00 seconds */
+    alarm = &reg[SIMULATOR_REG_ALARM2];
+    day = ((alarm[2] & (1 << 6)) != 0) ? ((alarm[2] & 0x0F) == reg[SIMULATOR_REG_WEEK]) :
+                                         ((alarm[2] & 0x3F) == reg[SIMULATOR_REG_DATE]);
+    if ((reg[0] == 0) &&
+        (((alarm[0] & (1 << 7)) != 0) || ((alarm[0] & 0x7F) == reg[1])) &&
+        (((alarm[1] & (1 << 7)) != 0) || (a_ds3231_simulator_hour24(alarm[1]) == a_ds3231_simulator_hour24(reg[2]))) &&
+        (((alarm[2] & (1 << 7)) != 0) || (day != 0)))
+    {
+        reg[SIMULATOR_REG_STATUS] |= (1 << 1);
+    }
+}
+
+/**
+ * @brief step the clock by one second
+ * @note  none
+ */
+static void a_ds3231_simulator_next_second(void)
+{
+    uint8_t *reg = gs_simulator.reg;
+    uint8_t second;
+    uint8_t minute;
+    
+    /* carry through the seconds and the minutes */
+    second = (uint8_t)(a_ds3231_simulator_bcd2dec(reg[0]) + 1);
+    reg[0] = a_ds3231_simulator_dec2bcd(second % 60);
+    if (second >= 60)
+    {
+        minute = (uint8_t)(a_ds3231_simulator_bcd2dec(reg[1]) + 1);
+        reg[1] = a_ds3231_simulator_dec2bcd(minute % 60);
+        if (minute >= 60)
+        {
+            a_ds3231_simulator_next_hour();
+        }
+    }
+    a_ds3231_simulator_match_alarm();
+    
+    /* the device converts on its own every 64 seconds */
+    gs_simulator.auto_conversion--;
+    if (gs_simulator.auto_conversion == 0)
+    {
+        gs_simulator.auto_conversion = DS3231_SIMULATOR_AUTO_CONVERSION_S;
+        a_ds3231_simulator_start_conversion();
+    }
+}
+
+/**
+ * @brief     write one register
+ * @param[in] reg register address
+ * @param[in] data written data
+ * @note      none
+ */
+static void a_ds3231_simulator_write_reg(uint8_t reg, uint8_t data)
+{
+    uint8_t prev = gs_simulator.reg[reg];
+    
+    if (reg == SIMULATOR_REG_CONTROL)
+    {
+        /* conv can only be set, the device clears it at the end of the conversion */
+        if ((data & SIMULATOR_BIT_CONV) != 0)
+        {
+            a_ds3231_simulator_start_conversion();
+        }
+        else
+        {
+            data |= (uint8_t)(prev & SIMULATOR_BIT_CONV);
+        }
+        gs_simulator.reg[reg] = data;
+    }
+    else if (reg == SIMULATOR_REG_STATUS)
+    {
+        /* the flags can only be cleared, bsy is read only */
+        gs_simulator.reg[reg] = (uint8_t)((prev & data & (SIMULATOR_BIT_OSF | SIMULATOR_BIT_FLAGS)) |
+                                          (data & SIMULATOR_BIT_EN32KHZ) | (prev & SIMULATOR_BIT_BSY));
+    }
+    else if (reg >= SIMULATOR_REG_TEMPERATURE)
+    {
+        /* the temperature registers are read only */
+    }
+    else
+    {
+        gs_simulator.reg[reg] = (uint8_t)(data & gs_mask[reg]);
+        
+        /* writing the seconds resets the countdown chain */
+        if (reg == SIMULATOR_REG_SECOND)
+        {
+            gs_simulator.subsecond = 0;
+        }
+    }
+}
+
+/**
+ * @brief  simulator power on reset
+ * @return status code
+ *         - 0 success
+ * @note   all registers get their power on values and the virtual clock restarts from 0
+ */
+uint8_t ds3231_simulator_reset(void)
+{
+    memset(&gs_simulator, 0, sizeof(ds3231_simulator_t));
+    
+    /* 2000-01-01 00:00:00, week 1 */
+    gs_simulator.reg[SIMULATOR_REG_WEEK] = 0x01;
+    gs_simulator.reg[SIMULATOR_REG_DATE] = 0x01;
+    gs_simulator.reg[SIMULATOR_REG_MONTH] = 0x01;
+    
+    /* intcn, rs2 and rs1 are set and osf reports the power up */
+    gs_simulator.reg[SIMULATOR_REG_CONTROL] = 0x1C;
+    gs_simulator.reg[SIMULATOR_REG_STATUS] = SIMULATOR_BIT_OSF | SIMULATOR_BIT_EN32KHZ;
+    
+    /* 25 degrees until told otherwise */
+    gs_simulator.temperature = 25 * 4;
+    gs_simulator.auto_conversion = DS3231_SIMULATOR_AUTO_CONVERSION_S;
+    a_ds3231_simulator_finish_conversion();
+    gs_simulator.powered = 1;
+    
+    return 0;
+}
+
+/**
+ * @brief     simulator advance the virtual clock
+ * @param[in] us elapsed time in us
+ * @return    status code
+ *            - 0 success
+ * @note      the clock is only moved by this function, so it can run faster than real time
+ */
+uint8_t ds3231_simulator_advance(uint64_t us)
+{
+    uint32_t step;
+    
+    while (us != 0)
+    {
+        /* stop at the next second or the end of the conversion */
+        step = 1000000 - gs_simulator.subsecond;
+        if ((gs_simulator.conversion != 0) && (gs_simulator.conversion < step))
+        {
+            step = gs_simulator.conversion;
+        }
+        if (us < step)
+        {
+            step = (uint32_t)us;
+        }
+        us -= step;
+        gs_simulator.clock += step;
+        gs_simulator.subsecond += step;
+        
+        /* finish the conversion */
+        if (gs_simulator.conversion != 0)
+        {
+            gs_simulator.conversion -= step;
+            if (gs_simulator.conversion == 0)
+            {
+                a_ds3231_simulator_finish_conversion();
+            }
+        }
+        
+        /* update the time */
+        if (gs_simulator.subsecond >= 1000000)
+        {
+            gs_simulator.subsecond = 0;
+            a_ds3231_simulator_next_second();
+        }
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief      simulator get the virtual clock
+ * @param[out] *us pointer to a time buffer in us
+ * @return     status code
+ *             - 0 success
+ *             - 2 us is null
+ * @note       none
+ */
+uint8_t ds3231_simulator_get_clock(uint64_t *us)
+{
+    if (us == NULL)
+    {
+        return 2;
+    }
+    
+    *us = gs_simulator.clock;
+    
+    return 0;
+}
+
+/**
+ * @brief     simulator set the die temperature
+ * @param[in] temperature die temperature in degrees
+ * @return    status code
+ *            - 0 success
+ * @note      the registers take the value at the end of the next conversion
+ */
+uint8_t ds3231_simulator_set_temperature(float temperature)
+{
+    float quarter;
+    
+    /* round to the 0.25 degree resolution */
+    quarter = temperature * 4.0f;
+    gs_simulator.temperature = (int16_t)((quarter >= 0.0f) ? (quarter + 0.5f) : (quarter - 0.5f));
+    
+    return 0;
+}
+
+/**
+ * @brief      simulator get the INT/SQW pin level
+ * @param[out] *level pointer to a level buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 level is null
+ * @note       the square wave falls when the seconds update
+ */
+uint8_t ds3231_simulator_get_int_sqw(uint8_t *level)
+{
+    const uint32_t freq[4] = {1, 1024, 4096, 8192};
+    uint8_t control;
+    uint8_t status;
+    
+    if (level == NULL)
+    {
+        return 2;
+    }
+    
+    control = gs_simulator.reg[SIMULATOR_REG_CONTROL];
+    status = gs_simulator.reg[SIMULATOR_REG_STATUS];
+    if ((control & SIMULATOR_BIT_INTCN) != 0)
+    {
+        /* the open drain output is pulled low by an enabled alarm flag */
+        *level = ((control & status & SIMULATOR_BIT_FLAGS) != 0) ? 0 : 1;
+    }
+    else
+    {
+        /* low in the first half of each period */
+        *level = (uint8_t)(((uint64_t)gs_simulator.subsecond * freq[(control >> 3) & 0x03] * 2 / 1000000) & 0x01);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  simulator iic bus init
+ * @return status code
+ *         - 0 success
+ * @note   the first init is a power on reset, later ones keep the device state
+ */
+uint8_t ds3231_simulator_iic_init(void)
+{
+    if (gs_simulator.powered == 0)
+    {
+        return ds3231_simulator_reset();
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief  simulator iic bus deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t ds3231_simulator_iic_deinit(void)
+{
+    return 0;
+}
+
+/**
+ * @brief      simulator iic bus read
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t ds3231_simulator_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint16_t i;
+    
+    /* nack a wrong address or register */
+    if ((addr != DS3231_SIMULATOR_ADDRESS) || (reg >= SIMULATOR_REG_NUM) || (gs_simulator.powered == 0))
+    {
+        return 1;
+    }
+    
+    /* the register pointer wraps from the last register to 0 */
+    for (i = 0; i < len; i++)
+    {
+        buf[i] = gs_simulator.reg[reg];
+        reg = (uint8_t)((reg + 1) % SIMULATOR_REG_NUM);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     simulator iic bus write
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t ds3231_simulator_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len)
+{
+    uint16_t i;
+    
+    /* nack a wrong address or register */
+    if ((addr != DS3231_SIMULATOR_ADDRESS) || (reg >= SIMULATOR_REG_NUM) || (gs_simulator.powered == 0))
+    {
+        return 1;
+    }
+    
+    /* the register pointer wraps from the last register to 0 */
+    for (i = 0; i < len; i++)
+    {
+        a_ds3231_simulator_write_reg(reg, buf[i]);
+        reg = (uint8_t)((reg + 1) % SIMULATOR_REG_NUM);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief     simulator delay ms
+ * @param[in] ms time
+ * @note      advances the virtual clock without sleeping
+ */
+void ds3231_simulator_delay_ms(uint32_t ms)
+{
+    (void)ds3231_simulator_advance((uint64_t)ms * 1000);
+}
+
+/**
+ * @brief     simulator enable the handle links
+ * @param[in] enable 1 links the handles to the simulated device
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+uint8_t ds3231_simulator_enable(uint8_t enable)
+{
+    gs_enable = (enable != 0) ? 1 : 0;
+    
+    return 0;
+}
+
+/**
+ * @brief     simulator link a handle to the simulated device
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is null
+ * @note      the handle is left alone until the simulator is enabled,
+ *            call it after the interface functions are linked
+ */
+uint8_t ds3231_simulator_link(ds3231_handle_t *handle)
+{
+    if (handle == NULL)
+    {
+        return 2;
+    }
+    
+    /* keep the interface */
+    if (gs_enable == 0)
+    {
+        return 0;
+    }
+    
+    /* the transfers are run access by access */
+    DRIVER_DS3231_LINK_IIC_INIT(handle, ds3231_simulator_iic_init);
+    DRIVER_DS3231_LINK_IIC_DEINIT(handle, ds3231_simulator_iic_deinit);
+    DRIVER_DS3231_LINK_IIC_READ(handle, ds3231_simulator_iic_read);
+    DRIVER_DS3231_LINK_IIC_WRITE(handle, ds3231_simulator_iic_write);
+    DRIVER_DS3231_LINK_IIC_TRANSFER(handle, NULL);
+    DRIVER_DS3231_LINK_DELAY_MS(handle, ds3231_simulator_delay_ms);
+    
+    return 0;
+}
@@ -0,0 +1,182 @@
+/**
+ * Copyright (c) 2015 - present LibDriver All rights reserved
+ * 
+ * The MIT License (MIT)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE. 
+ *
+ * @file      driver_ds3231_simulator.h
+ * @brief     driver ds3231 simulator header file
+ * @version   2.0.0
+ * @author    Shifeng Li
+ * @date      2021-03-15
+ *
+ * <h3>history</h3>
+ * <table>
+ * <tr><th>Date        <th>Version  <th>Author      <th>Description
+ * <tr><td>2021/03/15  <td>2.0      <td>Shifeng Li  <td>format the code
+ * <tr><td>2020/11/30  <td>1.0      <td>Shifeng Li  <td>first upload
+ * </table>
+ */
+
+#ifndef DRIVER_DS3231_SIMULATOR_H
+#define DRIVER_DS3231_SIMULATOR_H
+
+#include "driver_ds3231_interface.h"
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @addtogroup ds3231_test_driver
+ * @{
+ */
+
+/**
+ * @brief ds3231 simulator definition
+ */
+#define DS3231_SIMULATOR_ADDRESS                0xD0          /**< iic device address */
+#define DS3231_SIMULATOR_CONVERSION_US          125000        /**< temperature conversion time in us */
+#define DS3231_SIMULATOR_AUTO_CONVERSION_S      64            /**< automatic conversion period in s */
+
+/**
+ * @brief  simulator power on reset
+ * @return status code
+ *         - 0 success
+ * @note   all registers get their power on values and the virtual clock restarts from 0
+ */
+uint8_t ds3231_simulator_reset(void);
+
+/**
+ * @brief     simulator advance the virtual clock
+ * @param[in] us elapsed time in us
+ * @return    status code
+ *            - 0 success
+ * @note      the clock is only moved by this function, so it can run faster than real time
+ */
+uint8_t ds3231_simulator_advance(uint64_t us);
+
+/**
+ * @brief      simulator get the virtual clock
+ * @param[out] *us pointer to a time buffer in us
+ * @return     status code
+ *             - 0 success
+ *             - 2 us is null
+ * @note       none
+ */
+uint8_t ds3231_simulator_get_clock(uint64_t *us);
+
+/**
+ * @brief     simulator set the die temperature
+ * @param[in] temperature die temperature in degrees
+ * @return    status code
+ *            - 0 success
+ * @note      the registers take the value at the end of the next conversion
+ */
+uint8_t ds3231_simulator_set_temperature(float temperature);
+
+/**
+ * @brief      simulator get the INT/SQW pin level
+ * @param[out] *level pointer to a level buffer
+ * @return     status code
+ *             - 0 success
+ *             - 2 level is null
+ * @note       the square wave falls when the seconds update
+ */
+uint8_t ds3231_simulator_get_int_sqw(uint8_t *level);
+
+/**
+ * @brief  simulator iic bus init
+ * @return status code
+ *         - 0 success
+ * @note   the first init is a power on reset, later ones keep the device state
+ */
+uint8_t ds3231_simulator_iic_init(void);
+
+/**
+ * @brief  simulator iic bus deinit
+ * @return status code
+ *         - 0 success
+ * @note   none
+ */
+uint8_t ds3231_simulator_iic_deinit(void);
+
+/**
+ * @brief      simulator iic bus read
+ * @param[in]  addr iic device write address
+ * @param[in]  reg iic register address
+ * @param[out] *buf pointer to a data buffer
+ * @param[in]  len length of the data buffer
+ * @return     status code
+ *             - 0 success
+ *             - 1 read failed
+ * @note       none
+ */
+uint8_t ds3231_simulator_iic_read(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     simulator iic bus write
+ * @param[in] addr iic device write address
+ * @param[in] reg iic register address
+ * @param[in] *buf pointer to a data buffer
+ * @param[in] len length of the data buffer
+ * @return    status code
+ *            - 0 success
+ *            - 1 write failed
+ * @note      none
+ */
+uint8_t ds3231_simulator_iic_write(uint8_t addr, uint8_t reg, uint8_t *buf, uint16_t len);
+
+/**
+ * @brief     simulator delay ms
+ * @param[in] ms time
+ * @note      advances the virtual clock without sleeping
+ */
+void ds3231_simulator_delay_ms(uint32_t ms);
+
+/**
+ * @brief     simulator enable the handle links
+ * @param[in] enable 1 links the handles to the simulated device
+ * @return    status code
+ *            - 0 success
+ * @note      none
+ */
+uint8_t ds3231_simulator_enable(uint8_t enable);
+
+/**
+ * @brief     simulator link a handle to the simulated device
+ * @param[in] *handle pointer to a ds3231 handle structure
+ * @return    status code
+ *            - 0 success
+ *            - 2 handle is null
+ * @note      the handle is left alone until the simulator is enabled,
+ *            call it after the interface functions are linked
+ */
+uint8_t ds3231_simulator_link(ds3231_handle_t *handle);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif